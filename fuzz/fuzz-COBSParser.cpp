@@ -0,0 +1,63 @@
+/**
+ * Fuzz target for COBSParser and COBSParserCRC. The first byte of the input
+ * selects the size of the packet buffer, so truncation is exercised as well.
+ * The remaining input is also encoded by COBSSender, and decoding it again
+ * must result in the original data.
+ */
+
+#include <COBSStream/COBSParser.hpp>
+#include <COBSStream/COBSSender.hpp>
+
+#include <boost/crc.hpp>
+
+#include <cstring>
+#include <vector>
+
+using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size == 0)
+        return 0;
+    std::vector<uint8_t> buffer(data[0]);
+    ++data, --size;
+
+    COBSParser parser = {buffer.data(), buffer.size()};
+    COBSParserCRC<CRC> parserCRC = {{buffer.data(), buffer.size()}, CRC()};
+
+    volatile size_t sink = 0;
+    for (size_t i = 0; i < size; ++i) {
+        size_t packetSize = parser.parse(data[i]);
+        if (packetSize > buffer.size())
+            __builtin_trap();
+        for (size_t j = 0; j < packetSize; ++j)
+            sink = sink + buffer[j];
+        sink = sink + parser.numTruncated();
+    }
+    for (size_t i = 0; i < size; ++i) {
+        size_t packetSize = parserCRC.parse(data[i]);
+        if (packetSize > buffer.size())
+            __builtin_trap();
+        for (size_t j = 0; j < packetSize; ++j)
+            sink = sink + buffer[j];
+        sink = sink + parserCRC.checksum() + parserCRC.numTruncated();
+    }
+
+    // Round trip
+    std::vector<uint8_t> encoded;
+    auto sender = [&encoded](uint8_t c) { return encoded.push_back(c), 1; };
+    COBSSender<decltype(sender)> cobssender(std::move(sender));
+    cobssender.beginPacket();
+    cobssender.write(data, size);
+    cobssender.endPacket();
+    if (encoded.size() > COBS_maxFrameLength(size))
+        __builtin_trap();
+    std::vector<uint8_t> decoded(size);
+    COBSParser roundTrip = {decoded.data(), decoded.size()};
+    size_t decodedSize = 0;
+    for (uint8_t c : encoded)
+        if (size_t s = roundTrip.parse(c))
+            decodedSize = s;
+    if (decodedSize != size || std::memcmp(decoded.data(), data, size) != 0)
+        __builtin_trap();
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * Fuzz target for KV_Iterator in checked mode, KV_Iterator::validate, the
+ * parsers (with and without key table) and KV_Compact::decode. No input should
+ * cause an out-of-bounds read.
+ */
+
+#include <KVComm/KV_ArenaParser.hpp>
+#include <KVComm/KV_Compact.hpp>
+#include <KVComm/KV_Iterator.hpp>
+#include <KVComm/KV_KeyTable.hpp>
+#include <KVComm/KV_Parser.hpp>
+
+#include <cstring>
+
+/// Touch all bytes of an entry so the sanitizers notice out-of-bounds reads.
+static size_t touch(const KV_Iterator::KV &kv) {
+    size_t sum = strlen(kv.getID());
+    for (size_t i = 0; i < kv.getDataLength(); ++i)
+        sum += kv.getData()[i];
+    auto str = kv.tryGetString();
+    if (str)
+        sum += strlen(str.value());
+    auto f = kv.tryGetAs<float>(kv.getArraySize<float>() / 2);
+    if (f)
+        sum += f.value() > 0;
+    auto view = kv.tryGetArrayView<uint8_t>();
+    if (view && view->size() > 0) {
+        size_t idx[KV_Shape::MaxRank];
+        for (uint8_t d = 0; d < view->rank(); ++d)
+            idx[d] = view->size(d) - 1;
+        sum += view->at(idx) + view->transposed().slice(0, 0).size();
+    }
+    auto nested = kv.tryGetDictionary(KV_Iterator::Checked);
+    if (nested)
+        sum += bool(nested->find("key", "key"));
+    return sum;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    volatile size_t sink = 0;
+
+    // Checked iteration over the raw input
+    for (auto &kv : KV_Iterator(data, size, KV_Iterator::Checked))
+        sink = sink + touch(kv);
+
+    // Parsers in checked mode
+    KV_ArenaParser arena(data, size, KV_Iterator::Checked);
+    for (auto &entry : arena)
+        sink = sink + arena.contains(entry.first) + touch(entry.second);
+    KV_Parser parser(data, size, KV_Iterator::Checked);
+    sink = sink + parser.tryGetElement("key")->tryGetAs<int>().valueOr(0);
+
+    // Key definitions and key IDs
+    KV_KeyTable keys;
+    KV_Parser withKeys(data, size, KV_Iterator::Checked, &keys);
+    for (auto &entry : withKeys)
+        sink = sink + touch(entry.second);
+
+    // After successful validation, unchecked access must be safe as well
+    if (KV_Iterator::validate(data, size) == KV_Errc::OK) {
+        for (auto &kv : KV_Iterator(data, size))
+            sink = sink + touch(kv);
+        arena.reparse(data, size);
+        for (auto &entry : arena)
+            sink = sink + touch(entry.second);
+    }
+
+    // Decoding a compact frame must either fail, or produce a valid dictionary
+    static uint8_t aligned[1 << 17];
+    auto decoded = KV_Compact::decode(data, size, aligned, sizeof(aligned));
+    if (decoded && KV_Iterator::validate(aligned, decoded.value()) !=
+                       KV_Errc::OK)
+        __builtin_trap();
+    return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * Fuzz target for LZ_unpack. The input is decompressed as a packet, and it is
+ * also compressed by LZSender, and decompressing it again must result in the
+ * original data.
+ */
+
+#include <SLIPStream/LZSender.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+struct PacketCapture {
+    size_t beginPacket() { return 0; }
+    size_t write(const uint8_t *data, size_t len) {
+        packet.insert(packet.end(), data, data + len);
+        return len;
+    }
+    size_t endPacket() { return 0; }
+    std::vector<uint8_t> packet;
+};
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    std::vector<uint8_t> out(1024);
+    size_t outSize = LZ_unpack(data, size, out.data(), out.size());
+    if (outSize > out.size())
+        __builtin_trap();
+
+    // Round trip
+    PacketCapture capture;
+    LZSender<PacketCapture &, 7, 3> lz = capture;
+    lz.writePacket(data, size);
+    std::vector<uint8_t> decoded(size + 1);
+    size_t decodedSize = LZ_unpack(capture.packet.data(), capture.packet.size(),
+                                   decoded.data(), decoded.size());
+    if (decodedSize != size ||
+        (size > 0 && std::memcmp(decoded.data(), data, size) != 0))
+        __builtin_trap();
+    return 0;
+}
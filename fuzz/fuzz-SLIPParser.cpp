@@ -0,0 +1,41 @@
+/**
+ * Fuzz target for SLIPParser and SLIPParserCRC. The first byte of the input
+ * selects the size of the packet buffer, so truncation is exercised as well.
+ */
+
+#include <SLIPStream/SLIPParser.hpp>
+
+#include <boost/crc.hpp>
+
+#include <vector>
+
+using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (size == 0)
+        return 0;
+    std::vector<uint8_t> buffer(data[0]);
+    ++data, --size;
+
+    SLIPParser parser = {buffer.data(), buffer.size()};
+    SLIPParserCRC<CRC> parserCRC = {{buffer.data(), buffer.size()}, CRC()};
+
+    volatile size_t sink = 0;
+    for (size_t i = 0; i < size; ++i) {
+        size_t packetSize = parser.parse(data[i]);
+        if (packetSize > buffer.size())
+            __builtin_trap();
+        for (size_t j = 0; j < packetSize; ++j)
+            sink = sink + buffer[j];
+        sink = sink + parser.numTruncated();
+    }
+    for (size_t i = 0; i < size; ++i) {
+        size_t packetSize = parserCRC.parse(data[i]);
+        if (packetSize > buffer.size())
+            __builtin_trap();
+        for (size_t j = 0; j < packetSize; ++j)
+            sink = sink + buffer[j];
+        sink = sink + parserCRC.checksum() + parserCRC.numTruncated();
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+/**
+ * Minimal driver for running a fuzz target without libFuzzer, e.g. with AFL or
+ * to replay crashing inputs. Each command line argument is a file that is
+ * passed to the fuzz target. Without arguments, a single input is read from
+ * standard input.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+static void runOne(std::istream &is) {
+    std::vector<uint8_t> input = {std::istreambuf_iterator<char>(is),
+                                  std::istreambuf_iterator<char>()};
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        runOne(std::cin);
+        return 0;
+    }
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file) {
+            std::cerr << "Failed to open " << argv[i] << std::endl;
+            return 1;
+        }
+        runOne(file);
+    }
+    return 0;
+}
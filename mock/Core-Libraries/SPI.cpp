@@ -0,0 +1,21 @@
+#include "SPI.h"
+
+void SPIClass::begin() { ArduinoMock::getSPI().begin(); }
+void SPIClass::end() { ArduinoMock::getSPI().end(); }
+
+void SPIClass::beginTransaction(SPISettings settings) {
+    ArduinoMock::getSPI().beginTransaction(settings.clock, settings.bitOrder,
+                                           settings.dataMode);
+}
+void SPIClass::endTransaction() { ArduinoMock::getSPI().endTransaction(); }
+
+uint8_t SPIClass::transfer(uint8_t data) {
+    return ArduinoMock::getSPI().transfer(data);
+}
+void SPIClass::transfer(void *buf, size_t count) {
+    uint8_t *data = static_cast<uint8_t *>(buf);
+    for (size_t i = 0; i < count; ++i)
+        data[i] = transfer(data[i]);
+}
+
+SPIClass SPI;
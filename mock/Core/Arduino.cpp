@@ -28,4 +28,18 @@ void analogWrite(uint8_t pin, int value) {
 
 unsigned long millis() { return ArduinoMock::getInstance().millis(); }
 
-unsigned long micros() { return ArduinoMock::getInstance().micros(); }
\ No newline at end of file
+unsigned long micros() { return ArduinoMock::getInstance().micros(); }
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode) {
+    ArduinoMock::getInterrupts().attach(interruptNum, userFunc, mode);
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+    ArduinoMock::getInterrupts().detach(interruptNum);
+}
+
+bool adcStart(uint8_t pin) { return ArduinoMock::getADC().start(pin); }
+
+bool adcBusy(uint8_t pin) { return ArduinoMock::getADC().busy(pin); }
+
+uint16_t adcEnd(uint8_t pin) { return ArduinoMock::getADC().end(pin); }
\ No newline at end of file
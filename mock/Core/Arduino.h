@@ -59,6 +59,9 @@ struct __FlashStringHelper;
 #define NUM_DIGITAL_PINS 14
 #define NUM_ANALOG_INPUTS 6
 
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) ((p) < NUM_DIGITAL_PINS ? (p) : NOT_AN_INTERRUPT)
+
 // undefine stdlib's abs if encountered
 #ifdef abs
 #undef abs
@@ -90,6 +93,14 @@ unsigned long micros(void);
 
 void delay(unsigned long);
 
+#define HAS_ADC_START_BUSY_END 1
+bool adcStart(uint8_t pin);
+bool adcBusy(uint8_t pin);
+uint16_t adcEnd(uint8_t pin);
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+
 void shiftOut(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder, uint8_t val);
 
 #include "HardwareSerial.h"
@@ -1,5 +1,8 @@
+#include "Arduino.h"
 #include "ArduinoMock.hpp"
 
+#include <stdexcept>
+
 ArduinoMock *ArduinoMock::instance = nullptr;
 
 ArduinoMock &ArduinoMock::getInstance() {
@@ -21,4 +24,66 @@ void ArduinoMock::end() {
 
 SerialHelper &ArduinoMock::getSerial() {
     return getInstance().serial;
-}
\ No newline at end of file
+}
+
+SPIHelper &ArduinoMock::getSPI() {
+    return getInstance().spi;
+}
+
+InterruptHelper &ArduinoMock::getInterrupts() {
+    return getInstance().interrupts;
+}
+
+void InterruptHelper::attach(uint8_t interruptNum, void (*handler)(void),
+                             int mode) {
+    if (interruptNum >= NUM_DIGITAL_PINS)
+        throw std::out_of_range("Error: invalid interrupt number.");
+    handlers[interruptNum] = handler;
+    modes[interruptNum] = mode;
+}
+
+void InterruptHelper::detach(uint8_t interruptNum) {
+    if (interruptNum >= NUM_DIGITAL_PINS)
+        throw std::out_of_range("Error: invalid interrupt number.");
+    handlers[interruptNum] = nullptr;
+}
+
+bool InterruptHelper::trigger(uint8_t interruptNum) const {
+    if (!isAttached(interruptNum))
+        return false;
+    handlers[interruptNum]();
+    return true;
+}
+
+bool InterruptHelper::isAttached(uint8_t interruptNum) const {
+    return interruptNum < NUM_DIGITAL_PINS && handlers[interruptNum] != nullptr;
+}
+
+int InterruptHelper::getMode(uint8_t interruptNum) const {
+    return isAttached(interruptNum) ? modes[interruptNum] : -1;
+}
+
+ADCHelper &ArduinoMock::getADC() { return getInstance().adc; }
+
+bool ADCHelper::start(uint8_t pin) {
+    if (converting)
+        throw std::logic_error("Error: ADC conversion already in progress.");
+    this->pin = pin;
+    value = ArduinoMock::getInstance().analogRead(pin);
+    startTime = ArduinoMock::getInstance().micros();
+    converting = true;
+    return true;
+}
+
+bool ADCHelper::busy(uint8_t pin) const {
+    if (!converting || pin != this->pin)
+        return false;
+    return ArduinoMock::getInstance().micros() - startTime < conversionTime;
+}
+
+uint16_t ADCHelper::end(uint8_t pin) {
+    if (!converting || pin != this->pin)
+        throw std::logic_error("Error: no ADC conversion for this pin.");
+    converting = false;
+    return value;
+}
@@ -1,11 +1,70 @@
 #pragma once
 
+#include "Arduino.h" // NUM_DIGITAL_PINS
 #include "HardwareSerial.h"
 
+class SPIHelper {
+  public:
+    MOCK_METHOD0(begin, void());
+    MOCK_METHOD0(end, void());
+
+    MOCK_METHOD3(beginTransaction, void(uint32_t, uint8_t, uint8_t));
+    MOCK_METHOD0(endTransaction, void());
+
+    MOCK_METHOD1(transfer, uint8_t(uint8_t));
+
+    virtual ~SPIHelper() = default;
+};
+
+/// Keeps track of the interrupt handlers attached using `attachInterrupt`, so
+/// tests can simulate pin change interrupts.
+class InterruptHelper {
+  public:
+    void attach(uint8_t interruptNum, void (*handler)(void), int mode);
+    void detach(uint8_t interruptNum);
+    /// Call the handler of the given interrupt, returns false if no handler is
+    /// attached.
+    bool trigger(uint8_t interruptNum) const;
+    bool isAttached(uint8_t interruptNum) const;
+    int getMode(uint8_t interruptNum) const;
+
+  private:
+    void (*handlers[NUM_DIGITAL_PINS])(void) = {};
+    int modes[NUM_DIGITAL_PINS] = {};
+};
+
+/// Simulates the non-blocking ADC functions `adcStart`, `adcBusy` and
+/// `adcEnd`. The input is sampled (using `ArduinoMock::analogRead`) when the
+/// conversion is started, and the conversion takes a fixed amount of time
+/// (measured using `ArduinoMock::micros`).
+class ADCHelper {
+  public:
+    bool start(uint8_t pin);
+    bool busy(uint8_t pin) const;
+    uint16_t end(uint8_t pin);
+
+    /// Set the time a conversion takes, in microseconds.
+    void setConversionTime(unsigned long conversionTime) {
+        this->conversionTime = conversionTime;
+    }
+    unsigned long getConversionTime() const { return conversionTime; }
+
+  private:
+    /// 13 ADC clock cycles at 125 kHz (ATmega328P).
+    unsigned long conversionTime = 104;
+    unsigned long startTime = 0;
+    uint16_t value = 0;
+    uint8_t pin = 0;
+    bool converting = false;
+};
+
 class ArduinoMock {
   private:
     ArduinoMock() {}
     SerialHelper serial;
+    SPIHelper spi;
+    InterruptHelper interrupts;
+    ADCHelper adc;
     static ArduinoMock *instance;
 
   public:
@@ -13,6 +72,9 @@ class ArduinoMock {
     static void begin();
     static void end();
     static SerialHelper &getSerial();
+    static SPIHelper &getSPI();
+    static InterruptHelper &getInterrupts();
+    static ADCHelper &getADC();
 
     MOCK_METHOD2(pinMode, void(uint8_t, uint8_t));
     MOCK_METHOD2(digitalWrite, void(uint8_t, uint8_t));
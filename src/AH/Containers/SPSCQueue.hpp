@@ -0,0 +1,96 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Settings/NamespaceSettings.hpp>
+#include <stdint.h>
+
+BEGIN_AH_NAMESPACE
+
+/// @addtogroup    AH_Containers
+/// @{
+
+/**
+ * @brief   Lock-free queue with a single producer and a single consumer.
+ *
+ * Elements can be pushed from an interrupt handler and popped from the main
+ * program (or vice versa) without disabling interrupts: the producer only
+ * writes the write index, and the consumer only writes the read index. Both
+ * indices are a single byte, so they can be read and written atomically on
+ * all supported platforms.
+ *
+ * @note    The queue can hold at most `N - 1` elements.
+ *
+ * @tparam  T
+ *          The type of the elements.
+ * @tparam  N
+ *          The size of the buffer, must be a power of two.
+ */
+template <class T, uint8_t N>
+class SPSCQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+  public:
+    /**
+     * @brief   Add an element to the back of the queue (producer only).
+     *
+     * @retval  true
+     *          The element was added.
+     * @retval  false
+     *          The queue is full, the element was discarded.
+     */
+    bool push(const T &t) {
+        uint8_t w = writeIndex;
+        uint8_t next = (w + 1) & (N - 1);
+        if (next == readIndex)
+            return false;
+        buffer[w] = t;
+        // The element has to be written before it is made available
+        __atomic_signal_fence(__ATOMIC_RELEASE);
+        writeIndex = next;
+        return true;
+    }
+
+    /**
+     * @brief   Remove the element at the front of the queue (consumer only).
+     *
+     * @retval  true
+     *          The element was removed and stored in @p t.
+     * @retval  false
+     *          The queue is empty.
+     */
+    bool pop(T &t) {
+        uint8_t r = readIndex;
+        if (r == writeIndex)
+            return false;
+        __atomic_signal_fence(__ATOMIC_ACQUIRE);
+        t = buffer[r];
+        __atomic_signal_fence(__ATOMIC_RELEASE);
+        readIndex = (r + 1) & (N - 1);
+        return true;
+    }
+
+    /// Check whether the queue is empty.
+    bool empty() const { return readIndex == writeIndex; }
+
+    /// Get the number of elements in the queue.
+    uint8_t size() const { return (writeIndex - readIndex) & (N - 1); }
+
+    /// Get the maximum number of elements in the queue.
+    constexpr static uint8_t capacity() { return N - 1; }
+
+    /// Remove all elements (consumer only).
+    void clear() { readIndex = writeIndex; }
+
+  private:
+    T buffer[N];
+    volatile uint8_t writeIndex = 0;
+    volatile uint8_t readIndex = 0;
+};
+
+/// @}
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -72,4 +72,31 @@ AH_DIAGNOSTIC_POP()
 
 #endif
 
+// Non-blocking conversions
+//------------------------------------------------------------------------------
+#ifndef HAS_ADC_START_BUSY_END
+// Version 1.0.x of the ESP32 core provides adcStart, adcBusy and adcEnd, they
+// were removed in version 2.0.0 (which defines ESP_ARDUINO_VERSION_MAJOR).
+#if defined(ESP32) &&                                                          \
+    (!defined(ESP_ARDUINO_VERSION_MAJOR) || ESP_ARDUINO_VERSION_MAJOR < 2)
+#define HAS_ADC_START_BUSY_END 1
+#else
+/// Whether the core provides the non-blocking `adcStart`, `adcBusy` and
+/// `adcEnd` functions (version 1.0.x of the ESP32 core, and the Arduino mock
+/// used for testing).
+#define HAS_ADC_START_BUSY_END 0
+#endif
+#endif
+
+#if defined(__AVR__) && defined(ADCSRA) && defined(ADSC) && defined(ADMUX)
+/// Whether conversions can be started and polled using the AVR ADC registers.
+#define HAS_AVR_ADC_REGISTERS 1
+#else
+#define HAS_AVR_ADC_REGISTERS 0
+#endif
+
+/// Whether the built-in ADC can convert analog inputs in the background.
+/// @see    ADCSampler
+#define HAS_ASYNC_ANALOG_READ (HAS_ADC_START_BUSY_END || HAS_AVR_ADC_REGISTERS)
+
 AH_DIAGNOSTIC_POP()
\ No newline at end of file
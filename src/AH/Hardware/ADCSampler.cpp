@@ -0,0 +1,158 @@
+#include "ADCSampler.hpp"
+#include <AH/Arduino-Wrapper.h> // A0, NUM_ANALOG_INPUTS
+#include <AH/Hardware/ADCConfig.hpp>
+#include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
+
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#if HAS_AVR_ADC_REGISTERS
+// The reference selected using analogReference, defined by the Arduino core.
+extern uint8_t analog_reference;
+#endif
+
+BEGIN_AH_NAMESPACE
+
+namespace {
+
+#if HAS_AVR_ADC_REGISTERS
+
+bool startConversion(pin_t pin) {
+    uint8_t channel = pin - A0;
+#ifdef analogPinToChannel
+    channel = analogPinToChannel(channel);
+#endif
+#ifdef MUX5
+    ADCSRB = (ADCSRB & ~_BV(MUX5)) | (((channel >> 3) & 0x01) << MUX5);
+#endif
+    ADMUX = (analog_reference << 6) | (channel & 0x07);
+    ADCSRA |= _BV(ADSC);
+    return true;
+}
+
+bool isConversionBusy(pin_t) { return bit_is_set(ADCSRA, ADSC); }
+
+analog_t getConversionResult(pin_t) { return ADC; }
+
+#elif HAS_ADC_START_BUSY_END
+
+bool startConversion(pin_t pin) { return adcStart(pin); }
+
+bool isConversionBusy(pin_t pin) { return adcBusy(pin); }
+
+analog_t getConversionResult(pin_t pin) { return adcEnd(pin); }
+
+#endif
+
+} // namespace
+
+// -------------------------------------------------------------------------- //
+
+ADCChannel::ADCChannel(pin_t pin) : pin(pin) { ADCSampler::add(this); }
+
+ADCChannel::~ADCChannel() { ADCSampler::remove(this); }
+
+bool ADCChannel::read(analog_t &value) {
+    if (count == 0)
+        return false;
+    value = (sum + count / 2) / count;
+    sum = 0;
+    count = 0;
+    return true;
+}
+
+void ADCChannel::addSample(analog_t sample) {
+    if (count == UINT16_MAX) { // Start over, so the sum cannot overflow
+        sum = 0;
+        count = 0;
+    }
+    latest = sample;
+    sum += sample;
+    ++count;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool ADCSampler::update() {
+    bool sampled = false;
+#if HAS_ASYNC_ANALOG_READ
+    if (converting) {
+        if (isConversionBusy(convertingPin))
+            return false;
+        converting = false;
+        finishConversion(getConversionResult(convertingPin));
+        sampled = true;
+    }
+#endif
+    if (current == nullptr)
+        current = channels.getFirst();
+    if (current == nullptr)
+        return sampled;
+#if HAS_ASYNC_ANALOG_READ
+    if (supportsAsync(current->pin)) {
+        convertingPin = current->pin;
+        converting = startConversion(convertingPin);
+        if (converting)
+            return sampled;
+    }
+#endif
+    // Read at most one channel per update, the next one will be read later
+    if (sampled)
+        return true;
+    finishConversion(ExtIO::analogRead(current->pin));
+    return true;
+}
+
+void ADCSampler::flush() {
+#if HAS_ASYNC_ANALOG_READ
+    if (!converting)
+        return;
+    while (isConversionBusy(convertingPin))
+        ;
+    converting = false;
+    finishConversion(getConversionResult(convertingPin));
+#endif
+}
+
+bool ADCSampler::supportsAsync(pin_t pin) {
+#if HAS_ADC_START_BUSY_END && defined(digitalPinToAnalogChannel)
+    // The analog pins of the ESP32 are not consecutive
+    return digitalPinToAnalogChannel(pin) >= 0;
+#elif HAS_ASYNC_ANALOG_READ
+    return pin >= A0 && pin < A0 + NUM_ANALOG_INPUTS;
+#else
+    (void)pin;
+    return false;
+#endif
+}
+
+void ADCSampler::add(ADCChannel *channel) {
+#if HAS_ADC_START_BUSY_END && defined(ESP32)
+    // The ESP32 core only configures the pin for the ADC in analogRead
+    if (supportsAsync(channel->pin))
+        adcAttachPin(channel->pin);
+#endif
+    channels.append(channel);
+}
+
+void ADCSampler::remove(ADCChannel *channel) {
+    // If the channel is being converted, its result is discarded
+    if (current == channel)
+        current = nullptr;
+    channels.remove(channel);
+}
+
+void ADCSampler::finishConversion(analog_t result) {
+    if (current == nullptr) // The channel was removed during the conversion
+        return;
+    current->addSample(result);
+    current = current->next;
+}
+
+DoublyLinkedList<ADCChannel> ADCSampler::channels;
+ADCChannel *ADCSampler::current = nullptr;
+pin_t ADCSampler::convertingPin = NO_PIN;
+bool ADCSampler::converting = false;
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
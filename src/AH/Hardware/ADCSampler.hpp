@@ -0,0 +1,126 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Containers/LinkedList.hpp>
+#include <AH/Hardware/Hardware-Types.hpp>
+#include <AH/Settings/SettingsWrapper.hpp>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   An analog input that is sampled in the background by the
+ *          @ref ADCSampler.
+ *
+ * The channel keeps the latest sample, and the sum of all samples since the
+ * last call to @ref read, so they can be averaged.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+class ADCChannel : public DoublyLinkable<ADCChannel> {
+  public:
+    /**
+     * @brief   Create a channel and add it to the sampler.
+     *
+     * @param   pin
+     *          The analog pin to sample. Extended IO pins are supported as
+     *          well, but they are read using `ExtIO::analogRead`, which
+     *          may block.
+     */
+    ADCChannel(pin_t pin);
+    /// Remove the channel from the sampler.
+    ~ADCChannel();
+
+    ADCChannel(const ADCChannel &) = delete;
+    ADCChannel &operator=(const ADCChannel &) = delete;
+
+    /// Get the pin that is sampled.
+    pin_t getPin() const { return pin; }
+
+    /// Check whether there are new samples since the last call to @ref read.
+    bool available() const { return count > 0; }
+
+    /// Get the most recent sample.
+    analog_t getLatest() const { return latest; }
+
+    /**
+     * @brief   Get the average of all samples since the previous call, and
+     *          start accumulating again.
+     *
+     * @param[out]  value
+     *          The (rounded) average of the new samples.
+     * @retval  true
+     *          There were new samples.
+     * @retval  false
+     *          There were no new samples, @p value is not changed.
+     */
+    bool read(analog_t &value);
+
+  private:
+    friend class ADCSampler;
+    void addSample(analog_t sample);
+
+    pin_t pin;
+    analog_t latest = 0;
+    uint32_t sum = 0;
+    uint16_t count = 0;
+};
+
+/**
+ * @brief   Samples all @ref ADCChannel%s, one at a time, without waiting for
+ *          the ADC.
+ *
+ * Every call to @ref update checks whether the current conversion has
+ * finished. If it has, the result is stored in its channel, and the conversion
+ * of the next channel is started. The main program can do other work while
+ * the ADC is busy.
+ *
+ * On platforms without support for non-blocking conversions
+ * (see @ref HAS_ASYNC_ANALOG_READ), and for extended IO pins, each call to
+ * @ref update reads a single channel using `ExtIO::analogRead`.
+ *
+ * @note    The ADC must not be used by other code (e.g. `analogRead`) while
+ *          a conversion is in progress.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+class ADCSampler {
+  public:
+    /**
+     * @brief   Finish the current conversion if it's ready, and start the
+     *          next one.
+     *
+     * @return  Whether a new sample was stored.
+     */
+    static bool update();
+
+    /// Wait for the current conversion to finish, so the ADC can be used by
+    /// other code.
+    static void flush();
+
+    /// Check whether a conversion is in progress.
+    static bool isConverting() { return converting; }
+
+    /// Check whether the given pin can be sampled in the background.
+    static bool supportsAsync(pin_t pin);
+
+  private:
+    friend class ADCChannel;
+    static void add(ADCChannel *channel);
+    static void remove(ADCChannel *channel);
+    /// Store the result of the current conversion, and select the next
+    /// channel.
+    static void finishConversion(analog_t result);
+
+    static DoublyLinkedList<ADCChannel> channels;
+    /// The channel that is being converted, or that will be converted next.
+    static ADCChannel *current;
+    /// The pin that is being converted.
+    static pin_t convertingPin;
+    static bool converting;
+};
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
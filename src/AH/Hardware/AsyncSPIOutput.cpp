@@ -0,0 +1,54 @@
+#include "AsyncSPIOutput.hpp"
+
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+BEGIN_AH_NAMESPACE
+
+namespace {
+
+/// Send the given packets of the frame in a single transaction.
+void sendPackets(const SPIFrame &frame, uint16_t first, uint16_t last) {
+    const uint8_t *data = frame.data + first * frame.packetLength;
+    SPI.beginTransaction(frame.settings);
+    for (uint16_t p = first; p < last; ++p) {
+        ExtIO::digitalWrite(frame.csPin, LOW);
+        for (uint16_t i = 0; i < frame.packetLength; ++i)
+            SPI.transfer(*data++);
+        ExtIO::digitalWrite(frame.csPin, HIGH);
+    }
+    SPI.endTransaction();
+}
+
+} // namespace
+
+void BlockingSPITransport::begin() { SPI.begin(); }
+
+void BlockingSPITransport::beginFrame(const SPIFrame &frame) {
+    sendPackets(frame, 0, frame.numPackets);
+}
+
+BlockingSPITransport &BlockingSPITransport::getInstance() {
+    static BlockingSPITransport instance;
+    return instance;
+}
+
+void PolledSPITransport::begin() { SPI.begin(); }
+
+void PolledSPITransport::beginFrame(const SPIFrame &frame) {
+    this->frame = frame;
+    nextPacket  = 0;
+}
+
+bool PolledSPITransport::isBusy() {
+    uint16_t remaining = frame.numPackets - nextPacket;
+    if (remaining == 0)
+        return false;
+    uint16_t n = remaining < packetsPerPoll ? remaining : packetsPerPoll;
+    sendPackets(frame, nextPacket, nextPacket + n);
+    nextPacket += n;
+    return nextPacket < frame.numPackets;
+}
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
+#include <AH/Settings/SettingsWrapper.hpp>
+#include <string.h> // memcpy
+
+AH_DIAGNOSTIC_EXTERNAL_HEADER()
+#include <SPI.h>
+AH_DIAGNOSTIC_POP()
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   A frame of SPI data, consisting of a number of packets of equal
+ *          length. The chip select pin is pulled low before, and high after
+ *          each packet.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+struct SPIFrame {
+    /// The data of all packets, back to back.
+    const uint8_t *data = nullptr;
+    /// The number of bytes in each packet.
+    uint16_t packetLength = 0;
+    /// The number of packets in the frame.
+    uint16_t numPackets = 0;
+    /// The chip select (or latch) pin of the device.
+    pin_t csPin = NO_PIN;
+    /// The SPI settings of the device.
+    SPISettings settings;
+};
+
+/**
+ * @brief   Interface for the transports that actually send SPI frames.
+ *
+ * A transport can send the data synchronously (@ref BlockingSPITransport),
+ * a few packets at a time (@ref PolledSPITransport), or in the background
+ * using interrupts or DMA, on cores that support it.
+ * A single transport can be shared by all devices on the same SPI bus.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+class SPITransport {
+  public:
+    virtual ~SPITransport() = default;
+
+    /// Initialize the SPI bus.
+    virtual void begin() = 0;
+
+    /**
+     * @brief   Start sending the given frame.
+     *
+     * Only called when the transport is not busy. The data of the frame has
+     * to stay valid until @ref isBusy returns false.
+     */
+    virtual void beginFrame(const SPIFrame &frame) = 0;
+
+    /**
+     * @brief   Check if the transport is still sending a frame.
+     *
+     * Transports that don't use interrupts or DMA continue sending the frame
+     * when this function is called.
+     */
+    virtual bool isBusy() = 0;
+};
+
+/**
+ * @brief   Transport that sends the entire frame in a single SPI transaction
+ *          when @ref beginFrame is called.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+class BlockingSPITransport : public SPITransport {
+  public:
+    void begin() override;
+    void beginFrame(const SPIFrame &frame) override;
+    bool isBusy() override { return false; }
+
+    /// Get the transport that is used by default.
+    static BlockingSPITransport &getInstance();
+};
+
+/**
+ * @brief   Transport that sends a limited number of packets every time
+ *          @ref isBusy is called, so the main loop is never blocked for long.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+class PolledSPITransport : public SPITransport {
+  public:
+    /**
+     * @param   packetsPerPoll
+     *          The number of packets to send per call to @ref isBusy (at least
+     *          one).
+     */
+    PolledSPITransport(uint16_t packetsPerPoll = 1)
+        : packetsPerPoll(packetsPerPoll > 0 ? packetsPerPoll : 1) {}
+
+    void begin() override;
+    void beginFrame(const SPIFrame &frame) override;
+    bool isBusy() override;
+
+  private:
+    SPIFrame frame;
+    uint16_t nextPacket = 0;
+    uint16_t packetsPerPoll;
+};
+
+/**
+ * @brief   Double-buffered, non-blocking output of SPI frames.
+ *
+ * The application enqueues a frame, which is copied to the back buffer, and
+ * carries on. As soon as the transport has finished sending the previous
+ * frame, the buffers are swapped and the new frame is sent. If a new frame is
+ * enqueued before the previous one could be started, it replaces it, so only
+ * the most recent state is ever sent.
+ *
+ * @tparam  MaxFrameSize
+ *          The maximum size of a frame in bytes.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+template <uint16_t MaxFrameSize>
+class AsyncSPIOutput {
+  public:
+    /**
+     * @param   transport
+     *          The transport that sends the frames.
+     * @param   csPin
+     *          The chip select (or latch) pin of the device.
+     * @param   settings
+     *          The SPI settings of the device.
+     */
+    AsyncSPIOutput(SPITransport &transport, pin_t csPin, SPISettings settings)
+        : transport(transport) {
+        frame.csPin    = csPin;
+        frame.settings = settings;
+    }
+
+    /// Initialize the transport.
+    void begin() { transport.begin(); }
+
+    /**
+     * @brief   Copy the given frame to the back buffer, and start sending it
+     *          if the transport is idle.
+     *
+     * @param   data
+     *          The data of all packets, back to back.
+     * @param   packetLength
+     *          The number of bytes in each packet.
+     * @param   numPackets
+     *          The number of packets.
+     * @retval  true
+     *          The frame was enqueued.
+     * @retval  false
+     *          The frame is larger than @p MaxFrameSize.
+     */
+    bool enqueue(const uint8_t *data, uint16_t packetLength,
+                 uint16_t numPackets) {
+        if ((uint32_t)packetLength * numPackets > MaxFrameSize)
+            return false;
+        memcpy(buffers[back], data, packetLength * numPackets);
+        pendingPacketLength = packetLength;
+        pendingNumPackets   = numPackets;
+        pending             = true;
+        poll();
+        return true;
+    }
+
+    /**
+     * @brief   Continue sending the current frame, and start sending the
+     *          pending frame when possible.
+     *
+     * @return  Whether there are still frames that are being sent or waiting
+     *          to be sent.
+     */
+    bool poll() {
+        if (sending && transport.isBusy())
+            return true;
+        sending = false;
+        if (!pending)
+            return false;
+        if (transport.isBusy()) // Busy with another device on the same bus
+            return true;
+        frame.data         = buffers[back];
+        frame.packetLength = pendingPacketLength;
+        frame.numPackets   = pendingNumPackets;
+        back ^= 1;
+        pending = false;
+        transport.beginFrame(frame);
+        sending = transport.isBusy();
+        return sending;
+    }
+
+    /// Check if there are frames that are being sent or waiting to be sent.
+    bool isBusy() { return poll(); }
+
+    /// Check if there is a frame waiting to be sent, which would be replaced
+    /// by the next call to @ref enqueue.
+    bool hasPendingFrame() const { return pending; }
+
+    /// Wait until all frames have been sent.
+    void flush() {
+        while (poll())
+            ;
+    }
+
+  private:
+    SPITransport &transport;
+    SPIFrame frame;
+    uint8_t buffers[2][MaxFrameSize];
+    uint16_t pendingPacketLength = 0;
+    uint16_t pendingNumPackets   = 0;
+    uint8_t back                 = 0;
+    bool pending                 = false;
+    bool sending                 = false;
+};
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Containers/BitArray.hpp>
+#include <AH/Hardware/Button.hpp>
+#include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
+#include <AH/Settings/SettingsWrapper.hpp>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   Debounces a large number of buttons in parallel, using vertical
+ *          (bit-sliced) counters.
+ *
+ * Instead of keeping a timestamp and a state machine for every button, like
+ * @ref Button does, every button gets a two-bit counter, and the bits of
+ * these counters are stored "vertically" in machine words: bit `i` of
+ * `count0[w]` and `count1[w]` together form the counter of button
+ * `w * WordBits + i`. All buttons in one word are then updated at once using
+ * a handful of bitwise operations, so the cost of a scan is proportional to
+ * `N / WordBits` instead of `N`.
+ *
+ * The debounced state of a button changes when its input differs from the
+ * debounced state for four consecutive samples. If the input bounces back
+ * before that, the counter is reset.
+ *
+ * The inputs are packed, least significant bit first, in the same format as
+ * @ref ExtIO::digitalReadBuffer and @ref BitArray. Like @ref Button, a `HIGH`
+ * state means released (when using the internal pull-up resistors), so
+ * pressing a button results in a falling edge.
+ *
+ * ```
+ * Samples:             ├──┼──┼──┼──┼──┼──┼──┼──┼──┼──┤
+ *
+ * Raw input:
+ *    HIGH  ────────┐  ┌──┐        ┌──────────────────
+ *    LOW           └──┘  └────────┘
+ *
+ * Debounced output:
+ *    HIGH  ──────────────────────┐        ┌──────────
+ *    LOW                         └────────┘
+ * ```
+ *
+ * @tparam  N
+ *          The number of buttons.
+ * @tparam  Word
+ *          The unsigned integer type that is used to process the buttons in
+ *          parallel. Use the native word size of the processor for the best
+ *          performance (e.g. `uint8_t` on AVR, `uint32_t` on ARM).
+ *
+ * @ingroup AH_HardwareUtils
+ */
+template <uint16_t N, class Word = uint8_t>
+class BitSlicedDebouncer {
+  public:
+    /// The number of buttons that are processed in parallel.
+    constexpr static uint8_t WordBits = 8 * sizeof(Word);
+    /// The number of words that are required to store the state of all
+    /// buttons.
+    constexpr static uint16_t NumWords = (N + WordBits - 1) / WordBits;
+    /// The number of bytes of a packed input buffer.
+    constexpr static uint16_t NumBytes = (N + 7) / 8;
+
+    /**
+     * @brief   Create a debouncer with all buttons released (`HIGH`).
+     *
+     * @param   sampleInterval
+     *          The minimum time between two samples in milliseconds, only used
+     *          by @ref readPins.
+     */
+    BitSlicedDebouncer(unsigned long sampleInterval = BUTTON_DEBOUNCE_TIME / 4)
+        : sampleInterval(sampleInterval) {
+        reset();
+    }
+
+    /**
+     * @brief   Reset all counters and set the debounced state of all buttons.
+     *
+     * @param   state
+     *          The new debounced state of all buttons.
+     */
+    void reset(bool state = HIGH) {
+        for (uint16_t w = 0; w < NumWords; ++w) {
+            this->state[w] = state ? getValidMask(w) : Word(0);
+            count0[w] = count1[w] = toggled[w] = 0;
+        }
+    }
+
+    /**
+     * @brief   Process one sample of all buttons.
+     *
+     * @param   samples
+     *          The raw inputs of all buttons, `NumWords` words, least
+     *          significant bit first. The unused bits of the last word are
+     *          ignored.
+     * @return  Whether the debounced state of any of the buttons changed.
+     */
+    bool update(const Word *samples) {
+        Word changed = 0;
+        for (uint16_t w = 0; w < NumWords; ++w)
+            changed |= updateWord(w, samples[w]);
+        return changed != 0;
+    }
+
+    /**
+     * @brief   Process one sample of all buttons, packed in bytes.
+     *
+     * @param   bits
+     *          The raw inputs of all buttons, `NumBytes` bytes, least
+     *          significant bit first.
+     * @return  Whether the debounced state of any of the buttons changed.
+     */
+    bool updateBytes(const uint8_t *bits) {
+        Word changed = 0;
+        for (uint16_t w = 0; w < NumWords; ++w) {
+            Word sample = 0;
+            for (uint8_t b = 0; b < sizeof(Word); ++b) {
+                uint16_t i = w * sizeof(Word) + b;
+                if (i < NumBytes)
+                    sample |= Word(Word(bits[i]) << (8 * b));
+            }
+            changed |= updateWord(w, sample);
+        }
+        return changed != 0;
+    }
+
+    /**
+     * @brief   Process one sample of all buttons, stored in a BitArray.
+     *
+     * @return  Whether the debounced state of any of the buttons changed.
+     */
+    template <uint8_t M>
+    bool update(const BitArray<M> &bits) {
+        static_assert(M >= N, "Not enough bits for all buttons");
+        uint8_t buffer[NumBytes];
+        for (uint16_t i = 0; i < NumBytes; ++i)
+            buffer[i] = bits.getByte(i);
+        return updateBytes(buffer);
+    }
+
+    /// Enable the internal pull-up resistors of the range of pins starting at
+    /// @p firstPin.
+    void begin(pin_t firstPin) {
+        for (pin_t i = 0; i < N; ++i)
+            ExtIO::pinMode(firstPin + i, INPUT_PULLUP);
+    }
+
+    /**
+     * @brief   Read the range of `N` pins starting at @p firstPin, and process
+     *          the sample, if the sample interval has elapsed.
+     *
+     * The pins are read using @ref ExtIO::digitalReadBuffer, so extended IO
+     * elements only have to read their inputs once, and `millis` is called
+     * only once per scan.
+     *
+     * @return  Whether the debounced state of any of the buttons changed.
+     */
+    bool readPins(pin_t firstPin) {
+        unsigned long now = millis();
+        if (now - prevSampleTime < sampleInterval) {
+            // Edges are only reported once
+            for (uint16_t w = 0; w < NumWords; ++w)
+                toggled[w] = 0;
+            return false;
+        }
+        prevSampleTime = now;
+        uint8_t bits[NumBytes];
+        ExtIO::digitalReadBuffer(firstPin, bits, N);
+        return updateBytes(bits);
+    }
+
+    /// Get the debounced states of the given word of buttons.
+    Word getStates(uint16_t word) const { return state[word]; }
+    /// Get the buttons of the given word that went from `HIGH` to `LOW`
+    /// (pressed) during the last update.
+    Word getFallingEdges(uint16_t word) const {
+        return Word(toggled[word] & ~state[word]);
+    }
+    /// Get the buttons of the given word that went from `LOW` to `HIGH`
+    /// (released) during the last update.
+    Word getRisingEdges(uint16_t word) const {
+        return toggled[word] & state[word];
+    }
+
+    /// Get the debounced state of the given button.
+    bool getState(uint16_t index) const {
+        return state[index / WordBits] & getMask(index);
+    }
+
+    /**
+     * @brief   Get the state of the given button, in the same format as
+     *          @ref Button::update.
+     *
+     * @param   index
+     *          The index of the button [0, N-1].
+     */
+    Button::State getButtonState(uint16_t index) const {
+        uint16_t w = index / WordBits;
+        Word mask = getMask(index);
+        bool current = state[w] & mask;
+        bool previous = (state[w] ^ toggled[w]) & mask;
+        return static_cast<Button::State>((previous << 1) | current);
+    }
+
+    /// Set the minimum time between two samples in milliseconds.
+    void setSampleInterval(unsigned long interval) {
+        sampleInterval = interval;
+    }
+    /// Get the minimum time between two samples in milliseconds.
+    unsigned long getSampleInterval() const { return sampleInterval; }
+
+  private:
+    /// Update the counters and states of one word of buttons, and return the
+    /// buttons that changed state.
+    Word updateWord(uint16_t w, Word sample) {
+        Word delta = Word((sample ^ state[w]) & getValidMask(w));
+        // Increment the counters of the buttons whose input differs from their
+        // debounced state, reset the others
+        count1[w] = Word((count1[w] ^ count0[w]) & delta);
+        count0[w] = Word(~count0[w] & delta);
+        // The counters that wrapped around (3 → 0) have been different for
+        // four consecutive samples
+        toggled[w] = Word(delta & ~(count0[w] | count1[w]));
+        state[w] ^= toggled[w];
+        return toggled[w];
+    }
+
+    static Word getMask(uint16_t index) {
+        return Word(Word(1) << (index % WordBits));
+    }
+
+    /// Get the mask of the bits of the given word that correspond to buttons.
+    static Word getValidMask(uint16_t w) {
+        return w + 1 < NumWords || N % WordBits == 0
+                   ? Word(~Word(0))
+                   : Word((Word(1) << (N % WordBits)) - 1);
+    }
+
+  private:
+    Word state[NumWords];
+    Word count0[NumWords];
+    Word count1[NumWords];
+    Word toggled[NumWords];
+    unsigned long prevSampleTime = 0;
+    unsigned long sampleInterval;
+};
+
+template <uint16_t N, class Word>
+constexpr uint8_t BitSlicedDebouncer<N, Word>::WordBits;
+template <uint16_t N, class Word>
+constexpr uint16_t BitSlicedDebouncer<N, Word>::NumWords;
+template <uint16_t N, class Word>
+constexpr uint16_t BitSlicedDebouncer<N, Word>::NumBytes;
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -126,7 +126,7 @@ class Button {
      */
     static unsigned long getDebounceTime();
 
-  private:
+  protected:
     pin_t pin;
 
     bool prevInput = HIGH;
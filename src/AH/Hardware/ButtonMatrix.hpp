@@ -5,6 +5,7 @@
 #include <AH/Settings/Warnings.hpp>
 AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
+#include <AH/Hardware/BitSlicedDebouncer.hpp>
 #include <AH/Hardware/Hardware-Types.hpp>
 
 BEGIN_AH_NAMESPACE
@@ -12,6 +13,13 @@ BEGIN_AH_NAMESPACE
 /**
  * @brief   A class that reads the states of a button matrix.
  *
+ * Every scan reads all buttons, and each button is debounced individually
+ * using a @ref BitSlicedDebouncer, so the scan time is fixed, and buttons
+ * that are pressed at the same time (chords) are never missed (N-key
+ * rollover, if the matrix has diodes).
+ * If the column pins are consecutive, all columns of a row are read at once
+ * using @ref ExtIO::digitalReadBuffer.
+ *
  * @tparam  nb_rows
  *          The number of rows in the button matrix.
  * @tparam  nb_cols
@@ -50,15 +58,34 @@ class ButtonMatrix {
     /**
      * @brief   Scan the matrix, read all button states, and call the
      *          onButtonChanged callback.
+     *
+     * The matrix is scanned at most once every
+     * `BitSlicedDebouncer::getSampleInterval()` milliseconds. The callbacks
+     * are called after the entire matrix has been scanned and debounced, for
+     * all buttons that changed during that scan.
+     *
+     * @return  The number of buttons that changed state.
      */
-    void update();
+    uint16_t update();
 
     /** 
      * Get the state of the button in the given column and row.
      * 
      * @note    No bounds checking is performed.
      */
-    bool getPrevState(uint8_t col, uint8_t row);
+    bool getPrevState(uint8_t col, uint8_t row) const;
+
+    /// The number of bytes that are used to store one row of the matrix.
+    constexpr static uint8_t RowBytes = (nb_cols + 7) / 8;
+    /// The type of the debouncer used for all buttons. Bit `c` of byte `b` of
+    /// row `r` is stored at index `8 * (r * RowBytes + b) + c`.
+    using Debouncer = BitSlicedDebouncer<8 * RowBytes * nb_rows>;
+
+    /// Get the debouncer, e.g. to access the edges of all buttons of the last
+    /// scan as bitmasks.
+    const Debouncer &getDebouncer() const { return debouncer; }
+    /// @copydoc getDebouncer
+    Debouncer &getDebouncer() { return debouncer; }
 
   private:
     /**
@@ -74,16 +101,20 @@ class ButtonMatrix {
      */
     virtual void onButtonChanged(uint8_t row, uint8_t col, bool state) = 0;
 
-    static inline uint8_t positionToBits(uint8_t col, uint8_t row);
-    static inline uint8_t bitsToIndex(uint8_t bits);
-    static inline uint8_t bitsToBitmask(uint8_t bits);
-    void setPrevState(uint8_t col, uint8_t row, bool state);
+    /// Read all columns of the currently selected row.
+    void readColumns(uint8_t *bits) const;
+    /// Call the onButtonChanged callback for all buttons that changed state
+    /// during the last scan.
+    uint16_t emitChanges();
 
-    unsigned long prevRefresh = 0;
-    uint8_t prevStates[(nb_cols * nb_rows + 7) / 8];
+    unsigned long prevScan = 0;
+    Debouncer debouncer;
 
     const PinList<nb_rows> rowPins;
     const PinList<nb_cols> colPins;
+    /// Whether the column pins are consecutive, so they can be read using a
+    /// single call to ExtIO::digitalReadBuffer.
+    bool colPinsConsecutive = true;
 };
 
 END_AH_NAMESPACE
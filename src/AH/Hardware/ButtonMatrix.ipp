@@ -10,31 +10,64 @@ template <uint8_t nb_rows, uint8_t nb_cols>
 ButtonMatrix<nb_rows, nb_cols>::ButtonMatrix(const PinList<nb_rows> &rowPins,
                                              const PinList<nb_cols> &colPins)
     : rowPins(rowPins), colPins(colPins) {
-    memset(prevStates, 0xFF, sizeof(prevStates));
+    for (uint8_t col = 1; col < nb_cols; ++col)
+        if (colPins[col] != colPins[0] + col)
+            colPinsConsecutive = false;
 }
 
 template <uint8_t nb_rows, uint8_t nb_cols>
-void ButtonMatrix<nb_rows, nb_cols>::update() {
+uint16_t ButtonMatrix<nb_rows, nb_cols>::update() {
     unsigned long now = millis();
-    // only update 25 ms after previous change (crude software debounce).
-    // Edit this in Settings/Settings.hpp
-    if (now - prevRefresh < BUTTON_DEBOUNCE_TIME)
-        return;
+    // Sample all buttons at a fixed rate, they are debounced individually.
+    // Edit the default rate in Settings/Settings.hpp (BUTTON_DEBOUNCE_TIME)
+    if (now - prevScan < debouncer.getSampleInterval())
+        return 0;
+    prevScan = now;
 
-    for (size_t row = 0; row < nb_rows; row++) { // scan through all rows
-        pinMode(rowPins[row], OUTPUT);           // make the current row Lo-Z 0V
-        for (size_t col = 0; col < nb_cols; col++) { // scan through all columns
-            bool state = digitalRead(colPins[col]);  // read the state
-            if (state != getPrevState(col, row)) {
-                // if the state changed since last time
-                // execute the handler
-                onButtonChanged(row, col, state);
-                setPrevState(col, row, state); // remember the state
-                prevRefresh = now;
+    uint8_t samples[nb_rows][RowBytes];
+    for (uint8_t row = 0; row < nb_rows; row++) { // scan through all rows
+        pinMode(rowPins[row], OUTPUT); // make the current row Lo-Z 0V
+        readColumns(samples[row]);     // read all columns at once
+        pinMode(rowPins[row], INPUT);  // make the current row Hi-Z again
+    }
+    if (!debouncer.updateBytes(&samples[0][0]))
+        return 0;
+    return emitChanges();
+}
+
+template <uint8_t nb_rows, uint8_t nb_cols>
+void ButtonMatrix<nb_rows, nb_cols>::readColumns(uint8_t *bits) const {
+    if (colPinsConsecutive) {
+        digitalReadBuffer(colPins[0], bits, nb_cols);
+    } else {
+        memset(bits, 0, RowBytes);
+        for (uint8_t col = 0; col < nb_cols; col++)
+            if (digitalRead(colPins[col]))
+                bits[col / 8] |= 1 << (col % 8);
+    }
+    // The unused bits of the last byte are always released
+    if (nb_cols % 8 != 0)
+        bits[RowBytes - 1] |= 0xFF << (nb_cols % 8);
+}
+
+template <uint8_t nb_rows, uint8_t nb_cols>
+uint16_t ButtonMatrix<nb_rows, nb_cols>::emitChanges() {
+    uint16_t changes = 0;
+    for (uint8_t row = 0; row < nb_rows; row++) {
+        for (uint8_t b = 0; b < RowBytes; b++) {
+            uint16_t word = row * RowBytes + b;
+            uint8_t toggled = debouncer.getFallingEdges(word) |
+                              debouncer.getRisingEdges(word);
+            uint8_t states = debouncer.getStates(word);
+            for (uint8_t bit = 0; toggled != 0; ++bit, toggled >>= 1) {
+                if (toggled & 1) {
+                    onButtonChanged(row, 8 * b + bit, (states >> bit) & 1);
+                    ++changes;
+                }
             }
         }
-        pinMode(rowPins[row], INPUT); // make the current row Hi-Z again
     }
+    return changes;
 }
 
 template <uint8_t nb_rows, uint8_t nb_cols>
@@ -49,36 +82,9 @@ void ButtonMatrix<nb_rows, nb_cols>::begin() {
 }
 
 template <uint8_t nb_rows, uint8_t nb_cols>
-inline uint8_t ButtonMatrix<nb_rows, nb_cols>::positionToBits(uint8_t col,
-                                                              uint8_t row) {
-    // map from a 2D array of bits to a flat array of bits
-    return col * nb_rows + row;
-}
-
-template <uint8_t nb_rows, uint8_t nb_cols>
-inline uint8_t ButtonMatrix<nb_rows, nb_cols>::bitsToIndex(uint8_t bits) {
-    return bits >> 3; // bits / 8
-}
-
-template <uint8_t nb_rows, uint8_t nb_cols>
-inline uint8_t ButtonMatrix<nb_rows, nb_cols>::bitsToBitmask(uint8_t bits) {
-    return 1 << (bits & 7); // bits % 8
-}
-
-template <uint8_t nb_rows, uint8_t nb_cols>
-bool ButtonMatrix<nb_rows, nb_cols>::getPrevState(uint8_t col, uint8_t row) {
-    uint8_t bits = positionToBits(col, row);
-    return !!(prevStates[bitsToIndex(bits)] & bitsToBitmask(bits));
-}
-
-template <uint8_t nb_rows, uint8_t nb_cols>
-void ButtonMatrix<nb_rows, nb_cols>::setPrevState(uint8_t col, uint8_t row,
-                                                  bool state) {
-    uint8_t bits = positionToBits(col, row);
-    if (state)
-        prevStates[bitsToIndex(bits)] |= bitsToBitmask(bits);
-    else
-        prevStates[bitsToIndex(bits)] &= ~bitsToBitmask(bits);
+bool ButtonMatrix<nb_rows, nb_cols>::getPrevState(uint8_t col,
+                                                  uint8_t row) const {
+    return debouncer.getState(8 * RowBytes * row + col);
 }
 
-END_AH_NAMESPACE
\ No newline at end of file
+END_AH_NAMESPACE
@@ -8,6 +8,7 @@ AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 #include "ExtendedInputOutput.hpp"
 #include "StaticSizeExtendedIOElement.hpp"
 #include <AH/Containers/Array.hpp>
+#include <AH/Settings/SettingsWrapper.hpp>
 #include <stdlib.h>
 
 BEGIN_AH_NAMESPACE
@@ -86,6 +87,26 @@ class AnalogMultiplex : public StaticSizeExtendedIOElement<1 << N> {
      */
     analog_t analogRead(pin_t pin) override;
 
+    /**
+     * @brief   Read the digital states of a range of inputs.
+     *
+     * The multiplexer is enabled only once for the entire range, and only the
+     * address lines that change between two consecutive inputs are written.
+     *
+     * @copydetails ExtendedIOElement::digitalReadBuffer
+     */
+    void digitalReadBuffer(pin_t pin, uint8_t *bits, pin_t count) override;
+
+    /**
+     * @brief   Read the analog values of a range of inputs.
+     *
+     * The multiplexer is enabled only once for the entire range, and only the
+     * address lines that change between two consecutive inputs are written.
+     *
+     * @copydetails ExtendedIOElement::analogReadBuffer
+     */
+    void analogReadBuffer(pin_t pin, analog_t *values, pin_t count) override;
+
     /**
      * @brief   The analogWrite function is not implemented because writing an
      *          output to a multiplexer is not useful.
@@ -105,7 +126,7 @@ class AnalogMultiplex : public StaticSizeExtendedIOElement<1 << N> {
      */
     void update() override {} // LCOV_EXCL_LINE
 
-  private:
+  protected:
     const pin_t analogPin;
     const Array<pin_t, N> addressPins;
     const pin_t enablePin;
@@ -119,6 +140,29 @@ class AnalogMultiplex : public StaticSizeExtendedIOElement<1 << N> {
      */
     void setMuxAddress(uint8_t address);
 
+    /**
+     * @brief   Write only the address lines that differ between the previous
+     *          and the new address.
+     *
+     * @param   address
+     *          The address to select.
+     * @param   previous
+     *          The address that is currently selected.
+     */
+    void changeMuxAddress(uint8_t address, uint8_t previous);
+
+    /**
+     * @brief   Write only the address lines that differ between the previous
+     *          and the new address, without waiting for the output of the
+     *          multiplexer to settle.
+     *
+     * @param   address
+     *          The address to select.
+     * @param   previous
+     *          The address that is currently selected.
+     */
+    void writeMuxAddress(uint8_t address, uint8_t previous);
+
     /**
      * @brief   Select the correct address and enable the multiplexer.
      * 
@@ -177,6 +221,39 @@ analog_t AnalogMultiplex<N>::analogRead(pin_t pin) {
     return result;
 }
 
+template <uint8_t N>
+void AnalogMultiplex<N>::digitalReadBuffer(pin_t pin, uint8_t *bits,
+                                           pin_t count) {
+    if (count == 0)
+        return;
+    prepareReading(pin);
+    for (pin_t i = 0; i < count; ++i) {
+        if (i > 0)
+            changeMuxAddress(pin + i, pin + i - 1);
+        uint8_t mask = 1 << (i % 8);
+        if (ExtIO::digitalRead(analogPin))
+            bits[i / 8] |= mask;
+        else
+            bits[i / 8] &= ~mask;
+    }
+    afterReading();
+}
+
+template <uint8_t N>
+void AnalogMultiplex<N>::analogReadBuffer(pin_t pin, analog_t *values,
+                                          pin_t count) {
+    if (count == 0)
+        return;
+    prepareReading(pin);
+    for (pin_t i = 0; i < count; ++i) {
+        if (i > 0)
+            changeMuxAddress(pin + i, pin + i - 1);
+        ExtIO::analogRead(analogPin); // Discard first reading
+        values[i] = ExtIO::analogRead(analogPin);
+    }
+    afterReading();
+}
+
 template <uint8_t N>
 void AnalogMultiplex<N>::begin() {
     for (const pin_t &addressPin : addressPins)
@@ -195,10 +272,29 @@ void AnalogMultiplex<N>::setMuxAddress(uint8_t address) {
         mask <<= 1;
     }
 #if !defined(__AVR__) && !defined(__x86_64__)
-    delayMicroseconds(5);
+    delayMicroseconds(ANALOG_MUX_SETTLE_TIME);
+#endif
+}
+
+template <uint8_t N>
+void AnalogMultiplex<N>::changeMuxAddress(uint8_t address, uint8_t previous) {
+    writeMuxAddress(address, previous);
+#if !defined(__AVR__) && !defined(__x86_64__)
+    delayMicroseconds(ANALOG_MUX_SETTLE_TIME);
 #endif
 }
 
+template <uint8_t N>
+void AnalogMultiplex<N>::writeMuxAddress(uint8_t address, uint8_t previous) {
+    uint8_t changed = address ^ previous;
+    uint8_t mask = 1;
+    for (const pin_t &addressPin : addressPins) {
+        if (changed & mask)
+            ExtIO::digitalWrite(addressPin, (address & mask) != 0 ? HIGH : LOW);
+        mask <<= 1;
+    }
+}
+
 template <uint8_t N>
 void AnalogMultiplex<N>::prepareReading(uint8_t address) {
     setMuxAddress(address);
@@ -16,15 +16,100 @@ ExtendedIOElement::ExtendedIOElement(pin_t length)
                     0x00FF);
     offset = end;
     elements.append(this);
+    dispatchTableValid = false;
 }
 
-ExtendedIOElement::~ExtendedIOElement() { elements.remove(this); }
+ExtendedIOElement::~ExtendedIOElement() {
+    elements.remove(this);
+    dispatchTableValid = false;
+    if (lastElement == this)
+        lastElement = nullptr;
+}
+
+void ExtendedIOElement::digitalWriteBuffer(pin_t pin, const uint8_t *bits,
+                                           pin_t count) {
+    for (pin_t i = 0; i < count; ++i)
+        digitalWrite(pin + i, (bits[i / 8] >> (i % 8)) & 1 ? HIGH : LOW);
+}
+
+void ExtendedIOElement::digitalReadBuffer(pin_t pin, uint8_t *bits,
+                                          pin_t count) {
+    for (pin_t i = 0; i < count; ++i) {
+        uint8_t mask = 1 << (i % 8);
+        if (digitalRead(pin + i))
+            bits[i / 8] |= mask;
+        else
+            bits[i / 8] &= ~mask;
+    }
+}
+
+void ExtendedIOElement::analogReadBuffer(pin_t pin, analog_t *values,
+                                         pin_t count) {
+    for (pin_t i = 0; i < count; ++i)
+        values[i] = analogRead(pin + i);
+}
 
 void ExtendedIOElement::beginAll() {
+    updateDispatchTable();
     for (ExtendedIOElement &e : elements)
         e.begin();
 }
 
+void ExtendedIOElement::updateAll() {
+    for (ExtendedIOElement &e : elements)
+        e.update();
+}
+
+void ExtendedIOElement::updateDispatchTable() {
+    // The pin numbers are assigned in the order the elements are created, and
+    // new elements are appended to the list, so the list is already sorted.
+    dispatchTableSize = 0;
+    for (ExtendedIOElement &e : elements) {
+        if (dispatchTableSize == EXTIO_DISPATCH_TABLE_SIZE) {
+            dispatchTableSize = 0; // Doesn't fit, use linear search
+            break;
+        }
+        dispatchTable[dispatchTableSize++] = &e;
+    }
+    dispatchTableValid = true;
+}
+
+ExtendedIOElement *ExtendedIOElement::findElementOfPin(pin_t pin) {
+    ExtendedIOElement *el = lastElement;
+    if (el == nullptr || pin < el->start || pin >= el->end) {
+        el = searchElementOfPin(pin);
+        if (el != nullptr)
+            lastElement = el;
+    }
+    return el;
+}
+
+ExtendedIOElement *ExtendedIOElement::searchElementOfPin(pin_t pin) {
+    if (!dispatchTableValid)
+        updateDispatchTable();
+    if (dispatchTableSize == 0 && elements.getFirst() != nullptr) {
+        for (ExtendedIOElement &el : elements)
+            if (pin < el.start)
+                break;
+            else if (pin < el.end)
+                return &el;
+        return nullptr;
+    }
+    // Find the last element that starts at or before the given pin
+    uint8_t lo = 0, hi = dispatchTableSize;
+    while (lo < hi) {
+        uint8_t mid = lo + (hi - lo) / 2;
+        if (dispatchTable[mid]->start <= pin)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == 0)
+        return nullptr;
+    ExtendedIOElement *el = dispatchTable[lo - 1];
+    return pin < el->end ? el : nullptr;
+}
+
 pin_t ExtendedIOElement::pin(pin_t p) const {
     if (p >= length) {
         static_assert(std::is_unsigned<pin_t>::value,
@@ -54,6 +139,11 @@ DoublyLinkedList<ExtendedIOElement> &ExtendedIOElement::getAll() {
 
 DoublyLinkedList<ExtendedIOElement> ExtendedIOElement::elements;
 
+ExtendedIOElement *ExtendedIOElement::dispatchTable[EXTIO_DISPATCH_TABLE_SIZE];
+uint8_t ExtendedIOElement::dispatchTableSize      = 0;
+bool ExtendedIOElement::dispatchTableValid        = false;
+ExtendedIOElement *ExtendedIOElement::lastElement = nullptr;
+
 pin_t ExtendedIOElement::offset = NUM_DIGITAL_PINS + NUM_ANALOG_INPUTS;
 
 END_AH_NAMESPACE
@@ -8,6 +8,7 @@ AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 #include "ExtendedInputOutput.hpp"
 #include <AH/Containers/LinkedList.hpp>
 #include <AH/Hardware/Hardware-Types.hpp>
+#include <AH/Settings/SettingsWrapper.hpp>
 
 BEGIN_AH_NAMESPACE
 
@@ -47,18 +48,20 @@ BEGIN_AH_NAMESPACE
  * translated to `mux1.digitalRead(7)`.
  *
  * The number of extended IO elements is limited only by the size of
- * `pin_t`. However, looking up the extended IO element for a given
- * extended IO pin number uses linear search, so that might add
- * some noticable overhead for large pin numbers.  
+ * `pin_t`. Looking up the extended IO element for a given extended IO pin
+ * number uses a small table of all elements, sorted by their first pin number,
+ * which is searched using binary search. The element of the previous lookup is
+ * cached, so consecutive accesses to the pins of the same element don't have
+ * to search at all. The table is built by @ref beginAll, and it is rebuilt
+ * automatically when elements are created or destroyed later. If there are
+ * more than @ref EXTIO_DISPATCH_TABLE_SIZE elements, a linear search of all
+ * elements is used instead.
  * 
  * The design here is a compromise: saving a pointer to each extended IO element
- * to find it directly would be much faster than having to search all elements
- * each time. On the other hand, it would require each `pin_t` variable to be
- * at least one byte larger. Since almost all other classes in this library 
- * store pin variables, the memory penalty would be too large, especially on AVR
- * microcontrollers.  
- * Another reason to do it this way, is that this approach is still fast enough
- * to make sure it is not noticable to human users.
+ * in the pin number would be faster still. On the other hand, it would require
+ * each `pin_t` variable to be at least one byte larger. Since almost all other
+ * classes in this library store pin variables, the memory penalty would be too
+ * large, especially on AVR microcontrollers.
  */
 class ExtendedIOElement : public DoublyLinkable<ExtendedIOElement> {
   protected:
@@ -129,13 +132,62 @@ class ExtendedIOElement : public DoublyLinkable<ExtendedIOElement> {
      */
     virtual analog_t analogRead(pin_t pin) = 0;
 
+    /**
+     * @brief   Set the outputs of a range of pins.
+     *
+     * The default implementation calls @ref digitalWrite for each pin.
+     * Subclasses can override it to update all pins at once.
+     *
+     * @param   pin
+     *          The first (zero-based) pin of this IO element to write to.
+     * @param   bits
+     *          The new states of the pins, packed eight pins per byte, least
+     *          significant bit first: the state of pin `pin + i` is bit `i % 8`
+     *          of `bits[i / 8]`.
+     * @param   count
+     *          The number of pins to write to.
+     */
+    virtual void digitalWriteBuffer(pin_t pin, const uint8_t *bits,
+                                    pin_t count);
+
+    /**
+     * @brief   Read the states of a range of pins.
+     *
+     * The default implementation calls @ref digitalRead for each pin.
+     *
+     * @param   pin
+     *          The first (zero-based) pin of this IO element to read from.
+     * @param   bits
+     *          The buffer to store the states in, packed in the same way as
+     *          for @ref digitalWriteBuffer. Bits beyond `count` in the last
+     *          byte are left untouched.
+     * @param   count
+     *          The number of pins to read from.
+     */
+    virtual void digitalReadBuffer(pin_t pin, uint8_t *bits, pin_t count);
+
+    /**
+     * @brief   Read the analog values of a range of pins.
+     *
+     * The default implementation calls @ref analogRead for each pin.
+     *
+     * @param   pin
+     *          The first (zero-based) pin of this IO element to read from.
+     * @param   values
+     *          The buffer to store the `count` values in.
+     * @param   count
+     *          The number of pins to read from.
+     */
+    virtual void analogReadBuffer(pin_t pin, analog_t *values, pin_t count);
+
     /**
      * @brief   Initialize the extended IO element.
      */
     virtual void begin() = 0;
 
     /**
-     * @brief   Initialize all extended IO elements.
+     * @brief   Initialize all extended IO elements, and build the table that is
+     *          used to look up the element of an extended IO pin.
      */
     static void beginAll();
 
@@ -146,6 +198,15 @@ class ExtendedIOElement : public DoublyLinkable<ExtendedIOElement> {
      */
     virtual void update() = 0;
 
+    /**
+     * @brief   Update all extended IO elements.
+     *
+     * Call this once per iteration of the main loop to write the outputs of
+     * elements that don't update automatically, e.g. shift registers with
+     * @ref ShiftRegisterOutBase::setAutoUpdate "automatic updates" disabled.
+     */
+    static void updateAll();
+
     /**
      * @brief   Get the extended IO pin number of a given physical pin of this
      *          extended IO element.
@@ -189,6 +250,24 @@ class ExtendedIOElement : public DoublyLinkable<ExtendedIOElement> {
      */
     static DoublyLinkedList<ExtendedIOElement> &getAll();
 
+    /**
+     * @brief   Find the extended IO element that the given extended IO pin
+     *          number belongs to.
+     *
+     * @param   pin
+     *          The global extended IO pin number.
+     * @return  A pointer to the element of the given pin, or a null pointer if
+     *          the pin doesn't belong to any extended IO element.
+     */
+    static ExtendedIOElement *findElementOfPin(pin_t pin);
+
+  private:
+    /// Copy the list of elements into the dispatch table.
+    static void updateDispatchTable();
+    /// Search the dispatch table (or the list of elements if it doesn't fit
+    /// the table) for the element of the given pin.
+    static ExtendedIOElement *searchElementOfPin(pin_t pin);
+
   private:
     const pin_t length;
     const pin_t start;
@@ -196,6 +275,15 @@ class ExtendedIOElement : public DoublyLinkable<ExtendedIOElement> {
     static pin_t offset;
 
     static DoublyLinkedList<ExtendedIOElement> elements;
+
+    /// All elements, sorted by their start pin.
+    static ExtendedIOElement *dispatchTable[EXTIO_DISPATCH_TABLE_SIZE];
+    /// The number of elements in the dispatch table.
+    static uint8_t dispatchTableSize;
+    /// Whether the dispatch table matches the list of elements.
+    static bool dispatchTableValid;
+    /// The element that was found by the previous lookup.
+    static ExtendedIOElement *lastElement;
 };
 
 END_AH_NAMESPACE
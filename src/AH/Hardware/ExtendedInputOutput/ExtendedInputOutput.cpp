@@ -9,28 +9,13 @@ BEGIN_AH_NAMESPACE
 
 namespace ExtIO {
 
-template <class T>
-bool inRange(T target, T start, T end) {
-    return target >= start && target < end;
-}
-
 ExtendedIOElement &getIOElementOfPin(pin_t pin) {
-    for (ExtendedIOElement &el : ExtendedIOElement::getAll())
-        if (pin < el.getStart())
-            break;
-        else if (inRange(pin, el.getStart(), el.getEnd()))
-            return el;
-
-    FATAL_ERROR(
-        F("The given pin does not correspond to an Extended IO element."),
-        0x8888);
-
-    // TODO: why doesn't this give a compilation error?
-    // No return statement. On desktop, FATAL_ERROR throws an exception, so
-    // I get why that works, but on Arduino, it just calls fatalErrorExit, which
-    // is marked 'noreturn'. However, if I remove the 'noreturn' attribute, and
-    // have it return immediately, it still compiles, without returning a valid
-    // reference.
+    ExtendedIOElement *el = ExtendedIOElement::findElementOfPin(pin);
+    if (el == nullptr)
+        FATAL_ERROR(
+            F("The given pin does not correspond to an Extended IO element."),
+            0x8888);
+    return *el;
 }
 
 void pinMode(pin_t pin, PinMode_t mode) {
@@ -109,6 +94,110 @@ void analogWrite(int pin, analog_t val) { analogWrite((pin_t)pin, val); }
 void analogWrite(int pin, int val) { analogWrite((pin_t)pin, (analog_t)val); }
 void analogWrite(pin_t pin, int val) { analogWrite(pin, (analog_t)val); }
 
+namespace {
+
+/// The number of consecutive pins starting at the given pin that can be
+/// handled by a single call: either all remaining Arduino pins, or all
+/// remaining pins of the extended IO element of the pin (in which case @p el is
+/// set to that element).
+pin_t getRangeLength(pin_t pin, pin_t count, ExtendedIOElement *&el) {
+    constexpr pin_t numArduinoPins = NUM_DIGITAL_PINS + NUM_ANALOG_INPUTS;
+    pin_t available;
+    if (pin < numArduinoPins) {
+        el        = nullptr;
+        available = numArduinoPins - pin;
+    } else {
+        el        = &getIOElementOfPin(pin);
+        available = el->getEnd() - pin;
+    }
+    return count < available ? count : available;
+}
+
+bool getBit(const uint8_t *bits, pin_t index) {
+    return (bits[index / 8] >> (index % 8)) & 1;
+}
+
+void setBit(uint8_t *bits, pin_t index, bool state) {
+    uint8_t mask = 1 << (index % 8);
+    if (state)
+        bits[index / 8] |= mask;
+    else
+        bits[index / 8] &= ~mask;
+}
+
+/// Copy @p count bits from @p src, starting at bit @p srcBit, to @p dst,
+/// starting at bit @p dstBit.
+void copyBits(const uint8_t *src, pin_t srcBit, uint8_t *dst, pin_t dstBit,
+              pin_t count) {
+    for (pin_t i = 0; i < count; ++i)
+        setBit(dst, dstBit + i, getBit(src, srcBit + i));
+}
+
+/// The size of the temporary buffer used when a range of an element doesn't
+/// start at a byte boundary of the user's buffer.
+constexpr pin_t MaxUnalignedBits = 32;
+
+} // namespace
+
+void digitalWriteBuffer(pin_t pin, const uint8_t *bits, pin_t count) {
+    pin_t done = 0;
+    while (done < count) {
+        ExtendedIOElement *el;
+        pin_t n = getRangeLength(pin + done, count - done, el);
+        if (el == nullptr) {
+            for (pin_t i = done; i < done + n; ++i)
+                ::digitalWrite(pin + i, getBit(bits, i) ? HIGH : LOW);
+        } else if (done % 8 == 0) {
+            el->digitalWriteBuffer(pin + done - el->getStart(), bits + done / 8,
+                                   n);
+        } else {
+            // Realign the bits for this element in a small temporary buffer
+            uint8_t tmp[MaxUnalignedBits / 8];
+            if (n > MaxUnalignedBits)
+                n = MaxUnalignedBits;
+            copyBits(bits, done, tmp, 0, n);
+            el->digitalWriteBuffer(pin + done - el->getStart(), tmp, n);
+        }
+        done += n;
+    }
+}
+
+void digitalReadBuffer(pin_t pin, uint8_t *bits, pin_t count) {
+    pin_t done = 0;
+    while (done < count) {
+        ExtendedIOElement *el;
+        pin_t n = getRangeLength(pin + done, count - done, el);
+        if (el == nullptr) {
+            for (pin_t i = done; i < done + n; ++i)
+                setBit(bits, i, ::digitalRead(pin + i) != 0);
+        } else if (done % 8 == 0) {
+            el->digitalReadBuffer(pin + done - el->getStart(), bits + done / 8,
+                                  n);
+        } else {
+            uint8_t tmp[MaxUnalignedBits / 8];
+            if (n > MaxUnalignedBits)
+                n = MaxUnalignedBits;
+            el->digitalReadBuffer(pin + done - el->getStart(), tmp, n);
+            copyBits(tmp, 0, bits, done, n);
+        }
+        done += n;
+    }
+}
+
+void analogReadBuffer(pin_t pin, analog_t *values, pin_t count) {
+    pin_t done = 0;
+    while (done < count) {
+        ExtendedIOElement *el;
+        pin_t n = getRangeLength(pin + done, count - done, el);
+        if (el == nullptr)
+            for (pin_t i = done; i < done + n; ++i)
+                values[i] = ::analogRead(pin + i);
+        else
+            el->analogReadBuffer(pin + done - el->getStart(), values + done, n);
+        done += n;
+    }
+}
+
 } // namespace ExtIO
 
 END_AH_NAMESPACE
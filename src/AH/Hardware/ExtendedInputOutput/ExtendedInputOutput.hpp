@@ -114,6 +114,48 @@ void analogWrite(int pin, int val);
 /// An ExtIO version of the Arduino function
 void analogWrite(pin_t pin, int val);
 
+/**
+ * @brief   Set the outputs of a range of consecutive pins.
+ *
+ * The range can span multiple extended IO elements (and Arduino pins), every
+ * element gets a single @ref ExtendedIOElement::digitalWriteBuffer call for
+ * its part of the range.
+ *
+ * @param   pin
+ *          The first (extended IO) pin number to write to.
+ * @param   bits
+ *          The new states of the pins, packed eight pins per byte, least
+ *          significant bit first: the state of pin `pin + i` is bit `i % 8` of
+ *          `bits[i / 8]`.
+ * @param   count
+ *          The number of pins to write to.
+ */
+void digitalWriteBuffer(pin_t pin, const uint8_t *bits, pin_t count);
+/**
+ * @brief   Read the states of a range of consecutive pins.
+ *
+ * @param   pin
+ *          The first (extended IO) pin number to read from.
+ * @param   bits
+ *          The buffer to store the states in, packed in the same way as for
+ *          @ref digitalWriteBuffer. Bits beyond `count` in the last byte are
+ *          left untouched.
+ * @param   count
+ *          The number of pins to read from.
+ */
+void digitalReadBuffer(pin_t pin, uint8_t *bits, pin_t count);
+/**
+ * @brief   Read the analog values of a range of consecutive pins.
+ *
+ * @param   pin
+ *          The first (extended IO) pin number to read from.
+ * @param   values
+ *          The buffer to store the `count` values in.
+ * @param   count
+ *          The number of pins to read from.
+ */
+void analogReadBuffer(pin_t pin, analog_t *values, pin_t count);
+
 } // namespace ExtIO
 
 END_AH_NAMESPACE
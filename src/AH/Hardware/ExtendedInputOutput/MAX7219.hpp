@@ -25,8 +25,12 @@ class MAX7219 : public MAX7219_Base, public StaticSizeExtendedIOElement<8 * 8> {
      * 
      * @param   loadPin
      *          The pin connected to the load pin (C̄S̄) of the MAX7219.
+     * @param   transport
+     *          The transport used to send the data over the SPI bus.
      */
-    MAX7219(pin_t loadPin) : MAX7219_Base(loadPin) {}
+    MAX7219(pin_t loadPin,
+            SPITransport &transport = BlockingSPITransport::getInstance())
+        : MAX7219_Base(loadPin, transport) {}
 
     /// Initialize.
     /// @see    MAX7219#init
@@ -52,7 +56,11 @@ class MAX7219 : public MAX7219_Base, public StaticSizeExtendedIOElement<8 * 8> {
      *          (Either `HIGH` (1) or `LOW` (0))
      */
     void digitalWrite(pin_t pin, PinStatus_t val) override {
-        buffer.set(pin, val);
+        bool state = val != LOW;
+        if (buffer.get(pin) != state) {
+            buffer.set(pin, state);
+            dirty = true;
+        }
         update();
     }
 
@@ -101,17 +109,24 @@ class MAX7219 : public MAX7219_Base, public StaticSizeExtendedIOElement<8 * 8> {
     }
 
     /**
-     * @brief   Write the buffer to the display.
-     * 
-     * @todo    Does this really have to happen on each update?
+     * @brief   Write the buffer to the display if it changed, and continue
+     *          sending the previous frame if the transport is asynchronous.
      */
     void update() override {
-        for (uint8_t i = 0; i < buffer.getBufferLength(); i++)
-            sendRaw(i + 1, buffer.getByte(i));
+        if (dirty) {
+            uint8_t rows[8];
+            for (uint8_t i = 0; i < buffer.getBufferLength(); i++)
+                rows[i] = buffer.getByte(i);
+            sendRows(rows);
+            dirty = false;
+        } else {
+            poll();
+        }
     }
 
   private:
     BitArray<8 * 8> buffer;
+    bool dirty = true;
 };
 
 END_AH_NAMESPACE
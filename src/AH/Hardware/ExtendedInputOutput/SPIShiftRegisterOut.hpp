@@ -7,6 +7,7 @@ AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
 #include "ShiftRegisterOutBase.hpp"
 #include <AH/Containers/BitArray.hpp>
+#include <AH/Hardware/AsyncSPIOutput.hpp>
 
 AH_DIAGNOSTIC_EXTERNAL_HEADER()
 #include <AH/Arduino-Wrapper.h> // MSBFIRST, SS
@@ -23,6 +24,10 @@ BEGIN_AH_NAMESPACE
  *          74HC595) have eight bits per chip, so `length = 8 * k` where `k`
  *          is the number of cascaded chips.
  * 
+ * The outputs are sent through an @ref AsyncSPIOutput, so with an
+ * asynchronous @ref SPITransport, @ref update doesn't wait for the data to be
+ * sent, and it has to be called regularly to finish the transfer.
+ * 
  * @ingroup AH_ExtIO
  */
 template <uint8_t N>
@@ -51,8 +56,12 @@ class SPIShiftRegisterOut : public ShiftRegisterOutBase<N> {
      * @param   bitOrder
      *          Either `MSBFIRST` (most significant bit first) or `LSBFIRST`
      *          (least significant bit first).
+     * @param   transport
+     *          The transport used to send the data over the SPI bus.
      */
-    SPIShiftRegisterOut(pin_t latchPin = SS, BitOrder_t bitOrder = MSBFIRST);
+    SPIShiftRegisterOut(
+        pin_t latchPin = SS, BitOrder_t bitOrder = MSBFIRST,
+        SPITransport &transport = BlockingSPITransport::getInstance());
 
     /**
      * @brief   Initialize the shift register.  
@@ -62,9 +71,17 @@ class SPIShiftRegisterOut : public ShiftRegisterOutBase<N> {
     void begin() override;
 
     /**
-     * @brief   Write the state buffer to the physical outputs.
+     * @brief   Write the state buffer to the physical outputs if it changed,
+     *          and continue sending the previous frame if the transport is
+     *          asynchronous.
      */
     void update() override;
+
+    /// Wait until all data has been sent.
+    void flush() { output.flush(); }
+
+  private:
+    AsyncSPIOutput<(N + 7) / 8> output;
 };
 
 END_AH_NAMESPACE
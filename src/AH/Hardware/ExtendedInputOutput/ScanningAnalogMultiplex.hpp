@@ -0,0 +1,232 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include "AnalogMultiplex.hpp"
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   An analog multiplexer that continuously scans all of its inputs in
+ *          the background, and keeps the latest value of each input in a
+ *          cache.
+ *
+ * Every call to @ref update reads one input, if the output of the multiplexer
+ * had enough time to settle, and selects the next input. The next input then
+ * settles while the rest of the program runs, so no time is wasted waiting.
+ * The inputs are scanned in Gray code order, so only a single address line
+ * changes at every step.
+ *
+ * The settle time only covers the external multiplexer. If other code uses
+ * the ADC between two steps (e.g. another multiplexer, a
+ * @ref FilteredAnalog, or an @ref ADCSampler), the first conversion still
+ * carries some of the voltage of the pin that was read last, because of the
+ * ADC's internal multiplexer and sample-and-hold capacitor. Therefore, like
+ * @ref AnalogMultiplex, the first reading of every input is discarded by
+ * default. If the ADC is not shared, this can be disabled to take a single
+ * conversion per input.
+ *
+ * @ref analogRead returns the cached value, without accessing the hardware.
+ * Use @ref getTimestamp to check how recent a value is.
+ *
+ * @note    The multiplexer stays enabled, and the address lines always select
+ *          the input that is being scanned, so the address lines cannot be
+ *          shared with other multiplexers.
+ * @note    The cache takes `6 * 2^N` bytes of RAM.
+ *
+ * @tparam  N
+ *          The number of address lines.
+ *
+ * @ingroup AH_ExtIO
+ */
+template <uint8_t N>
+class ScanningAnalogMultiplex : public AnalogMultiplex<N> {
+  public:
+    /// The number of inputs of the multiplexer.
+    constexpr static uint16_t Size = 1 << N;
+
+    /**
+     * @brief   Create a new ScanningAnalogMultiplex object on the given pins.
+     *
+     * @param   analogPin
+     *          The analog input pin connected to the output of the multiplexer.
+     * @param   addressPins
+     *          An array of the pins connected to the address lines of the
+     *          multiplexer. (Labeled S0, S1, S2 ... in the datasheet.)
+     * @param   enablePin
+     *          The digital output pin connected to the enable pin of the
+     *          multiplexer. (Labeled Ē in the datasheet.)
+     *          If you don't need the enable pin, you can use NO_PIN, which is
+     *          the default.
+     * @param   settleTime
+     *          The minimum time between selecting an input and reading it, in
+     *          microseconds.
+     * @param   discardFirstReading
+     *          Discard the first ADC conversion of every input. Can only be
+     *          disabled safely if no other code uses the ADC.
+     */
+    ScanningAnalogMultiplex(pin_t analogPin,
+                            const Array<pin_t, N> &addressPins,
+                            pin_t enablePin = NO_PIN,
+                            unsigned long settleTime = ANALOG_MUX_SETTLE_TIME,
+                            bool discardFirstReading = true)
+        : AnalogMultiplex<N>(analogPin, addressPins, enablePin),
+          settleTime(settleTime), discardFirstReading(discardFirstReading) {}
+
+    /**
+     * @brief   Initialize the multiplexer, enable it, and select the first
+     *          input of the scan.
+     */
+    void begin() override;
+
+    /**
+     * @brief   Read the selected input if it has settled, and select the next
+     *          one.
+     */
+    void update() override { step(); }
+
+    /**
+     * @brief   Read the selected input if it has settled, and select the next
+     *          one.
+     *
+     * @return  Whether an input was read.
+     */
+    bool step();
+
+    /// Read all inputs once, waiting for each of them to settle.
+    void scanAll();
+
+    /**
+     * @brief   Get the latest value of the given input from the cache.
+     *
+     * @param   pin
+     *          The multiplexer's pin number to read from.
+     */
+    analog_t analogRead(pin_t pin) override { return cache[pin]; }
+
+    /// Copy the latest values of a range of inputs from the cache.
+    void analogReadBuffer(pin_t pin, analog_t *values, pin_t count) override;
+
+    /**
+     * @brief   Read the digital state of the given input.
+     *
+     * The input is selected and read directly. Afterwards, the input that is
+     * being scanned is selected again, and it has to settle again.
+     *
+     * @param   pin
+     *          The multiplexer's pin number to read from.
+     */
+    int digitalRead(pin_t pin) override;
+
+    /// Read the digital states of a range of inputs.
+    /// @see    digitalRead
+    void digitalReadBuffer(pin_t pin, uint8_t *bits, pin_t count) override;
+
+    /// Get the time (@ref micros) at which the given input was last read, or
+    /// zero if it hasn't been read yet.
+    unsigned long getTimestamp(pin_t pin) const { return timestamps[pin]; }
+
+    /// Set the minimum time between selecting an input and reading it, in
+    /// microseconds.
+    void setSettleTime(unsigned long settleTime) {
+        this->settleTime = settleTime;
+    }
+    /// Get the minimum time between selecting an input and reading it, in
+    /// microseconds.
+    unsigned long getSettleTime() const { return settleTime; }
+
+    /// Discard the first ADC conversion of every input, or take a single
+    /// conversion per input.
+    void setDiscardFirstReading(bool discard) { discardFirstReading = discard; }
+    /// Check whether the first ADC conversion of every input is discarded.
+    bool getDiscardFirstReading() const { return discardFirstReading; }
+
+  private:
+    /// Convert a step of the scan to the address of the input.
+    static uint8_t toGray(uint8_t step) { return step ^ (step >> 1); }
+    /// Get the address of the input that is currently being scanned.
+    uint8_t getScanAddress() const { return toGray(scanStep); }
+
+  private:
+    analog_t cache[Size] = {};
+    unsigned long timestamps[Size] = {};
+    unsigned long selectTime = 0;
+    unsigned long settleTime;
+    bool discardFirstReading;
+    uint8_t scanStep = 0;
+};
+
+// -------------------------------------------------------------------------- //
+
+template <uint8_t N>
+void ScanningAnalogMultiplex<N>::begin() {
+    AnalogMultiplex<N>::begin();
+    scanStep = 0;
+    this->setMuxAddress(getScanAddress());
+    if (this->enablePin != NO_PIN)
+        ExtIO::digitalWrite(this->enablePin, this->MUX_ENABLED);
+    selectTime = micros();
+}
+
+template <uint8_t N>
+bool ScanningAnalogMultiplex<N>::step() {
+    unsigned long now = micros();
+    if (now - selectTime < settleTime)
+        return false;
+    uint8_t address = getScanAddress();
+    if (discardFirstReading)
+        ExtIO::analogRead(this->analogPin); // Discard first reading
+    cache[address] = ExtIO::analogRead(this->analogPin);
+    timestamps[address] = now;
+    scanStep = (scanStep + 1) & (Size - 1);
+    // Only one address line changes, the next input settles in the background
+    this->writeMuxAddress(getScanAddress(), address);
+    selectTime = micros();
+    return true;
+}
+
+template <uint8_t N>
+void ScanningAnalogMultiplex<N>::scanAll() {
+    for (uint16_t i = 0; i < Size; ++i)
+        while (!step())
+            ;
+}
+
+template <uint8_t N>
+void ScanningAnalogMultiplex<N>::analogReadBuffer(pin_t pin, analog_t *values,
+                                                  pin_t count) {
+    for (pin_t i = 0; i < count; ++i)
+        values[i] = cache[pin + i];
+}
+
+template <uint8_t N>
+int ScanningAnalogMultiplex<N>::digitalRead(pin_t pin) {
+    uint8_t bit = 0;
+    digitalReadBuffer(pin, &bit, 1);
+    return bit & 1;
+}
+
+template <uint8_t N>
+void ScanningAnalogMultiplex<N>::digitalReadBuffer(pin_t pin, uint8_t *bits,
+                                                   pin_t count) {
+    if (count == 0)
+        return;
+    uint8_t previous = getScanAddress();
+    for (pin_t i = 0; i < count; ++i) {
+        this->changeMuxAddress(pin + i, previous);
+        previous = pin + i;
+        uint8_t mask = 1 << (i % 8);
+        if (ExtIO::digitalRead(this->analogPin))
+            bits[i / 8] |= mask;
+        else
+            bits[i / 8] &= ~mask;
+    }
+    // Continue the scan where it left off
+    this->writeMuxAddress(getScanAddress(), previous);
+    selectTime = micros();
+}
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
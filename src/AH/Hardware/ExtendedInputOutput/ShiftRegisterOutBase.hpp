@@ -15,6 +15,16 @@ BEGIN_AH_NAMESPACE
  * @brief   A class for serial-in/parallel-out shift registers, 
  *          like the 74HC595.
  * 
+ * By default, every call to @ref digitalWrite that changes the state of an
+ * output immediately shifts out the entire chain of shift registers. To change
+ * many outputs at once, you can group the writes in a batch using
+ * @ref beginBatch and @ref commit (or a @ref Transaction object), so that the
+ * outputs are only written once when the batch is committed.  
+ * Alternatively, automatic updates can be disabled altogether using
+ * @ref setAutoUpdate, in which case the outputs are only written when
+ * @ref update (or @ref ExtendedIOElement::updateAll) is called, e.g. once per
+ * iteration of the main loop.
+ * 
  * @tparam  N
  *          The number of bits in total. Usually, shift registers (e.g. the
  *          74HC595) have eight bits per chip, so `length = 8 * k` where `k`
@@ -52,6 +62,9 @@ class ShiftRegisterOutBase : public StaticSizeExtendedIOElement<N> {
     /**
      * @brief   Set the state of a given output pin.
      * 
+     * The outputs are written immediately, unless a batch is in progress or
+     * automatic updates are disabled.
+     * 
      * @param   pin
      *          The shift register pin to set.
      * @param   val
@@ -72,6 +85,22 @@ class ShiftRegisterOutBase : public StaticSizeExtendedIOElement<N> {
      */
     int digitalRead(pin_t pin) override;
 
+    /**
+     * @brief   Set the states of a range of output pins, and write them to the
+     *          physical outputs with a single update.
+     *
+     * @copydetails ExtendedIOElement::digitalWriteBuffer
+     */
+    void digitalWriteBuffer(pin_t pin, const uint8_t *bits,
+                            pin_t count) override;
+
+    /**
+     * @brief   Get the current states of a range of output pins.
+     *
+     * @copydetails ExtendedIOElement::digitalReadBuffer
+     */
+    void digitalReadBuffer(pin_t pin, uint8_t *bits, pin_t count) override;
+
     /**
      * @brief   The analogRead function is deprecated because a shift
      *          is always digital.
@@ -101,6 +130,67 @@ class ShiftRegisterOutBase : public StaticSizeExtendedIOElement<N> {
         digitalWrite(pin, val >= 0x80 ? HIGH : LOW);
     }
 
+    /**
+     * @brief   Start a batch of writes: the outputs are no longer written after
+     *          each call to @ref digitalWrite, only when the batch is
+     *          committed.
+     * 
+     * Batches can be nested, the outputs are written when the outermost batch
+     * is committed.
+     */
+    void beginBatch() { ++batchDepth; }
+
+    /**
+     * @brief   Finish a batch that was started using @ref beginBatch. If this
+     *          was the outermost batch, and if any outputs were changed, the
+     *          new states are written to the physical outputs.
+     */
+    void commit();
+
+    /**
+     * @brief   Check whether a batch of writes is in progress.
+     */
+    bool isBatchInProgress() const { return batchDepth > 0; }
+
+    /**
+     * @brief   Enable or disable automatic updates.
+     * 
+     * @param   autoUpdate
+     *          If true (the default), writes outside of a batch are written to
+     *          the physical outputs immediately. If false, they are only written
+     *          by the next call to @ref update (or
+     *          @ref ExtendedIOElement::updateAll) or @ref commit.
+     */
+    void setAutoUpdate(bool autoUpdate) { this->autoUpdate = autoUpdate; }
+
+    /**
+     * @brief   Check whether automatic updates are enabled.
+     */
+    bool getAutoUpdate() const { return autoUpdate; }
+
+    /**
+     * @brief   Scope guard that starts a batch when it's created, and commits
+     *          it when it goes out of scope.
+     * 
+     * ```cpp
+     * {
+     *     ShiftRegisterOut<24>::Transaction transaction{sr};
+     *     for (pin_t pin = 0; pin < 24; ++pin)
+     *         sr.digitalWrite(pin, HIGH);
+     * } // All outputs are written at once here
+     * ```
+     */
+    class Transaction {
+      public:
+        Transaction(ShiftRegisterOutBase &sr) : sr(sr) { sr.beginBatch(); }
+        ~Transaction() { sr.commit(); }
+        Transaction(const Transaction &) = delete;
+        Transaction &operator=(const Transaction &) = delete;
+
+      private:
+        ShiftRegisterOutBase &sr;
+    };
+
     /**
      * @brief   Get the red output pin of the given LED.
      * 
@@ -146,6 +236,13 @@ class ShiftRegisterOutBase : public StaticSizeExtendedIOElement<N> {
 
     BitArray<N> buffer;
     bool dirty = true;
+
+  private:
+    /// Write the buffer to the outputs if no batch is in progress.
+    void updateIfNotDeferred();
+
+    uint8_t batchDepth = 0;
+    bool autoUpdate    = true;
 };
 
 END_AH_NAMESPACE
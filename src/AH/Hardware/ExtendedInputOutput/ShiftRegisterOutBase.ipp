@@ -11,9 +11,12 @@ ShiftRegisterOutBase<N>::ShiftRegisterOutBase(pin_t latchPin,
 
 template <uint8_t N>
 void ShiftRegisterOutBase<N>::digitalWrite(pin_t pin, PinStatus_t val) {
-    buffer.set(pin, val);
-    dirty = true;
-    this->update(); // TODO: should I always update?
+    bool state = val != LOW;
+    if (buffer.get(pin) != state) {
+        buffer.set(pin, state);
+        dirty = true;
+    }
+    updateIfNotDeferred();
 }
 
 template <uint8_t N>
@@ -21,6 +24,45 @@ int ShiftRegisterOutBase<N>::digitalRead(pin_t pin) {
     return buffer.get(pin);
 }
 
+template <uint8_t N>
+void ShiftRegisterOutBase<N>::digitalWriteBuffer(pin_t pin, const uint8_t *bits,
+                                                 pin_t count) {
+    for (pin_t i = 0; i < count; ++i) {
+        bool state = (bits[i / 8] >> (i % 8)) & 1;
+        if (buffer.get(pin + i) != state) {
+            buffer.set(pin + i, state);
+            dirty = true;
+        }
+    }
+    updateIfNotDeferred();
+}
+
+template <uint8_t N>
+void ShiftRegisterOutBase<N>::commit() {
+    if (batchDepth == 0)
+        return;
+    if (--batchDepth == 0)
+        this->update();
+}
+
+template <uint8_t N>
+void ShiftRegisterOutBase<N>::updateIfNotDeferred() {
+    if (autoUpdate && batchDepth == 0)
+        this->update();
+}
+
+template <uint8_t N>
+void ShiftRegisterOutBase<N>::digitalReadBuffer(pin_t pin, uint8_t *bits,
+                                                pin_t count) {
+    for (pin_t i = 0; i < count; ++i) {
+        uint8_t mask = 1 << (i % 8);
+        if (buffer.get(pin + i))
+            bits[i / 8] |= mask;
+        else
+            bits[i / 8] &= ~mask;
+    }
+}
+
 template <uint8_t N>
 pin_t ShiftRegisterOutBase<N>::green(pin_t id) {
     return this->pin(3 * id + ShiftRegisterOutRGB::greenBit);
@@ -5,6 +5,7 @@ AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
 #include <AH/Filters/EMA.hpp>
 #include <AH/Filters/Hysteresis.hpp>
+#include <AH/Hardware/ADCSampler.hpp>
 #include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
 #include <AH/Hardware/Hardware-Types.hpp>
 #include <AH/Math/IncreaseBitDepth.hpp>
@@ -106,13 +107,27 @@ class FilteredAnalog {
      * @retval  false
      *          The value is still the same.
      */
-    bool update() {
-        AnalogType input = getRawValue(); // read the raw analog input value
-        input = filter.filter(input);     // apply a low-pass EMA filter
-        if (mapFn)                        // If a mapping function is specified,
-            input = mapFn(input);         // apply it
-        return hysteresis.update(input);  // apply hysteresis, and return true
-        // if the value changed since last time
+    bool update() { return updateWith(getRawValue()); }
+
+    /**
+     * @brief   Update the average using the samples of the given channel that
+     *          were taken by the @ref ADCSampler since the last update, 
+     *          instead of reading the analog input.
+     *
+     * @param   channel
+     *          The channel that samples the analog input.
+     * @retval  true
+     *          The value changed since last time it was updated.
+     * @retval  false
+     *          The value is still the same, or there are no new samples.
+     */
+    bool update(ADCChannel &channel) {
+        analog_t sample;
+        if (!channel.read(sample))
+            return false;
+        return updateWith(
+            increaseBitDepth<ADC_BITS + IncRes, ADC_BITS, AnalogType,
+                             AnalogType>(sample));
     }
 
     /**
@@ -161,6 +176,16 @@ class FilteredAnalog {
     }
 
   private:
+    /// Filter and map the given raw value (with increased bit depth), and
+    /// apply hysteresis.
+    bool updateWith(AnalogType input) {
+        input = filter.filter(input);    // apply a low-pass EMA filter
+        if (mapFn)                       // If a mapping function is specified,
+            input = mapFn(input);        // apply it
+        return hysteresis.update(input); // apply hysteresis, and return true
+        // if the value changed since last time
+    }
+
     const pin_t analogPin;
 
     MappingFunction mapFn = nullptr;
@@ -6,6 +6,7 @@
 AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
 #include "Button.hpp"
+#include "InterruptButton.hpp"
 
 BEGIN_AH_NAMESPACE
 
@@ -17,9 +18,15 @@ BEGIN_AH_NAMESPACE
  * a certain threshold, it keeps on incrementing at a faster rate, until you
  * release it.
  * 
+ * @tparam  ButtonType
+ *          The type of the button to read from: @ref Button, or
+ *          @ref InterruptButton to be able to use pin change interrupts.
+ *          See @ref IncrementButton and @ref InterruptIncrementButton.
+ * 
  * @ingroup AH_HardwareUtils
  */
-class IncrementButton {
+template <class ButtonType>
+class GenericIncrementButton {
   public:
     /** 
      * @brief   Create a IncrementButton.
@@ -28,11 +35,16 @@ class IncrementButton {
      *          The button to read from.  
      *          The button is copied.
      */
-    IncrementButton(const Button &button) : button(button) {}
+    GenericIncrementButton(const ButtonType &button) : button(button) {}
 
     /// @see     Button::begin
     void begin() { button.begin(); }
 
+    /// @see    InterruptButton::enableInterrupts
+    bool enableInterrupts() { return button.enableInterrupts(); }
+    /// @see    InterruptButton::disableInterrupts
+    void disableInterrupts() { button.disableInterrupts(); }
+
     /**
      * @brief   An enumeration of the different actions to be performed by the
      *          counter.
@@ -64,7 +76,7 @@ class IncrementButton {
     State updateImplementation();
 
   private:
-    Button button;
+    ButtonType button;
 
     enum {
         Initial,
@@ -75,6 +87,14 @@ class IncrementButton {
     State state = Nothing;
 };
 
+/// An increment button that reads its pin on every update.
+using IncrementButton = GenericIncrementButton<Button>;
+/// An increment button that can capture the changes of its pin using a pin
+/// change interrupt (see @ref InterruptButton::enableInterrupts).
+using InterruptIncrementButton = GenericIncrementButton<InterruptButton>;
+
 END_AH_NAMESPACE
 
+#include "IncrementButton.ipp" // Template implementations
+
 AH_DIAGNOSTIC_POP()
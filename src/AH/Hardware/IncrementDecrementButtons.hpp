@@ -6,6 +6,7 @@
 AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
 #include "Button.hpp"
+#include "InterruptButton.hpp"
 
 BEGIN_AH_NAMESPACE
 
@@ -20,12 +21,19 @@ BEGIN_AH_NAMESPACE
  * If both the increment and the decrement button are pressed at once, it resets
  * the counter.
  * 
+ * @tparam  ButtonType
+ *          The type of the buttons to read from: @ref Button, or
+ *          @ref InterruptButton to be able to use pin change interrupts.
+ *          See @ref IncrementDecrementButtons and
+ *          @ref InterruptIncrementDecrementButtons.
+ * 
  * @ingroup AH_HardwareUtils
  */
-class IncrementDecrementButtons {
+template <class ButtonType>
+class GenericIncrementDecrementButtons {
   public:
     /** 
-     * @brief   Create a IncrementDecrementButtons object.
+     * @brief   Create a GenericIncrementDecrementButtons object.
      * 
      * @param   incrementButton
      *          The button to increment the counter.  
@@ -34,8 +42,8 @@ class IncrementDecrementButtons {
      *          The button to decrement the counter.  
      *          The button is copied.
      */
-    IncrementDecrementButtons(const Button &incrementButton,
-                              const Button &decrementButton)
+    GenericIncrementDecrementButtons(const ButtonType &incrementButton,
+                                     const ButtonType &decrementButton)
         : incrementButton(incrementButton), decrementButton(decrementButton) {}
 
     /// @see     Button::begin
@@ -44,6 +52,22 @@ class IncrementDecrementButtons {
         decrementButton.begin();
     }
 
+    /**
+     * @brief   Enable interrupts for both buttons.
+     * @return  Whether both buttons are now interrupt-driven.
+     * @see     InterruptButton::enableInterrupts
+     */
+    bool enableInterrupts() {
+        bool incr = incrementButton.enableInterrupts();
+        bool decr = decrementButton.enableInterrupts();
+        return incr && decr;
+    }
+    /// @see    InterruptButton::disableInterrupts
+    void disableInterrupts() {
+        incrementButton.disableInterrupts();
+        decrementButton.disableInterrupts();
+    }
+
     /**
      * @brief   An enumeration of the different actions to be performed by the
      *          counter.
@@ -81,8 +105,8 @@ class IncrementDecrementButtons {
     State updateImplementation();
 
   private:
-    Button incrementButton;
-    Button decrementButton;
+    ButtonType incrementButton;
+    ButtonType decrementButton;
 
     enum {
         Initial,
@@ -93,6 +117,15 @@ class IncrementDecrementButtons {
     State state = Nothing;
 };
 
+/// Increment and decrement buttons that read their pins on every update.
+using IncrementDecrementButtons = GenericIncrementDecrementButtons<Button>;
+/// Increment and decrement buttons that can capture the changes of their pins
+/// using pin change interrupts (see @ref InterruptButton::enableInterrupts).
+using InterruptIncrementDecrementButtons =
+    GenericIncrementDecrementButtons<InterruptButton>;
+
 END_AH_NAMESPACE
 
+#include "IncrementDecrementButtons.ipp" // Template implementations
+
 AH_DIAGNOSTIC_POP()
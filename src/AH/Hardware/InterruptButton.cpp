@@ -0,0 +1,57 @@
+#include "InterruptButton.hpp"
+
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+BEGIN_AH_NAMESPACE
+
+bool InterruptButton::enableInterrupts() {
+    if (isInterruptDriven())
+        return true;
+    eventSlot.reset(PinChangeEvents::attach(pin));
+    if (!isInterruptDriven())
+        return false;
+    // The pin may have changed since the last update
+    registerInput(ExtIO::digitalRead(pin) ^ invertState, millis());
+    return true;
+}
+
+void InterruptButton::disableInterrupts() { eventSlot.reset(); }
+
+Button::State InterruptButton::update() {
+    if (isInterruptDriven())
+        return updateFromEvents();
+    return Button::update();
+}
+
+Button::State InterruptButton::updateFromEvents() {
+    bool overflow = PinChangeEvents::checkOverflow(eventSlot.get());
+    PinChangeEvent event;
+    while (PinChangeEvents::pop(eventSlot.get(), event))
+        registerInput(event.state ^ invertState, event.time);
+    if (overflow) // Some changes were lost, read the actual state of the pin
+        registerInput(ExtIO::digitalRead(pin) ^ invertState, millis());
+
+    bool prevState = debouncedState & 0b01;
+    // The input didn't change, or it bounced back to the debounced state
+    if (prevInput == prevState) {
+        debouncedState = static_cast<State>((prevState << 1) | prevState);
+        return debouncedState;
+    }
+    // wait for state to stabilize
+    if (millis() - prevBounceTime > debounceTime)
+        debouncedState = static_cast<State>((prevState << 1) | prevInput);
+    else
+        debouncedState = static_cast<State>((prevState << 1) | prevState);
+    return debouncedState;
+}
+
+void InterruptButton::registerInput(bool input, unsigned long time) {
+    if (input != prevInput) { // Button is pressed, released or bounces
+        prevBounceTime = time;
+        prevInput = input;
+    }
+}
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Hardware/Button.hpp>
+#include <AH/Hardware/PinChangeEvents.hpp>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   A @ref Button that can capture the changes of its pin using a pin
+ *          change interrupt, instead of reading the pin on every update.
+ *
+ * Only buttons of this type use the slots of @ref PinChangeEvents, so
+ * sketches that only use normal @ref Button%s don't pay for the interrupt
+ * handlers and their queues.
+ *
+ * @note    @ref update is not virtual: an InterruptButton that is updated
+ *          through a reference to a @ref Button reads the pin instead of the
+ *          captured changes.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+class InterruptButton : public Button {
+  public:
+    /**
+     * @brief   Construct a new InterruptButton object.
+     *
+     * **This constructor should not be used.**
+     * It is just a way to easily create arrays of buttons, and initializing
+     * them later.
+     */
+    InterruptButton() = default;
+
+    /**
+     * @brief   Construct a new InterruptButton object.
+     *
+     * @param   pin
+     *          The digital pin to read from. The internal pull-up resistor
+     *          will be enabled when `begin` is called.
+     */
+    InterruptButton(pin_t pin) : Button(pin) {}
+
+    /**
+     * @brief   Capture the changes of the pin using a pin change interrupt,
+     *          instead of reading the pin on every call to @ref update.
+     *
+     * The interrupt handler stores the time and level of every change in a
+     * queue, and @ref update debounces them by comparing their timestamps.
+     * When the button is idle, @ref update only has to check whether the
+     * queue is empty: it doesn't read the pin, and it doesn't call `millis`.
+     *
+     * Should be called after @ref begin. The interrupt is detached when the
+     * button is destroyed. Only one button per pin can use an interrupt:
+     * copies of the button don't share its interrupt, and they read the pin
+     * on every update. Use @ref GenericIncrementButton::enableInterrupts to
+     * enable interrupts for the button of an @ref InterruptIncrementButton,
+     * for example.
+     *
+     * @retval  true
+     *          The interrupt was attached.
+     * @retval  false
+     *          The pin doesn't support interrupts, another button already
+     *          uses an interrupt for this pin, or there are no more free
+     *          slots (see #MAX_INTERRUPT_BUTTONS). The button keeps reading
+     *          the pin on every update.
+     *
+     * @see     PinChangeEvents
+     */
+    bool enableInterrupts();
+
+    /// Detach the interrupt, and go back to reading the pin on every update.
+    void disableInterrupts();
+
+    /// Check whether the button uses interrupts to capture changes.
+    /// @see    enableInterrupts
+    bool isInterruptDriven() const {
+        return eventSlot.get() != PinChangeEvents::NO_SLOT;
+    }
+
+    /**
+     * @brief   Debounce the changes captured by the interrupt handler, or read
+     *          the button if interrupts are not enabled, and return its new
+     *          state.
+     *
+     * @see     Button::update
+     */
+    State update();
+
+  private:
+    /// Debounce the changes captured by the interrupt handler.
+    State updateFromEvents();
+    /// Register a (possibly bouncing) change of the input.
+    void registerInput(bool input, unsigned long time);
+
+  private:
+    /**
+     * @brief   Owns a slot of @ref PinChangeEvents, and detaches it when it is
+     *          destroyed.
+     *
+     * Copies don't get a slot, moving transfers the slot.
+     */
+    class EventSlot {
+      public:
+        EventSlot() = default;
+        EventSlot(const EventSlot &) {}
+        EventSlot(EventSlot &&other) noexcept : slot(other.slot) {
+            other.slot = PinChangeEvents::NO_SLOT;
+        }
+        EventSlot &operator=(const EventSlot &) {
+            reset();
+            return *this;
+        }
+        EventSlot &operator=(EventSlot &&other) noexcept {
+            if (this != &other) {
+                reset(other.slot);
+                other.slot = PinChangeEvents::NO_SLOT;
+            }
+            return *this;
+        }
+        ~EventSlot() { reset(); }
+
+        /// Detach the current slot (if any), and take ownership of the given
+        /// slot.
+        void reset(PinChangeEvents::slot_t slot = PinChangeEvents::NO_SLOT) {
+            PinChangeEvents::detach(this->slot);
+            this->slot = slot;
+        }
+        PinChangeEvents::slot_t get() const { return slot; }
+
+      private:
+        PinChangeEvents::slot_t slot = PinChangeEvents::NO_SLOT;
+    };
+
+  private:
+    EventSlot eventSlot;
+};
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
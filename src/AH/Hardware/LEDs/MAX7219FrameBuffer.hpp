@@ -0,0 +1,220 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include "MAX7219_Base.hpp"
+#include <AH/Hardware/AsyncSPIOutput.hpp>
+
+BEGIN_AH_NAMESPACE
+
+/**
+ * @brief   A frame buffer for a chain of MAX7219 LED matrix drivers.
+ *
+ * The state of all LEDs is kept in RAM, and only the rows that changed since
+ * the previous call to @ref display are sent. Each row is sent to all
+ * modules in the chain at once, in a single packet, so updating a row of the
+ * entire display takes one chip select pulse instead of one per module.
+ *
+ * Module 0 is the module that's connected to the Arduino, module `M - 1` is
+ * the last module in the chain.
+ *
+ * @note    The back and front buffers of the @ref AsyncSPIOutput take
+ *          `2 * 16 * M` bytes of RAM, in addition to the `8 * M` bytes of the
+ *          frame buffer itself.
+ *
+ * @tparam  M
+ *          The number of daisy-chained modules.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+template <uint8_t M>
+class MAX7219FrameBuffer {
+  public:
+    /**
+     * @brief   Create a MAX7219FrameBuffer.
+     *
+     * @param   loadPin
+     *          The pin connected to the load pin (C̄S̄) of the modules.
+     * @param   transport
+     *          The transport used to send the data over the SPI bus.
+     */
+    MAX7219FrameBuffer(
+        pin_t loadPin,
+        SPITransport &transport = BlockingSPITransport::getInstance())
+        : loadPin(loadPin),
+          output(transport, loadPin, {SPI_MAX_SPEED, MSBFIRST, SPI_MODE0}) {}
+
+    /// The number of modules in the chain.
+    static constexpr uint8_t getNumberOfModules() { return M; }
+    /// The width of the display in pixels.
+    static constexpr uint16_t getWidth() { return 8 * M; }
+    /// The height of the display in pixels.
+    static constexpr uint8_t getHeight() { return 8; }
+
+    /// Initialize the Arduino pins, SPI, and all MAX7219 modules, and send the
+    /// contents of the frame buffer.
+    void begin();
+
+    /**
+     * @brief   Set the value of one row of one module.
+     *
+     * @param   module
+     *          The module in the chain [0, M-1].
+     * @param   row
+     *          The row [0, 7].
+     * @param   value
+     *          The new value of the row.
+     */
+    void setRow(uint8_t module, uint8_t row, uint8_t value) {
+        uint8_t &old = rows[module][row & 0x7];
+        if (old != value) {
+            old = value;
+            dirtyRows |= 1 << (row & 0x7);
+        }
+    }
+
+    /// Get the value of one row of one module.
+    uint8_t getRow(uint8_t module, uint8_t row) const {
+        return rows[module][row & 0x7];
+    }
+
+    /**
+     * @brief   Turn on or off a single LED.
+     *
+     * @param   x
+     *          The column [0, 8M-1]. Column 0 is the most significant bit of
+     *          the rows of module 0.
+     * @param   y
+     *          The row [0, 7].
+     * @param   state
+     *          The new state of the LED.
+     */
+    void setPixel(uint16_t x, uint8_t y, bool state) {
+        uint8_t module = x / 8;
+        uint8_t mask   = 0x80 >> (x % 8);
+        uint8_t value  = getRow(module, y);
+        setRow(module, y, state ? value | mask : value & ~mask);
+    }
+
+    /// Get the state of a single LED.
+    /// @see    setPixel
+    bool getPixel(uint16_t x, uint8_t y) const {
+        return getRow(x / 8, y) & (0x80 >> (x % 8));
+    }
+
+    /// Turn off all LEDs in the frame buffer.
+    void clear() {
+        for (uint8_t m = 0; m < M; ++m)
+            for (uint8_t r = 0; r < 8; ++r)
+                setRow(m, r, 0);
+    }
+
+    /// Check whether any rows changed since the last call to @ref display.
+    bool isDirty() const { return dirtyRows != 0; }
+
+    /// Mark all rows as changed, so they're sent by the next @ref display.
+    void invalidate() { dirtyRows = 0xFF; }
+
+    /**
+     * @brief   Send all rows that changed since the previous call to
+     *          @ref display.
+     *
+     * All dirty rows are sent in a single frame, one packet per row covering
+     * all modules in the chain. Rows that didn't change are skipped.
+     *
+     * @return  The number of rows that were sent.
+     */
+    uint8_t display();
+
+    /**
+     * @brief   Set the intensity of the LEDs of all modules.
+     *
+     * @param   intensity
+     *          The intensity [0, 15].
+     */
+    void setIntensity(uint8_t intensity) {
+        sendToAll(MAX7219_Base::INTENSITY, intensity & 0xF);
+    }
+
+    /**
+     * @brief   Continue sending the data in the background.
+     *
+     * @return  Whether there is still data that has to be sent.
+     */
+    bool poll() { return output.poll(); }
+
+    /// Wait until all data has been sent.
+    void flush() { output.flush(); }
+
+  private:
+    /// Send the same command to all modules, and wait for it to be sent.
+    void sendToAll(uint8_t opcode, uint8_t value);
+
+  private:
+    pin_t loadPin;
+    AsyncSPIOutput<8 * 2 * M> output;
+    uint8_t rows[M][8] = {};
+    /// The rows that changed since the previous call to display.
+    uint8_t dirtyRows = 0xFF;
+    /// The rows in the most recently enqueued frame.
+    uint8_t pendingRows = 0;
+};
+
+// -------------------------------------------------------------------------- //
+
+template <uint8_t M>
+void MAX7219FrameBuffer<M>::begin() {
+    ExtIO::digitalWrite(loadPin, HIGH);
+    ExtIO::pinMode(loadPin, OUTPUT);
+    output.begin();
+    sendToAll(MAX7219_Base::DISPLAYTEST, 0); // Normal operation, no test mode
+    sendToAll(MAX7219_Base::SCANLIMIT, 7);   // Scan all 8 digits
+    sendToAll(MAX7219_Base::DECODEMODE, 0);  // Raw LED addressing
+    sendToAll(MAX7219_Base::INTENSITY, 0xF); // Maximum intensity
+    invalidate();
+    display();
+    sendToAll(MAX7219_Base::SHUTDOWN, 1); // Enable the display
+}
+
+template <uint8_t M>
+uint8_t MAX7219FrameBuffer<M>::display() {
+    uint8_t frame[8 * 2 * M];
+    uint8_t *p      = frame;
+    uint8_t numRows = 0;
+    // The previous frame will be replaced if it hasn't been sent yet, so its
+    // rows have to be included in the new frame
+    if (output.hasPendingFrame())
+        dirtyRows |= pendingRows;
+    pendingRows = dirtyRows;
+    for (uint8_t r = 0; r < 8; ++r) {
+        if (!(dirtyRows & (1 << r)))
+            continue;
+        // The data for the last module in the chain is shifted out first
+        for (uint8_t m = M; m-- > 0;) {
+            *p++ = r + 1;
+            *p++ = rows[m][r];
+        }
+        ++numRows;
+    }
+    dirtyRows = 0;
+    if (numRows > 0)
+        output.enqueue(frame, 2 * M, numRows);
+    return numRows;
+}
+
+template <uint8_t M>
+void MAX7219FrameBuffer<M>::sendToAll(uint8_t opcode, uint8_t value) {
+    uint8_t packet[2 * M];
+    for (uint8_t m = 0; m < M; ++m) {
+        packet[2 * m + 0] = opcode;
+        packet[2 * m + 1] = value;
+    }
+    output.flush();
+    output.enqueue(packet, 2 * M, 1);
+    output.flush();
+}
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -5,18 +5,19 @@
 #include <AH/Settings/Warnings.hpp>
 AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
 
+#include <AH/Hardware/AsyncSPIOutput.hpp>
 #include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
 
-AH_DIAGNOSTIC_EXTERNAL_HEADER()
-#include <SPI.h>
-AH_DIAGNOSTIC_POP()
-
 BEGIN_AH_NAMESPACE
 
 /**
  * @brief   A base class for classes that control MAX7219 LED drivers.
  * 
- * The SPI interface is used.
+ * The SPI interface is used. All data is sent through an @ref AsyncSPIOutput,
+ * so the @ref SPITransport that is passed to the constructor determines
+ * whether @ref clear and @ref sendRows block until all data is sent, or
+ * whether they return immediately, in which case @ref poll has to be called
+ * regularly to finish the transfer.
  * 
  * @todo    Wiring diagram for SPI connection.
  */
@@ -27,8 +28,13 @@ class MAX7219_Base {
      * 
      * @param   loadPin
      *          The pin connected to the load pin (C̄S̄) of the MAX7219.
+     * @param   transport
+     *          The transport used to send the data over the SPI bus.
      */
-    MAX7219_Base(pin_t loadPin) : loadPin(loadPin) {}
+    MAX7219_Base(pin_t loadPin,
+                 SPITransport &transport = BlockingSPITransport::getInstance())
+        : loadPin(loadPin),
+          output(transport, loadPin, {SPI_MAX_SPEED, MSBFIRST, SPI_MODE0}) {}
 
     static constexpr uint8_t DECODEMODE = 9;
     static constexpr uint8_t INTENSITY = 10;
@@ -43,7 +49,7 @@ class MAX7219_Base {
     void init() {
         ExtIO::digitalWrite(loadPin, HIGH);
         ExtIO::pinMode(loadPin, OUTPUT);
-        SPI.begin();
+        output.begin();
         sendRaw(DISPLAYTEST, 0);        // Normal operation, no test mode
         sendRaw(SCANLIMIT, 7);          // Scan all 8 digits
         sendRaw(DECODEMODE, 0);         // Raw LED addressing
@@ -56,8 +62,28 @@ class MAX7219_Base {
      * @brief   Turn off all LEDs.
      */
     void clear() {
-        for (uint8_t j = 1; j < 8 + 1; j++)
-            sendRaw(j, 0);
+        const uint8_t rows[8] = {};
+        sendRows(rows);
+    }
+
+    /**
+     * @brief   Send the values of all eight digits or rows in a single frame.
+     * 
+     * This function doesn't wait for the data to be sent if the transport
+     * supports asynchronous transfers. If the previous frame is still being
+     * sent, the new frame is sent afterwards, replacing any older frame that
+     * was still waiting.
+     * 
+     * @param   rows
+     *          The values of rows 0 through 7.
+     */
+    void sendRows(const uint8_t (&rows)[8]) {
+        uint8_t frame[8 * 2];
+        for (uint8_t i = 0; i < 8; i++) {
+            frame[2 * i + 0] = i + 1;
+            frame[2 * i + 1] = rows[i];
+        }
+        output.enqueue(frame, 2, 8);
     }
 
     /**
@@ -81,12 +107,12 @@ class MAX7219_Base {
      *          The value to send.
      */
     void sendRaw(uint8_t opcode, uint8_t value) {
-        ExtIO::digitalWrite(loadPin, LOW);
-        SPI.beginTransaction(settings);
-        SPI.transfer(opcode);
-        SPI.transfer(value);
-        ExtIO::digitalWrite(loadPin, HIGH);
-        SPI.endTransaction();
+        // Commands have to be sent in order, so finish the pending frames
+        // first, and wait for this command to be sent as well
+        const uint8_t packet[] = {opcode, value};
+        output.flush();
+        output.enqueue(packet, 2, 1);
+        output.flush();
     }
 
     /**
@@ -99,9 +125,19 @@ class MAX7219_Base {
         sendRaw(INTENSITY, intensity & 0xF);
     }
 
+    /**
+     * @brief   Continue sending the data in the background.
+     * 
+     * @return  Whether there is still data that has to be sent.
+     */
+    bool poll() { return output.poll(); }
+
+    /// Wait until all data has been sent.
+    void flush() { output.flush(); }
+
   private:
     pin_t loadPin;
-    SPISettings settings = {SPI_MAX_SPEED, MSBFIRST, SPI_MODE0};
+    AsyncSPIOutput<8 * 2> output;
 };
 
 END_AH_NAMESPACE
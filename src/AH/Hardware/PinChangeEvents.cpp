@@ -0,0 +1,64 @@
+#include "PinChangeEvents.hpp"
+
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+BEGIN_AH_NAMESPACE
+
+PinChangeEvents::Slot PinChangeEvents::slots[MAX_INTERRUPT_BUTTONS];
+
+template <uint8_t I>
+void PinChangeEvents::handleInterrupt() {
+    Slot &slot = slots[I];
+    PinChangeEvent event = {millis(), ::digitalRead(slot.pin) != LOW};
+    if (!slot.queue.push(event))
+        slot.overflow = true;
+}
+
+template <uint8_t I>
+struct PinChangeEvents::HandlerTable {
+    static void (*get(uint8_t slot))() {
+        return slot == I ? &handleInterrupt<I> : HandlerTable<I - 1>::get(slot);
+    }
+};
+
+template <>
+struct PinChangeEvents::HandlerTable<0> {
+    static void (*get(uint8_t))() { return &handleInterrupt<0>; }
+};
+
+PinChangeEvents::slot_t PinChangeEvents::attach(pin_t pin) {
+    if (pin >= NUM_DIGITAL_PINS + NUM_ANALOG_INPUTS)
+        return NO_SLOT; // Extended IO pins don't support interrupts
+    int interrupt = digitalPinToInterrupt(pin);
+#ifdef NOT_AN_INTERRUPT
+    if (interrupt == NOT_AN_INTERRUPT)
+        return NO_SLOT;
+#endif
+    // A pin has at most one slot: attaching it again would replace the
+    // interrupt handler of the existing slot.
+    for (uint8_t i = 0; i < MAX_INTERRUPT_BUTTONS; ++i)
+        if (slots[i].pin == pin)
+            return NO_SLOT;
+    for (uint8_t i = 0; i < MAX_INTERRUPT_BUTTONS; ++i) {
+        if (slots[i].pin != NO_PIN)
+            continue;
+        slots[i].pin = pin;
+        slots[i].queue.clear();
+        slots[i].overflow = false;
+        attachInterrupt(interrupt, HandlerTable<MAX_INTERRUPT_BUTTONS - 1>::get(i),
+                        CHANGE);
+        return i;
+    }
+    return NO_SLOT;
+}
+
+void PinChangeEvents::detach(slot_t slot) {
+    if (slot == NO_SLOT)
+        return;
+    detachInterrupt(digitalPinToInterrupt(slots[slot].pin));
+    slots[slot].pin = NO_PIN;
+}
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <AH/Settings/Warnings.hpp>
+AH_DIAGNOSTIC_WERROR() // Enable errors on warnings
+
+#include <AH/Arduino-Wrapper.h> // attachInterrupt, digitalPinToInterrupt
+#include <AH/Containers/SPSCQueue.hpp>
+#include <AH/Hardware/Hardware-Types.hpp>
+#include <AH/Settings/SettingsWrapper.hpp>
+
+BEGIN_AH_NAMESPACE
+
+/// A change of the level of an input pin, captured by an interrupt handler.
+struct PinChangeEvent {
+    /// The time of the change (in milliseconds).
+    unsigned long time;
+    /// The new level of the pin.
+    bool state;
+};
+
+/**
+ * @brief   Captures pin changes using interrupts, so they can be processed
+ *          later by the main program.
+ *
+ * Every pin that is attached gets its own slot, with its own interrupt handler
+ * and its own lock-free queue of @ref PinChangeEvent%s. The interrupt handler
+ * only reads the level of the pin and the time, and adds them to the queue.
+ *
+ * Only Arduino pins that support interrupts (see `digitalPinToInterrupt`) can
+ * be used, not extended IO pins.
+ *
+ * The number of slots can be changed in Settings.hpp:
+ * #MAX_INTERRUPT_BUTTONS, the size of the queues: #BUTTON_EVENT_QUEUE_SIZE.
+ *
+ * @ingroup AH_HardwareUtils
+ */
+class PinChangeEvents {
+  public:
+    /// The type of the slot numbers.
+    using slot_t = int8_t;
+    /// The slot number used for pins that are not attached.
+    constexpr static slot_t NO_SLOT = -1;
+
+    /**
+     * @brief   Attach an interrupt handler that captures all changes of the
+     *          given pin.
+     *
+     * @param   pin
+     *          The Arduino pin to monitor.
+     * @return  The slot of the pin, or @ref NO_SLOT if the pin doesn't
+     *          support interrupts, if the pin already has a slot, or if all
+     *          slots are in use.
+     */
+    static slot_t attach(pin_t pin);
+
+    /// Detach the interrupt handler of the given slot, and free the slot.
+    static void detach(slot_t slot);
+
+    /**
+     * @brief   Get the oldest change of the pin of the given slot.
+     *
+     * @retval  true
+     *          The oldest change was removed from the queue and stored in
+     *          @p event.
+     * @retval  false
+     *          There are no changes.
+     */
+    static bool pop(slot_t slot, PinChangeEvent &event) {
+        return slots[slot].queue.pop(event);
+    }
+
+    /// Check whether there are changes in the queue of the given slot.
+    static bool available(slot_t slot) { return !slots[slot].queue.empty(); }
+
+    /**
+     * @brief   Check whether changes of the pin of the given slot were lost
+     *          because its queue was full, and clear the flag.
+     */
+    static bool checkOverflow(slot_t slot) {
+        bool overflow = slots[slot].overflow;
+        if (overflow)
+            slots[slot].overflow = false;
+        return overflow;
+    }
+
+  private:
+    struct Slot {
+        pin_t pin = NO_PIN;
+        SPSCQueue<PinChangeEvent, BUTTON_EVENT_QUEUE_SIZE> queue;
+        volatile bool overflow = false;
+    };
+    static Slot slots[MAX_INTERRUPT_BUTTONS];
+
+    /// The interrupt handler of the given slot.
+    template <uint8_t I>
+    static void handleInterrupt();
+    /// Get the interrupt handler of the given slot.
+    template <uint8_t I>
+    struct HandlerTable;
+};
+
+END_AH_NAMESPACE
+
+AH_DIAGNOSTIC_POP()
@@ -79,11 +79,33 @@ constexpr unsigned long LONG_PRESS_DELAY = 450; // milliseconds
 /// The time between increments/decremnets during a long press.
 constexpr unsigned long LONG_PRESS_REPEAT_DELAY = 200; // milliseconds
 
+/// The maximum number of buttons that can use pin change interrupts at the
+/// same time. Only sketches that use @ref InterruptButton%s allocate these
+/// slots, every slot uses the RAM of a queue of #BUTTON_EVENT_QUEUE_SIZE
+/// changes.
+/// @see    InterruptButton::enableInterrupts
+constexpr uint8_t MAX_INTERRUPT_BUTTONS = 4;
+
+/// The number of pin changes that can be queued for each interrupt-driven
+/// button. Must be a power of two.
+constexpr uint8_t BUTTON_EVENT_QUEUE_SIZE = 8;
+
 /// The interval between updating filtered analog inputs, in microseconds.
 constexpr unsigned long FILTERED_INPUT_UPDATE_INTERVAL = 1000; // microseconds
 
+/// The time it takes for the output of an analog multiplexer to settle after
+/// selecting a different input, in microseconds.
+/// @see    AnalogMultiplex, ScanningAnalogMultiplex
+constexpr unsigned long ANALOG_MUX_SETTLE_TIME = 5; // microseconds
+
 constexpr static Frequency SPI_MAX_SPEED = 8_MHz;
 
+/// The maximum number of extended IO elements in the table that is used to
+/// look up the element of an extended IO pin. If there are more elements, the
+/// slower linear search is used instead.
+/// Every entry uses the size of a pointer in RAM.
+constexpr uint8_t EXTIO_DISPATCH_TABLE_SIZE = 16;
+
 /// Make it possible to invert individual push buttons.
 /// Enabling this will increase memory usage.
 #define AH_INDIVIDUAL_BUTTON_INVERT
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t
+
+/// @addtogroup COBS
+/// @{
+
+/// COBS special character codes and limits.
+namespace COBS_Constants {
+const static uint8_t DELIMITER = 0x00; ///< indicates end of packet
+/// The maximum number of data bytes that follow a single code byte.
+const static uint8_t MAX_BLOCK_LENGTH = 254;
+} // namespace COBS_Constants
+
+/**
+ * @brief   Get an upper bound on the number of bytes sent for a packet of the
+ *          given size, including the two delimiters, but excluding any
+ *          checksum.
+ * 
+ * COBS adds at most one byte per 254 bytes of data (plus one), independent of
+ * the contents of the packet.
+ */
+constexpr size_t COBS_maxFrameLength(size_t len) {
+    return len + len / COBS_Constants::MAX_BLOCK_LENGTH + 1 + 2;
+}
+
+/// @}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <AH/STL/cstddef> // std::nullptr, size_t
+#include <AH/STL/utility> // std::forward
+#include <stddef.h>       // size_t
+
+#include <COBSStream/COBS.hpp>
+
+#include <boost/integer.hpp>
+
+/// @addtogroup COBS
+/// @{
+
+/**
+ * @brief   Class for parsing COBS packets.
+ *
+ * Has the same interface as @ref SLIPParser.
+ */
+class COBSParser {
+  public:
+    /**
+     * @brief   Constructor.
+     *
+     * @param   buffer
+     *          The byte buffer to store the parsed packets.
+     */
+    template <size_t N>
+    COBSParser(uint8_t (&buffer)[N]) : COBSParser(buffer, N) {}
+
+    /**
+     * @brief   Default constructor for a parser without a buffer.
+     */
+    COBSParser() : COBSParser(nullptr) {}
+
+    /**
+     * @brief   Constructor for a parser without a buffer.
+     */
+    COBSParser(std::nullptr_t) : COBSParser(nullptr, 0) {}
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   buffer
+     *          The byte buffer to store the parsed packets.
+     * @param   bufferSize
+     *          The size of the buffer.
+     */
+    COBSParser(uint8_t *buffer, size_t bufferSize)
+        : buffer(buffer), bufferSize(bufferSize) {
+        reset();
+    }
+
+    /**
+     * @brief   Parse the given byte, and call the callback for each data byte.
+     *
+     * @tparam  Callback
+     *          The type of callback function. Should be a callable object that
+     *          takes a data byte and the index of that byte in the packet:
+     *          `void callback(uint8_t databyte, size_t index)`
+     *
+     * @param   c
+     *          The byte to parse.
+     * @param   callback
+     *          The callback function to call for each data byte.
+     * @retval  0
+     *          The packet is not finished yet, or the packet ended in the
+     *          middle of a block, which means that bytes were lost, and the
+     *          packet was dropped.
+     * @retval >0
+     *          The packet was received in its entirety, and the return value is
+     *          the size of the packet in the buffer.
+     *          If the packet is not larger than the buffer, this will be the
+     *          same as the size of the packet. If the packet was larger than
+     *          the buffer, the return value will be the size of the buffer, and
+     *          @ref wasTruncated will return true.
+     */
+    template <class Callback>
+    size_t parse(uint8_t c, Callback callback);
+
+    /**
+     * @brief   Parse the given byte without using a callback function.
+     *
+     * @param   c
+     *          The byte to parse.
+     * @retval  0
+     *          The packet is not finished yet.
+     * @retval >0
+     *          The packet was received in its entirety, and the return value is
+     *          the size of the packet in the buffer, see @ref parse.
+     */
+    size_t parse(uint8_t c) {
+        auto cb = [](uint8_t, size_t) {};
+        return parse(c, cb);
+    }
+
+    /**
+     * @brief   Check if the previous packet was truncated.
+     *
+     * @retval  true
+     *          The previous packet didn't fit the buffer. The size returned by
+     *          @ref COBSParser::parse was smaller than the actual size of the
+     *          packet.
+     * @retval  false
+     *          The buffer was large enough to store the previous packet.
+     */
+    bool wasTruncated() const { return truncated > 0; }
+
+    /**
+     * @brief   Get the number of bytes that were truncated due to the previous
+     *          packet being too large for the buffer.
+     */
+    size_t numTruncated() const { return truncated; }
+
+  private:
+    void reset() {
+        write       = buffer;
+        remaining   = 0;
+        pendingZero = false;
+    }
+
+    /// Store a decoded data byte in the buffer.
+    template <class Callback>
+    void store(uint8_t c, Callback &callback);
+
+  private:
+    uint8_t *buffer   = nullptr;
+    uint8_t *write    = nullptr;
+    size_t bufferSize = 0;
+    size_t truncated  = 0;
+    /// The number of data bytes left in the current block.
+    uint8_t remaining = 0;
+    /// Whether a zero byte has to be stored before the next block.
+    bool pendingZero = false;
+};
+
+/// @}
+
+/// @addtogroup CRC
+/// @{
+
+/**
+ * @brief   Class for parsing COBS packets with a CRC checksum to check the
+ *          integrity of the packets.
+ *
+ * @tparam  CRC
+ *          The CRC type to use.
+ */
+template <class CRC>
+class COBSParserCRC {
+  public:
+    COBSParserCRC(const COBSParser &parser) : parser(parser) {}
+    COBSParserCRC(const COBSParser &parser, CRC &&crc)
+        : parser(parser), crc(std::forward<CRC>(crc)) {}
+
+    /// The integer type of the checksum.
+    using checksum_t = typename boost::uint_t<CRC::bit_count>::least;
+
+    /**
+     * @brief   Parse the given byte.
+     *
+     * @param   c
+     *          The byte to parse.
+     *
+     * @retval  0
+     *          The packet is not finished yet.
+     * @retval >0
+     *          The packet was received in its entirety, and the return value is
+     *          the size of the packet in the buffer.
+     *          If the packet is not larger than the buffer, this will be the
+     *          same as the size of the packet. If the packet was larger than
+     *          the buffer, the return value will be the size of the buffer, and
+     *          @ref wasTruncated will return true.
+     */
+    size_t parse(uint8_t c) {
+        // callback that resets the CRC when necessary, and that feeds the
+        // parsed byte to the CRC
+        auto cb = [this](uint8_t c, size_t index) {
+            if (index == 0)
+                crc.reset();
+            crc(c);
+        };
+        // use the standard COBSParser
+        size_t size = parser.parse(c, cb);
+
+        // Correct the size of the packet for the size of the checksum
+        if (size <= sizeof(checksum_t))
+            return 0;
+        if (parser.numTruncated() < sizeof(checksum_t))
+            return size + parser.numTruncated() - sizeof(checksum_t);
+        return size;
+    }
+
+    /// @copydoc    COBSParser::wasTruncated
+    bool wasTruncated() const { return numTruncated() > 0; }
+
+    /// @copydoc    COBSParser::numTruncated
+    size_t numTruncated() const {
+        return parser.numTruncated() < sizeof(checksum_t)
+                   ? 0
+                   : parser.numTruncated() - sizeof(checksum_t);
+    }
+    /**
+     * @brief   Get the checksum of the previous packet. A checksum of zero
+     *          indicates that the packet was received correctly.
+     */
+    checksum_t checksum() const { return crc.checksum(); }
+
+  private:
+    COBSParser parser;
+    CRC crc;
+};
+
+/// @}
+
+#include "COBSParser.ipp"
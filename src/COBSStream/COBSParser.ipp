@@ -0,0 +1,60 @@
+#include "COBSParser.hpp"
+
+template <class Callback>
+void COBSParser::store(uint8_t c, Callback &callback) {
+    auto writeSize = reinterpret_cast<uintptr_t>(write) -
+                     reinterpret_cast<uintptr_t>(buffer);
+    callback(c, writeSize + truncated);
+    if (writeSize == 0) // first byte of packet
+        truncated = 0;
+    if (writeSize < bufferSize) {
+        *write++ = c;
+    } else {
+        truncated++;
+    }
+}
+
+template <class Callback>
+size_t COBSParser::parse(uint8_t c, Callback callback) {
+    using namespace COBS_Constants;
+    /*
+     * if it's a delimiter then we're done with the packet
+     */
+    if (c == DELIMITER) {
+        auto packetLen = write - buffer;
+        /*
+         * if the packet ended in the middle of a block, some bytes were lost,
+         * so the packet is dropped
+         */
+        bool complete = remaining == 0;
+        reset();
+        /*
+         * empty packets are ignored, like the duplicate END characters in SLIP
+         */
+        if (complete && packetLen)
+            return packetLen;
+    }
+    /*
+     * if we're not in a block, this is a code byte that contains the length of
+     * the next block
+     */
+    else if (remaining == 0) {
+        /*
+         * every block except full blocks is followed by an implicit zero, but
+         * not at the end of the packet, so it's only stored when a new block
+         * starts
+         */
+        if (pendingZero)
+            store(0x00, callback);
+        pendingZero = c != MAX_BLOCK_LENGTH + 1;
+        remaining   = c - 1;
+    }
+    /*
+     * otherwise, it's a data byte that we just store
+     */
+    else {
+        store(c, callback);
+        --remaining;
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <AH/STL/algorithm> // std::reverse
+#include <AH/STL/utility>   // std::forward
+#include <stddef.h>         // size_t
+#include <string.h>         // memcpy
+
+#include <boost/integer.hpp> // boost::uint_t
+
+#include <COBSStream/COBS.hpp>
+
+/// @addtogroup COBS
+/// @{
+
+/**
+ * @brief   Class for sending COBS packets.
+ *
+ * Every block of up to 254 non-zero data bytes is preceded by a code byte, so
+ * the sender has to buffer one block before it can be sent. This requires
+ * 254 bytes of RAM.
+ *
+ * @tparam  Sender
+ *          The functor that actually sends a byte over the transmission
+ *          channel. Takes a single byte as an argument and returns the number
+ *          of bytes written (similar to `Serial.write(uint8_t)`):
+ *          `size_t sender(uint8_t byte)`
+ */
+template <class Sender>
+class COBSSender {
+  public:
+    /**
+     * @brief   Default constructor.
+     */
+    COBSSender() = default;
+    /**
+     * @brief   Constructor with sender initialization.
+     *
+     * @param   sender
+     *          Initialization for the sender. Perfect forwarding is used.
+     */
+    COBSSender(Sender &&sender) : sender(std::forward<Sender>(sender)) {}
+
+    /**
+     * @brief   Start a packet.
+     *
+     * Discards any unfinished packet, and sends a
+     * @ref COBS_Constants::DELIMITER "DELIMITER" to flush the buffer of the
+     * receiver.
+     *
+     * @return  The number of bytes sent by the Sender.
+     */
+    size_t beginPacket() {
+        blockLength   = 0;
+        lastBlockFull = false;
+        return sender(COBS_Constants::DELIMITER);
+    }
+    /**
+     * @brief   Finish the packet.
+     *
+     * Sends the last block of the packet, followed by a
+     * @ref COBS_Constants::DELIMITER "DELIMITER".
+     *
+     * @return  The number of bytes sent by the Sender.
+     */
+    size_t endPacket();
+
+    /**
+     * @brief   Write some data as the body of a packet.
+     *
+     * The data is encoded by COBS before sending, so arbitrary binary data can
+     * be sent. Data is sent in blocks, so some of it may only be sent by later
+     * calls to write or by @ref endPacket.
+     *
+     * @param   data
+     *          A pointer to the data to send.
+     * @param   len
+     *          The number of bytes to send.
+     * @return  The number of bytes sent by the Sender.
+     */
+    size_t write(const uint8_t *data, size_t len);
+
+  private:
+    /// Send the code byte and the data of the current block.
+    size_t flush(uint8_t code);
+
+  private:
+    Sender sender;
+    uint8_t block[COBS_Constants::MAX_BLOCK_LENGTH];
+    uint8_t blockLength = 0;
+    /// Whether the previous block was a full block without a zero byte.
+    bool lastBlockFull = false;
+};
+
+/// @}
+
+/// @addtogroup CRC
+/// @{
+
+/**
+ * @brief   Class for sending COBS packets with a CRC checksum to check the
+ *          integrity of the packets.
+ *
+ * @tparam  Sender
+ *          The functor that actually sends a byte over the transmission
+ *          channel. Takes a single byte as an argument and returns the number
+ *          of bytes written (similar to `Serial.write(uint8_t)`):
+ *          `size_t sender(uint8_t byte)`
+ * @tparam  CRC
+ *          The CRC type to use.
+ */
+template <class Sender, class CRC>
+class COBSSenderCRC {
+  public:
+    /**
+     * @brief   Default constructor.
+     */
+    COBSSenderCRC() = default;
+    /**
+     * @brief   Constructor with sender initialization.
+     *
+     * @param   sender
+     *          Initialization for the sender. Perfect forwarding is used.
+     *          The CRC is default-initialized.
+     */
+    COBSSenderCRC(Sender &&sender) : sender(std::forward<Sender>(sender)) {}
+    /**
+     * @brief   Constructor with CRC initialization.
+     *
+     * @param   crc
+     *          Initialization for the CRC. Perfect forwarding is used.
+     *          The sender is default-initialized.
+     */
+    COBSSenderCRC(CRC &&crc) : crc(std::forward<CRC>(crc)) {}
+    /**
+     * @brief   Constructor with sender and CRC initialization.
+     *
+     * @param   sender
+     *          Initialization for the sender. Perfect forwarding is used.
+     * @param   crc
+     *          Initialization for the CRC. Perfect forwarding is used.
+     */
+    COBSSenderCRC(Sender &&sender, CRC &&crc)
+        : sender(std::forward<Sender>(sender)), crc(std::forward<CRC>(crc)) {}
+
+    /// The integer type of the checksum.
+    using checksum_t = typename boost::uint_t<CRC::bit_count>::least;
+
+    /// @copydoc    COBSSender::beginPacket()
+    size_t beginPacket() {
+        this->crc.reset();
+        return sender.beginPacket();
+    }
+
+    /**
+     * @brief   Finish the packet.
+     *
+     * Encodes and sends the checksum of all data sent using the @ref write
+     * function, followed by the last block and a COBS
+     * @ref COBS_Constants::DELIMITER "DELIMITER".
+     *
+     * @return  The number of bytes sent by the Sender.
+     */
+    size_t endPacket() {
+        constexpr size_t numChars = sizeof(checksum_t);
+        uint8_t buffer[numChars];
+        const checksum_t checksum = this->crc.checksum();
+        memcpy(buffer, &checksum, numChars);
+        std::reverse(std::begin(buffer), std::end(buffer));
+        return sender.write(buffer, numChars) + sender.endPacket();
+    }
+
+    /// @copydoc    COBSSender::write()
+    size_t write(const uint8_t *data, size_t len);
+
+  private:
+    COBSSender<Sender> sender;
+    CRC crc;
+};
+
+/// @}
+
+#include "COBSSender.ipp"
@@ -0,0 +1,61 @@
+#include "COBSSender.hpp"
+
+template <class Sender>
+size_t COBSSender<Sender>::flush(uint8_t code) {
+    size_t sent = this->sender(code);
+    for (uint8_t i = 0; i < blockLength; ++i)
+        sent += this->sender(block[i]);
+    blockLength = 0;
+    return sent;
+}
+
+template <class Sender>
+size_t COBSSender<Sender>::write(const uint8_t *data, size_t len) {
+    using namespace COBS_Constants;
+
+    size_t sent = 0;
+
+    while (len--) {
+        if (*data == DELIMITER) {
+            /*
+             * a zero byte ends the current block, the code byte is the
+             * distance to the zero byte
+             */
+            sent += flush(blockLength + 1);
+            lastBlockFull = false;
+        } else {
+            block[blockLength++] = *data;
+            /*
+             * if the block is full, send it with a special code, which means
+             * that it's not followed by a zero byte
+             */
+            if (blockLength == MAX_BLOCK_LENGTH) {
+                sent += flush(MAX_BLOCK_LENGTH + 1);
+                lastBlockFull = true;
+            }
+        }
+
+        data++;
+    }
+
+    return sent;
+}
+
+template <class Sender>
+size_t COBSSender<Sender>::endPacket() {
+    size_t sent = 0;
+    /*
+     * the last block is always sent, unless the packet ends right after a full
+     * block (which isn't followed by an implicit zero)
+     */
+    if (blockLength > 0 || !lastBlockFull)
+        sent += flush(blockLength + 1);
+    lastBlockFull = false;
+    return sent + this->sender(COBS_Constants::DELIMITER);
+}
+
+template <class Sender, class CRC>
+size_t COBSSenderCRC<Sender, CRC>::write(const uint8_t *data, size_t len) {
+    this->crc.process_bytes(data, len);
+    return sender.write(data, len);
+}
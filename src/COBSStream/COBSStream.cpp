@@ -0,0 +1,26 @@
+#include "COBSStream.hpp"
+
+size_t COBSStream::writePacket(const uint8_t *data, size_t len) {
+    size_t sent = 0;
+    sent += beginPacket();
+    sent += write(data, len);
+    sent += endPacket();
+    return sent;
+}
+
+size_t COBSStream::write(const uint8_t *data, size_t len) {
+    return sender.write(data, len);
+}
+
+size_t COBSStream::beginPacket() { return sender.beginPacket(); }
+
+size_t COBSStream::endPacket() { return sender.endPacket(); }
+
+size_t COBSStream::readPacket() {
+    while (stream->available()) {
+        size_t packetSize = parser.parse(stream->read());
+        if (packetSize > 0)
+            return packetSize;
+    }
+    return 0;
+}
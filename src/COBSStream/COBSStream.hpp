@@ -0,0 +1,141 @@
+#pragma once
+
+#include <COBSStream/COBSParser.hpp>
+#include <COBSStream/COBSSender.hpp>
+#include <Stream.h>
+
+/// @addtogroup COBS
+/// @{
+
+/**
+ * @brief   Class that implements COBS, a packet framing protocol with a 
+ *          bounded overhead.
+ * 
+ * Has the same interface as @ref SLIPStream.
+ */
+class COBSStream {
+  public:
+    /// Functor that sends bytes over an Arduino Stream.
+    struct StreamSender {
+        StreamSender() = default;
+        StreamSender(Stream &stream) : stream(&stream) {}
+        StreamSender(Stream *stream) : stream(stream) {}
+        size_t operator()(uint8_t c) const { return stream->write(c); }
+        Stream *stream = nullptr;
+    };
+
+  public:
+    COBSStream(Stream &stream, const COBSParser &parser)
+        : stream(&stream), sender(stream), parser(parser) {}
+    COBSStream(Stream &stream)
+        : stream(&stream), sender(stream), parser(nullptr, 0) {}
+
+    /**
+     * @brief   Sends a packet.
+     * 
+     * @param   data
+     *          A pointer to the start of the data.
+     * @param   len
+     *          The length of the data.
+     * @return  The number of bytes transmitted over the Stream. If no write 
+     *          errors occur, this number will be larger than @p len, because
+     *          of the delimiters and code bytes, but it will not be larger 
+     *          than @ref COBS_maxFrameLength(len).
+     */
+    size_t writePacket(const uint8_t *data, size_t len);
+
+    /// @copydoc    COBSSender::beginPacket
+    size_t beginPacket();
+    /// @copydoc    COBSSender::write
+    size_t write(const uint8_t *data, size_t len);
+    /// @copydoc    COBSSender::endPacket
+    size_t endPacket();
+
+    /**
+     * @brief   Receives a packet into the read buffer.
+     * 
+     * If more than len bytes are received, the packet will be truncated.
+     * 
+     * @return  The number of bytes stored in the buffer.
+     */
+    size_t readPacket();
+
+    /// @copydoc    COBSParser::wasTruncated
+    bool wasTruncated() const { return parser.wasTruncated(); }
+
+    /// @copydoc    COBSParser::numTruncated
+    size_t numTruncated() const { return parser.numTruncated(); }
+
+  private:
+    Stream *stream;
+    COBSSender<StreamSender> sender;
+    COBSParser parser;
+};
+
+/// @}
+
+/// @addtogroup CRC
+/// @{
+
+/**
+ * @brief   Class that implements COBS, a packet framing protocol with a 
+ *          bounded overhead, and that uses cyclic redundancy checks (CRCs) on
+ *          transmitted and received packets.
+ * 
+ * Has the same interface as @ref SLIPStreamCRC.
+ * 
+ * @see [**Boost::CRC**](https://www.boost.org/doc/libs/1_72_0/doc/html/crc.html)
+ */
+template <class CRC>
+class COBSStreamCRC {
+  public:
+    using StreamSender = COBSStream::StreamSender;
+
+    COBSStreamCRC(Stream &stream, CRC &&senderCRC, const COBSParser &parser,
+                  CRC &&parserCRC)
+        : stream(&stream), sender(stream, std::forward<CRC>(senderCRC)),
+          parser(parser, std::forward<CRC>(parserCRC)) {}
+
+    /**
+     * @brief   Sends a packet.
+     * 
+     * @param   data
+     *          A pointer to the start of the data.
+     * @param   len
+     *          The length of the data.
+     * @return  The number of bytes transmitted over the Stream. If no write 
+     *          errors occur, this number will be larger than @p len, because
+     *          of the delimiters, checksums and code bytes.
+     */
+    size_t writePacket(const uint8_t *data, size_t len);
+
+    /// @copydoc    COBSSenderCRC::beginPacket
+    size_t beginPacket();
+    /// @copydoc    COBSSenderCRC::write
+    size_t write(const uint8_t *data, size_t len);
+    /// @copydoc    COBSSenderCRC::endPacket
+    size_t endPacket();
+
+    /// @copydoc    COBSStream::readPacket
+    size_t readPacket();
+
+    /// @copydoc    COBSParserCRC::wasTruncated
+    bool wasTruncated() const { return parser.wasTruncated(); }
+    /// @copydoc    COBSParserCRC::numTruncated
+    size_t numTruncated() const { return parser.numTruncated(); }
+
+    /// @copydoc    COBSParserCRC::checksum_t
+    using checksum_t = typename COBSParserCRC<CRC>::checksum_t;
+
+    /// @copydoc    COBSParserCRC::checksum
+    checksum_t checksum() const { return parser.checksum(); }
+
+  private:
+    Stream *stream;
+    COBSSenderCRC<StreamSender, CRC> sender;
+    COBSParserCRC<CRC> parser;
+};
+
+/// @}
+
+#include "COBSStream.ipp"
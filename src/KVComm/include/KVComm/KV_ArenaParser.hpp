@@ -0,0 +1,170 @@
+#pragma once
+
+#if !defined(ARDUINO) || defined(DOXYGEN)
+
+#include <KVComm/KV_Iterator.hpp> // KV_Iterator
+#include <KVComm/KV_KeyTable.hpp> // KV_KeyTable
+#include <KVComm/KV_Result.hpp>   // KV_Result, KV_Errc
+
+#include <cstddef>   // size_t
+#include <cstdint>   // uint8_t
+#include <stdexcept> // std::out_of_range
+#include <utility>   // std::pair
+#include <vector>    // std::vector
+
+/// @addtogroup KVComm
+/// @{
+
+/**
+ * @file
+ * @brief   A parser for dictionaries generated by the @ref KV_Builder that
+ *          reuses its storage between frames.
+ */
+
+/**
+ * @brief   A parser for dictionaries generated by the @ref KV_Builder that
+ *          reuses its storage between frames.
+ *
+ * Has the same interface as @ref KV_Parser, but instead of building a new
+ * `std::map` for every dictionary, the entries are stored in a flat array that
+ * is sorted by key. Calling @ref reparse clears this array without releasing
+ * its memory, so once the parser has seen the largest dictionary it has to
+ * handle (or after calling @ref reserve), parsing new frames doesn't allocate
+ * any memory.
+ *
+ * Intended to run on your computer, not on the Arduino.
+ */
+class KV_ArenaParser {
+  public:
+    using KV = KV_Iterator::KV;
+    /// A key-value entry. Has the same layout as the value type of
+    /// @ref KV_Parser's map, so `entry.first` is the key and `entry.second` is
+    /// the KV element.
+    using entry_t = std::pair<const char *, KV>;
+    using const_iterator = std::vector<entry_t>::const_iterator;
+
+    /// Create an empty parser.
+    KV_ArenaParser() = default;
+
+    /**
+     * @brief   Parse a raw buffer into a new KV_ArenaParser.
+     *
+     * @param   buffer
+     *          A pointer to the raw buffer containing the dictionary, as
+     *          generated by a @ref KV_Builder.
+     *          Only the pointer is saved, no copy is made of the actual buffer,
+     *          so the lifetime of the buffer must be longer than the parser and
+     *          the accessors.
+     * @param   length
+     *          The length of the dictionary in the buffer (in bytes).
+     * @param   mode
+     *          Use @ref KV_Iterator::Checked for untrusted input.
+     * @param   keys
+     *          Optional key table, see @ref KV_Parser::KV_Parser.
+     */
+    KV_ArenaParser(const uint8_t *buffer, size_t length,
+                   KV_Iterator::Mode mode = KV_Iterator::Unchecked,
+                   KV_KeyTable *keys      = nullptr) {
+        reparse(buffer, length, mode, keys);
+    }
+
+    /**
+     * @brief   Discard the previous dictionary and parse a new one, reusing the
+     *          memory of the previous one.
+     *
+     * Only allocates memory if the new dictionary has more entries than any of
+     * the previous ones.
+     *
+     * @param   buffer
+     *          A pointer to the raw buffer containing the dictionary.
+     *          Only the pointer is saved, see @ref KV_ArenaParser().
+     * @param   length
+     *          The length of the dictionary in the buffer (in bytes).
+     * @param   mode
+     *          Use @ref KV_Iterator::Checked for untrusted input: parsing then
+     *          stops at the first malformed entry, and @ref isMalformed 
+     *          returns true.
+     * @param   keys
+     *          Optional key table, see @ref KV_Parser::KV_Parser.
+     */
+    void reparse(const uint8_t *buffer, size_t length,
+                 KV_Iterator::Mode mode = KV_Iterator::Unchecked,
+                 KV_KeyTable *keys      = nullptr);
+
+    /// Check if parsing stopped early because of a malformed entry (only in
+    /// @ref KV_Iterator::Checked mode).
+    bool isMalformed() const { return malformed; }
+
+    /// Pre-allocate storage for dictionaries of up to @p numEntries entries.
+    void reserve(size_t numEntries) { entries.reserve(numEntries); }
+
+    /// Get the number of entries in the dictionary.
+    size_t size() const { return entries.size(); }
+
+    /**
+     * @brief   Check if the dictionary contains an element with the given key.
+     *
+     * @param   key
+     *          The key of the element to check.
+     * @retval  true
+     *          The dictionary contains an element with the given key.
+     * @retval  false
+     *          Otherwise.
+     */
+    bool contains(const char *key) const { return find(key) != end(); }
+
+    /**
+     * @brief   Get the element with the given key.
+     *
+     * @param   key
+     *          The key of the element to retreive.
+     * @return  The element with the given key.
+     * @throw   std::out_of_range
+     *          There is no element with the given key.
+     */
+    KV getElement(const char *key) const {
+        auto found = find(key);
+        if (found == end())
+            throw std::out_of_range("KV_ArenaParser::getElement");
+        return found->second;
+    }
+    /// @copydoc getElement
+    KV operator[](const char *key) const { return getElement(key); }
+
+    /**
+     * @brief   Get the element with the given key, without throwing exceptions.
+     *
+     * @param   key
+     *          The key of the element to retreive.
+     * @return  The element with the given key, or
+     *          @ref KV_Errc::NonExistentEntry if there is no element with the
+     *          given key.
+     */
+    KV_Result<KV> tryGetElement(const char *key) const {
+        auto found = find(key);
+        if (found == end())
+            return KV_Errc::NonExistentEntry;
+        return found->second;
+    }
+
+    /**
+     * @brief   Find the entry with the given key (binary search).
+     *
+     * @return  An iterator to the entry with the given key, or @ref end() if
+     *          the key was not found in the dictionary.
+     */
+    const_iterator find(const char *key) const;
+
+    /// Begin iterator over all entries in the dictionary (sorted by key).
+    const_iterator begin() const { return entries.begin(); }
+    /// End iterator over all entries in the dictionary.
+    const_iterator end() const { return entries.end(); }
+
+  private:
+    std::vector<entry_t> entries;
+    bool malformed = false;
+};
+
+/// @}
+
+#endif // ARDUINO
@@ -0,0 +1,248 @@
+#pragma once
+
+#ifdef ARDUINO
+
+#include <KVComm/include/KVComm/KV_Helpers.hpp> // roundUpToWordSizeMultiple
+#include <KVComm/include/KVComm/KV_Types.hpp>   // KV_Type<T>, KV_ValueType
+
+#include <AH/STL/cstddef>     // size_t, ptrdiff_t
+#include <AH/STL/cstdint>     // uint8_t, uint16_t, uintptr_t
+#include <AH/STL/type_traits> // std::is_same
+
+#else
+
+#include <KVComm/KV_Helpers.hpp> // roundUpToWordSizeMultiple
+#include <KVComm/KV_Types.hpp>   // KV_Type<T>, KV_ValueType
+
+#include <cstddef>     // size_t, ptrdiff_t
+#include <cstdint>     // uint8_t, uint16_t, uintptr_t
+#include <type_traits> // std::is_same
+
+#endif
+
+/// @addtogroup KVComm
+/// @{
+
+/**
+ * @file
+ * @brief   Multi-dimensional array entries with shape metadata, and strided
+ *          views to access them.
+ *
+ * A shaped entry has the type ID of its elements, with the
+ * @ref KV_Shape::Flag bit set. Its data starts with a shape header, followed
+ * by the elements in row-major order:
+ *
+ * ~~~
+ * +------+------+-------+-------+-----+-------+---------+----------+
+ * | rank | 0x00 | dim 0 | dim 1 | ... | dim N | padding | elements |
+ * +------+------+-------+-------+-----+-------+---------+----------+
+ *   1 B    1 B    2 B LE                         to 4 B
+ * ~~~
+ */
+
+/// Constants and helpers for the shape header of multi-dimensional entries.
+namespace KV_Shape {
+/// Type ID bit that marks entries with a shape header.
+constexpr uint8_t Flag = 0x80;
+/// The maximum number of dimensions.
+constexpr uint8_t MaxRank = 8;
+/// The size of the largest shape header (including padding).
+constexpr size_t MaxHeaderSize = (2 + 2 * MaxRank + 3) / 4 * 4;
+/// The size of the shape header (including padding) for the given rank.
+inline size_t headerSize(uint8_t rank) {
+    return roundUpToWordSizeMultiple(2 + 2 * size_t(rank));
+}
+/// Write the shape header to the buffer.
+inline void writeHeader(uint8_t *buffer, const uint16_t *shape, uint8_t rank) {
+    size_t size = headerSize(rank);
+    buffer[0]   = rank;
+    for (size_t i = 1; i < size; ++i)
+        buffer[i] = 0;
+    for (uint8_t i = 0; i < rank; ++i) {
+        buffer[2 + 2 * i] = shape[i] >> 0;
+        buffer[3 + 2 * i] = shape[i] >> 8;
+    }
+}
+} // namespace KV_Shape
+
+/**
+ * @brief   Read-only view of the elements of a (multi-dimensional) array in a
+ *          dictionary buffer, without copying them.
+ *
+ * Every dimension has its own stride, so the same data can be viewed in
+ * row-major or column-major order (@ref transposed), and rows, columns or
+ * other slices can be selected without copying (@ref slice).
+ *
+ * Element access converts the data to the native type (and byte order), so
+ * the buffer doesn't have to be aligned. For host code that wants to use the
+ * data directly, @ref contiguous returns a pointer into the buffer if the
+ * view is dense and suitably aligned, and @ref copyTo exports the data into a
+ * contiguous buffer, using a single bulk copy if possible.
+ *
+ * @tparam  T
+ *          The type of the elements in the buffer.
+ */
+template <class T>
+class KV_ArrayView {
+  public:
+    /// The type of the elements after reading them from the buffer.
+    using value_type = typename KV_ValueType<T>::type;
+
+    /// Create an empty view.
+    KV_ArrayView() = default;
+
+    /**
+     * @brief   Create a row-major view of the given data.
+     *
+     * @param   data
+     *          Pointer to the first element in the buffer.
+     * @param   shape
+     *          The size of each dimension.
+     * @param   rank
+     *          The number of dimensions (at most @ref KV_Shape::MaxRank).
+     */
+    KV_ArrayView(const uint8_t *data, const uint16_t *shape, uint8_t rank)
+        : data(data), dims(rank) {
+        ptrdiff_t stride = 1;
+        for (uint8_t i = rank; i-- > 0;) {
+            extents[i] = shape[i];
+            strides[i] = stride;
+            stride *= shape[i];
+        }
+    }
+
+    /// Get the number of dimensions.
+    uint8_t rank() const { return dims; }
+    /// Get the size of the given dimension.
+    size_t size(uint8_t dim) const { return extents[dim]; }
+    /// Get the total number of elements.
+    size_t size() const {
+        size_t n = dims == 0 ? 0 : 1;
+        for (uint8_t i = 0; i < dims; ++i)
+            n *= extents[i];
+        return n;
+    }
+    /// Get the distance (in elements) between consecutive indices of the
+    /// given dimension.
+    ptrdiff_t stride(uint8_t dim) const { return strides[dim]; }
+
+    /// Get the element at the given indices (one index per dimension).
+    value_type at(const size_t *indices) const {
+        ptrdiff_t offset = 0;
+        for (uint8_t i = 0; i < dims; ++i)
+            offset += ptrdiff_t(indices[i]) * strides[i];
+        return read(offset);
+    }
+
+    /// Get the element at the given indices (one index per dimension).
+    template <class... Indices>
+    value_type operator()(Indices... indices) const {
+        static_assert(sizeof...(Indices) > 0, "At least one index required");
+        const size_t idx[] = {size_t(indices)...};
+        return at(idx);
+    }
+
+    /// Get a view with the order of the dimensions reversed (e.g. to access a
+    /// row-major matrix in column-major order).
+    KV_ArrayView transposed() const {
+        KV_ArrayView result = *this;
+        for (uint8_t i = 0; i < dims; ++i) {
+            result.extents[i] = extents[dims - 1 - i];
+            result.strides[i] = strides[dims - 1 - i];
+        }
+        return result;
+    }
+
+    /// Get the view with the given dimension fixed at the given index, e.g.
+    /// `slice(0, i)` is the i-th row of a matrix, and `slice(1, j)` is the
+    /// j-th column.
+    KV_ArrayView slice(uint8_t dim, size_t index) const {
+        KV_ArrayView result = *this;
+        result.data += ptrdiff_t(index) * strides[dim] * elementLength;
+        for (uint8_t i = dim; i + 1 < dims; ++i) {
+            result.extents[i] = extents[i + 1];
+            result.strides[i] = strides[i + 1];
+        }
+        --result.dims;
+        return result;
+    }
+
+    /// Check if the elements of the view are stored contiguously, in
+    /// row-major order.
+    bool isContiguous() const {
+        ptrdiff_t expected = 1;
+        for (uint8_t i = dims; i-- > 0;) {
+            if (extents[i] != 1 && strides[i] != expected)
+                return false;
+            expected *= extents[i];
+        }
+        return true;
+    }
+
+    /**
+     * @brief   Get a pointer to the elements in the buffer, for zero-copy
+     *          access.
+     *
+     * @return  A pointer to the first element, or a null pointer if the view
+     *          is not contiguous, if the elements have to be converted (byte
+     *          order or narrow types), or if the data is not aligned properly
+     *          for type `T`. In that case, use @ref copyTo.
+     */
+    const value_type *contiguous() const {
+        bool sameRepresentation = std::is_same<value_type, T>::value &&
+                                  KV_IsBulkCopyable<T>::value && !KV_BIG_ENDIAN;
+        if (!sameRepresentation || !isContiguous() ||
+            reinterpret_cast<uintptr_t>(data) % alignof(value_type) != 0)
+            return nullptr;
+        return reinterpret_cast<const value_type *>(data);
+    }
+
+    /**
+     * @brief   Copy all elements of the view to the given buffer, in row-major
+     *          order of the view.
+     *
+     * Contiguous views are copied (and converted) in bulk.
+     *
+     * @param   out
+     *          The output buffer, with room for @ref size() elements.
+     */
+    void copyTo(value_type *out) const {
+        if (dims == 0)
+            return;
+        if (isContiguous()) {
+            KV_readArrayAs<T>(out, size(), data);
+            return;
+        }
+        size_t idx[KV_Shape::MaxRank] = {};
+        size_t n = size();
+        for (size_t i = 0; i < n; ++i) {
+            *out++ = at(idx);
+            // Increment the multi-dimensional index, last dimension first
+            for (uint8_t d = dims; d-- > 0;) {
+                if (++idx[d] < extents[d])
+                    break;
+                idx[d] = 0;
+            }
+        }
+    }
+
+  private:
+    value_type read(ptrdiff_t offset) const {
+        T t;
+        KV_Type<T>::readFromBuffer(t, data + offset * elementLength);
+        return t;
+    }
+
+    constexpr static ptrdiff_t elementLength = KV_Type<T>::getLength();
+
+  private:
+    const uint8_t *data = nullptr;
+    uint8_t dims        = 0;
+    size_t extents[KV_Shape::MaxRank]    = {};
+    ptrdiff_t strides[KV_Shape::MaxRank] = {};
+};
+
+template <class T>
+constexpr ptrdiff_t KV_ArrayView<T>::elementLength;
+
+/// @}
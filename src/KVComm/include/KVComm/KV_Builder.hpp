@@ -3,22 +3,28 @@
 #ifdef ARDUINO
 
 #include <KVComm/include/KVComm/KV_Iterator.hpp> // KV_Iterator
+#include <KVComm/include/KVComm/KV_KeyTable.hpp> // KV_KeyTable
 
 #include <AH/STL/array>            // std::array
 #include <AH/STL/cstddef>          // size_t
 #include <AH/STL/initializer_list> // std::initializer_list
+#include <AH/STL/limits>           // std::numeric_limits
+#include <AH/STL/type_traits>      // std::is_same
 #include <AH/STL/vector>           // std::vector
-#include <string.h>                // strlen
+#include <string.h>                // strlen, memcmp
 
 #else
 
 #include <KVComm/KV_Iterator.hpp> // KV_Iterator
+#include <KVComm/KV_KeyTable.hpp> // KV_KeyTable
 
 #include <array>            // std::array
 #include <cstddef>          // size_t
-#include <cstring>          // strlen
+#include <cstring>          // strlen, memcmp
 #include <initializer_list> // std::initializer_list
 #include <iosfwd>           // std::ostream forward declaration
+#include <limits>           // std::numeric_limits
+#include <type_traits>      // std::is_same
 #include <vector>           // std::vector
 #endif
 
@@ -140,20 +146,135 @@ class KV_Builder {
      */
     template <class T>
     bool add(const char *key, const T *data, size_t count) {
-        // don't allow empty keys
-        if (key == nullptr || key[0] == '\0')
-            return false;
-        // don't allow null data
-        if (data == nullptr && count != 0)
+        return addAs<T>(key, data, count);
+    }
+
+    /**
+     * @brief   Add a key-value pair to the dictionary, or update the existing
+     *          value with the same key, converting the data to another type.
+     * 
+     * This is used to send values using a smaller type on the wire, for 
+     * example, an array of `float` as @ref KV_Float16 or @ref KV_Q15 
+     * (see @ref KV_NarrowTypes.hpp). The data is converted in bulk.
+     * 
+     * @tparam  W
+     *          The type that is stored in the dictionary.
+     * @tparam  T
+     *          The type of the values to add. Must be convertible to `W`.
+     * 
+     * @see     @ref add(const char *, const T *, size_t)
+     */
+    template <class W, class T>
+    bool addAs(const char *key, const T *data, size_t count) {
+        return insert<W>(key, data, count, nullptr, 0);
+    }
+
+    /// @copydoc addAs(const char *, const T *, size_t)
+    template <class W, class T>
+    bool addAs(const char *key, const T &value) {
+        return addAs<W>(key, &value, 1);
+    }
+
+    /// @copydoc addAs(const char *, const T *, size_t)
+    template <class W, class T, size_t N>
+    bool addAs(const char *key, const T (&array)[N]) {
+        return addAs<W>(key, array, N);
+    }
+
+    /// @copydoc addAs(const char *, const T *, size_t)
+    template <class W, class T>
+    bool addAs(const char *key, std::initializer_list<T> list) {
+        return addAs<W>(key, list.begin(), list.size());
+    }
+
+    /// @copydoc addAs(const char *, const T *, size_t)
+    template <class W, class T>
+    bool addAs(const char *key, const std::vector<T> &vector) {
+        return addAs<W>(key, vector.data(), vector.size());
+    }
+
+    /**
+     * @brief   Add a multi-dimensional array to the dictionary, or update the
+     *          existing array with the same key.
+     * 
+     * The shape (the number of dimensions and the size of each dimension) is
+     * stored in the entry, so the receiver can access the data using a 
+     * @ref KV_ArrayView, see @ref KV_ArrayView.hpp. The data is copied in
+     * bulk.
+     * 
+     * @tparam  T
+     *          The type of the elements.
+     * @param   key
+     *          The key of the entry.
+     * @param   data
+     *          Pointer to the elements, in row-major order (the last index
+     *          varies fastest).
+     * @param   shape
+     *          The size of each dimension.
+     * @param   rank
+     *          The number of dimensions (at most @ref KV_Shape::MaxRank).
+     * @retval  true 
+     *          The array was added or updated successfully.
+     * @retval  false 
+     *          The buffer is full, the key or data length is too large, the
+     *          rank is not supported, or the type and shape don't match the
+     *          ones of the existing element with the same key.
+     */
+    template <class T>
+    bool addArray(const char *key, const T *data, const uint16_t *shape,
+                  uint8_t rank) {
+        return addArrayAs<T>(key, data, shape, rank);
+    }
+
+    /// @copydoc addArray(const char *, const T *, const uint16_t *, uint8_t)
+    template <class T>
+    bool addArray(const char *key, const T *data,
+                  std::initializer_list<uint16_t> shape) {
+        return addArrayAs<T>(key, data, shape.begin(), shape.size());
+    }
+
+    /// Add a two-dimensional array (matrix) to the dictionary, or update the
+    /// existing array with the same key.
+    /// @see    @ref addArray(const char *, const T *, const uint16_t *, uint8_t)
+    template <class T, size_t R, size_t C>
+    bool addArray(const char *key, const T (&matrix)[R][C]) {
+        return addArray(key, &matrix[0][0], {uint16_t(R), uint16_t(C)});
+    }
+
+    /**
+     * @brief   Add a multi-dimensional array to the dictionary, or update the
+     *          existing array with the same key, converting the data to 
+     *          another type.
+     * 
+     * @tparam  W
+     *          The type that is stored in the dictionary.
+     * @tparam  T
+     *          The type of the values to add. Must be convertible to `W`.
+     * 
+     * @see     @ref addArray(const char *, const T *, const uint16_t *, uint8_t)
+     * @see     @ref addAs(const char *, const T *, size_t)
+     */
+    template <class W, class T>
+    bool addArrayAs(const char *key, const T *data, const uint16_t *shape,
+                    uint8_t rank) {
+        if (shape == nullptr || rank == 0 || rank > KV_Shape::MaxRank)
             return false;
-        // Check if dictionary already contains a value with this key
-        KV_Iterator::iterator found = find(key);
-        if (found != KV_Iterator::end())
-            // if the dictionary already contains an element with the same key
-            return overwrite(found, data, count);
-        else
-            // this is a new key
-            return append(key, data, count);
+        // The data length is limited to 16 bits, checking the number of 
+        // elements after every dimension prevents overflow
+        size_t count = 1;
+        for (uint8_t i = 0; i < rank; ++i) {
+            count *= shape[i];
+            if (count > std::numeric_limits<uint16_t>::max())
+                return false;
+        }
+        return insert<W>(key, data, count, shape, rank);
+    }
+
+    /// @copydoc addArrayAs(const char *, const T *, const uint16_t *, uint8_t)
+    template <class W, class T>
+    bool addArrayAs(const char *key, const T *data,
+                    std::initializer_list<uint16_t> shape) {
+        return addArrayAs<W>(key, data, shape.begin(), shape.size());
     }
 
     /**
@@ -349,6 +470,33 @@ class KV_Builder {
         return add(key, vector.data(), vector.size());
     }
 
+    /**
+     * @brief   Add a nested dictionary to the dictionary, or update the 
+     *          existing nested dictionary with the same key.
+     * 
+     * The buffer of the given dictionary is copied as the data of the entry,
+     * so related values can be grouped, e.g. by subsystem, without repeating
+     * long key prefixes. Iterating over the outer dictionary skips over 
+     * nested dictionaries in constant time, and they can be searched using
+     * @ref KV_Iterator::find(const char *, const char *, Keys...) or 
+     * @ref KV_Iterator::KV::getDictionary.
+     * 
+     * @param   key
+     *          The key of the nested dictionary.
+     * @param   dictionary
+     *          The dictionary to add.
+     * @retval  true 
+     *          The dictionary was added or updated successfully.
+     * @retval  false 
+     *          The buffer is full, the key or data length is too large, 
+     *          or the existing element with the same key is not a dictionary
+     *          of the same length.
+     */
+    bool addDictionary(const char *key, const KV_Builder &dictionary) {
+        return addAs<KV_Dictionary>(key, dictionary.getBuffer(),
+                                    dictionary.getLength());
+    }
+
     /**
      * @brief   Clear all elements of the dictionary.
      */
@@ -358,8 +506,24 @@ class KV_Builder {
         std::fill(buffer, buffer + bufferSize, 0);
     }
 
+    /**
+     * @brief   Use the given key table to replace the keys of new elements by 
+     *          numeric IDs (see @ref KV_KeyTable).
+     * 
+     * Only affects elements that are added after calling this function.
+     * 
+     * @param   keys
+     *          The key table to use, or a null pointer to disable key IDs.
+     *          The table has to outlive the dictionary.
+     */
+    void setKeyTable(const KV_KeyTable *keys) { this->keys = keys; }
+    /// Get the key table used to replace keys by numeric IDs.
+    const KV_KeyTable *getKeyTable() const { return keys; }
+
 #if !defined(ARDUINO) || defined(DOXYGEN)
-    void print(std::ostream &os) const;
+    /// @copydoc print(Print &, bool) const
+    void print(std::ostream &os, bool annotate = false) const;
+    /// @copydoc printPython(Print &) const
     void printPython(std::ostream &os) const;
 #endif // ARDUINO
 
@@ -368,10 +532,16 @@ class KV_Builder {
      * @brief   Dump the dictionary buffer to the given output stream in a 
      *          human-readable format (offset + hexadecimal + ASCII).
      * 
+     * Every line is formatted in a small buffer on the stack, and written to
+     * the stream at once.
+     * 
      * @param   os
      *          The stream to print to.
+     * @param   annotate
+     *          Append the key, type ID and data length to the first line of
+     *          every entry.
      */
-    void print(Print &os) const;
+    void print(Print &os, bool annotate = false) const;
 
     /**
      * @brief   Dump the dictionary buffer to the given output stream as a 
@@ -383,6 +553,29 @@ class KV_Builder {
     void printPython(Print &os) const;
 #endif
 
+    /**
+     * @brief   Dump the dictionary buffer to the given character buffer in a
+     *          human-readable format, see @ref print(Print &, bool) const.
+     * 
+     * @param   buffer
+     *          The buffer to write the null-terminated dump to.
+     * @param   size
+     *          The size of the buffer. If the dump doesn't fit, it is 
+     *          truncated.
+     * @param   annotate
+     *          Append the key, type ID and data length to the first line of
+     *          every entry.
+     * @return  The length of the complete dump (without null terminator), 
+     *          like `snprintf`.
+     */
+    size_t print(char *buffer, size_t size, bool annotate = false) const;
+
+    /**
+     * @brief   Dump the dictionary buffer to the given character buffer as a
+     *          Python bytes object, see @ref print(char *, size_t, bool) const.
+     */
+    size_t printPython(char *buffer, size_t size) const;
+
   private:
     uint8_t *buffer;
     size_t bufferSize;
@@ -393,27 +586,67 @@ class KV_Builder {
     /// A pointer to the first free/unused byte in the buffer.
     uint8_t *bufferwritelocation = buffer;
 
+    /// The key table used to replace keys by numeric IDs.
+    const KV_KeyTable *keys = nullptr;
+
   private:
     /// Write the header of a new element into the buffer, advance the write
     /// pointer, and return a pointer to where the data should be written.
     /// Returns a null pointer if the element is too large for the buffer, and
     /// in that case, the write pointer is unaltered.
-    uint8_t *writeHeader(const char *key, uint8_t typeID, size_t length);
+    uint8_t *writeHeader(const char *key, size_t keyLen, uint8_t typeID,
+                         size_t length);
+
+    /// Add the element to the dictionary or update the existing element with
+    /// the same key, with the data converted to type `W`. If @p rank is 
+    /// nonzero, the element gets a shape header.
+    template <class W, class T>
+    bool insert(const char *key, const T *data, size_t count,
+                const uint16_t *shape, uint8_t rank) {
+        // don't allow empty keys
+        if (key == nullptr || key[0] == '\0')
+            return false;
+        // don't allow null data
+        if (data == nullptr && count != 0)
+            return false;
+        // Replace the key by its numeric ID if it's in the key table (but 
+        // never for the key definitions themselves)
+        KV_Result<uint16_t> id = KV_Errc::NonExistentEntry;
+        if (keys && !std::is_same<W, KV_KeyDefinition>::value)
+            id = keys->lookup(key);
+        // Check if dictionary already contains a value with this key
+        KV_Iterator::iterator found = id ? findID(*id) : find(key);
+        if (found != KV_Iterator::end())
+            // if the dictionary already contains an element with the same key
+            return overwrite<W>(found, data, count, shape, rank);
+        // this is a new key
+        if (id) {
+            char idKey[3];
+            return append<W>(idKey, KV_KeyTable::writeKeyID(*id, idKey), data,
+                             count, shape, rank);
+        }
+        return append<W>(key, strlen(key), data, count, shape, rank);
+    }
+
 
-    /// Append the new element to the buffer.
+    /// Append the new element to the buffer, with the data converted to type
+    /// `W`, and with a shape header if @p rank is nonzero.
     /// Returns false if the element is too large for the buffer.
-    template <class T>
-    bool append(const char *key, const T *data, size_t count);
+    template <class W, class T>
+    bool append(const char *key, size_t keyLen, const T *data, size_t count,
+                const uint16_t *shape, uint8_t rank);
 
     /// Overwrite the existing element referenced by @p existing with the
-    /// new data, if the type and size match.
-    /// Returns false if the type or size doesn't match, and in that case,
-    /// nothing is overwritten.
-    template <class T>
-    bool overwrite(KV_Iterator::iterator existing, const T *data, size_t count);
-
-    /// (Over)write the data of an element to the buffer.
-    template <class T>
+    /// new data converted to type `W`, if the type, size and shape match.
+    /// Returns false if the type, size or shape doesn't match, and in that
+    /// case, nothing is overwritten.
+    template <class W, class T>
+    bool overwrite(KV_Iterator::iterator existing, const T *data, size_t count,
+                   const uint16_t *shape, uint8_t rank);
+
+    /// (Over)write the data of an element to the buffer, converted to type
+    /// `W`.
+    template <class W, class T>
     void overwrite(uint8_t *buffer, const T *data, size_t count);
 
   public:
@@ -442,6 +675,17 @@ class KV_Builder {
      *          not found in the dictionary.
      */
     KV_Iterator::iterator find(const char *key) const;
+
+    /** 
+     * @brief   Get the element with the given numeric key ID.
+     * 
+     * @param   id
+     *          The key ID of the element to retreive.
+     * @return  An iterator to the element with the given key ID, or a 
+     *          default-constructed KV_Iterator::iterator if the key ID was 
+     *          not found in the dictionary.
+     */
+    KV_Iterator::iterator findID(uint16_t id) const;
 };
 
 /// Macro for easily adding variables with the variable name as the key.
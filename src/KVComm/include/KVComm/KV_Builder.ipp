@@ -10,32 +10,49 @@
 
 #endif
 
-template <class T>
+template <class W, class T>
 void KV_Builder::overwrite(uint8_t *buffer, const T *data, size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        KV_Type<T>::writeToBuffer(*data++, buffer);
-        buffer += KV_Type<T>::getLength();
-    }
+    KV_writeArrayAs<W>(data, count, buffer);
 }
 
-template <class T>
-bool KV_Builder::append(const char *key, const T *data, size_t count) {
-    uint8_t *dataDestination = writeHeader(key, KV_Type<T>::getTypeID(),
-                                           KV_Type<T>::getLength() * count);
+template <class W, class T>
+bool KV_Builder::append(const char *key, size_t keyLen, const T *data,
+                        size_t count, const uint16_t *shape, uint8_t rank) {
+    size_t headerSize = rank > 0 ? KV_Shape::headerSize(rank) : 0;
+    uint8_t typeID    = KV_Type<W>::getTypeID();
+    if (rank > 0)
+        typeID |= KV_Shape::Flag;
+    uint8_t *dataDestination =
+        writeHeader(key, keyLen, typeID,
+                    headerSize + KV_Type<W>::getLength() * count);
     if (dataDestination == nullptr)
         return false;
-    overwrite(dataDestination, data, count);
+    if (rank > 0)
+        KV_Shape::writeHeader(dataDestination, shape, rank);
+    overwrite<W>(dataDestination + headerSize, data, count);
     return true;
 }
 
-template <class T>
+template <class W, class T>
 bool KV_Builder::overwrite(KV_Iterator::iterator existing, const T *data,
-                           size_t count) {
-    if (existing->getTypeID() != KV_Type<T>::getTypeID() ||
-        existing->getDataLength() != KV_Type<T>::getLength() * count)
+                           size_t count, const uint16_t *shape, uint8_t rank) {
+    size_t headerSize = rank > 0 ? KV_Shape::headerSize(rank) : 0;
+    uint8_t typeID    = KV_Type<W>::getTypeID();
+    if (rank > 0)
+        typeID |= KV_Shape::Flag;
+    if (existing->getTypeID() != typeID ||
+        existing->getDataLength() !=
+            headerSize + KV_Type<W>::getLength() * count)
         return false;
     auto offset          = existing->getData() - buffer;
     uint8_t *destination = buffer + offset;
-    overwrite(destination, data, count);
+    // The shape has to match as well, not just the number of elements
+    if (rank > 0) {
+        uint8_t header[KV_Shape::MaxHeaderSize];
+        KV_Shape::writeHeader(header, shape, rank);
+        if (memcmp(header, destination, headerSize) != 0)
+            return false;
+    }
+    overwrite<W>(destination + headerSize, data, count);
     return true;
-}
\ No newline at end of file
+}
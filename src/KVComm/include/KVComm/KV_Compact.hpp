@@ -0,0 +1,148 @@
+#pragma once
+
+#ifdef ARDUINO
+
+#include <KVComm/include/KVComm/KV_Result.hpp> // KV_Result, KV_Errc
+
+#include <AH/STL/cstddef> // size_t
+#include <AH/STL/cstdint> // uint8_t, uint64_t
+
+#else
+
+#include <KVComm/KV_Result.hpp> // KV_Result, KV_Errc
+
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t, uint64_t
+
+#endif
+
+/// @addtogroup KVComm
+/// @{
+
+/**
+ * @file
+ * @brief   Conversion between the word-aligned in-memory dictionary layout of
+ *          the @ref KV_Builder and a compact wire format.
+ */
+
+/**
+ * @brief   Conversion between the word-aligned in-memory dictionary layout of
+ *          the @ref KV_Builder and a compact wire format.
+ *
+ * The aligned layout spends a 4-byte header on every entry, and pads both the
+ * key and the data to a multiple of 4 bytes. For dictionaries with many small
+ * values, most of the bytes on the wire are overhead. The compact format
+ * removes the padding and encodes all lengths as variable-length integers:
+ *
+ *     frame: | flags | entry | entry | ... |
+ *     entry: | key len (varint) | type | data len (varint) | key | payload |
+ *
+ * The key is not null-terminated and not padded. The data length is the
+ * length of the data in the aligned layout (in bytes).
+ * If the @ref VarintIntegers flag is set, the payload of 16, 32 and 64-bit
+ * integers is encoded as one varint per element (zig-zag encoded for signed
+ * types), otherwise, and for all other types, the payload is copied as-is.
+ *
+ * The sender builds its dictionary using a KV_Builder as usual and encodes it
+ * right before sending it. The receiver decodes it back into the aligned
+ * layout, so it can use @ref KV_Iterator, @ref KV_Parser etc. to access the
+ * data without copying it.
+ *
+ * Both functions work on raw buffers only, they don't allocate memory and
+ * don't throw exceptions, so they can be used on the Arduino as well.
+ */
+struct KV_Compact {
+    /// Flags that specify the encoding of the frame. They are sent as the
+    /// first byte of every frame, so the receiver knows how to decode it.
+    enum Flags : uint8_t {
+        /// No flags: lengths are varints, payloads are copied as-is.
+        None = 0x00,
+        /// Encode the elements of 16, 32 and 64-bit integers as (zig-zag)
+        /// varints.
+        VarintIntegers = 0x01,
+    };
+
+    /**
+     * @brief   Convert a dictionary in the aligned layout (as generated by
+     *          @ref KV_Builder) to the compact wire format.
+     *
+     * @param   aligned
+     *          The dictionary to encode.
+     * @param   length
+     *          The length of the dictionary (in bytes).
+     * @param   out
+     *          The buffer to write the compact frame to.
+     * @param   outSize
+     *          The size of the output buffer (in bytes).
+     * @param   flags
+     *          The encoding flags, see @ref Flags.
+     * @return  The length of the compact frame (in bytes), or one of the
+     *          error codes @ref KV_Errc::Malformed or
+     *          @ref KV_Errc::BufferTooSmall.
+     */
+    static KV_Result<size_t> encode(const uint8_t *aligned, size_t length,
+                                    uint8_t *out, size_t outSize,
+                                    uint8_t flags = VarintIntegers);
+
+    /**
+     * @brief   Convert a compact frame back to the aligned layout.
+     *
+     * The input is not trusted: all lengths are checked against the size of
+     * the input and output buffers, and varint integers that don't fit the
+     * size of their type are rejected.
+     *
+     * @param   compact
+     *          The compact frame to decode.
+     * @param   length
+     *          The length of the compact frame (in bytes).
+     * @param   out
+     *          The buffer to write the aligned dictionary to. It should be
+     *          word-aligned, so the data can be accessed in-place.
+     * @param   outSize
+     *          The size of the output buffer (in bytes).
+     * @return  The length of the aligned dictionary (in bytes), or one of the
+     *          error codes @ref KV_Errc::Malformed or
+     *          @ref KV_Errc::BufferTooSmall.
+     */
+    static KV_Result<size_t> decode(const uint8_t *compact, size_t length,
+                                    uint8_t *out, size_t outSize);
+
+    /// Write an unsigned LEB128 varint to the buffer, returns the number of
+    /// bytes written, or 0 if it doesn't fit in the @p size bytes.
+    static size_t writeVarint(uint64_t value, uint8_t *buffer, size_t size) {
+        size_t i = 0;
+        do {
+            if (i == size)
+                return 0;
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            buffer[i++] = byte | (value ? 0x80 : 0x00);
+        } while (value);
+        return i;
+    }
+
+    /// Read an unsigned LEB128 varint from the buffer, returns the number of
+    /// bytes read, or 0 if the varint is truncated or too long.
+    static size_t readVarint(uint64_t &value, const uint8_t *buffer,
+                             size_t size) {
+        value = 0;
+        for (size_t i = 0; i < size && i < 10; ++i) {
+            value |= uint64_t(buffer[i] & 0x7F) << (7 * i);
+            if ((buffer[i] & 0x80) == 0)
+                return i + 1;
+        }
+        return 0;
+    }
+
+    /// Map signed integers to unsigned integers so that numbers with a small
+    /// absolute value have a short varint encoding.
+    static uint64_t zigzagEncode(int64_t value) {
+        return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+    }
+    /// Inverse of @ref zigzagEncode.
+    static int64_t zigzagDecode(uint64_t value) {
+        return int64_t(value >> 1) ^ -int64_t(value & 1);
+    }
+};
+
+/// @}
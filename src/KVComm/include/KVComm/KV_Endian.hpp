@@ -0,0 +1,93 @@
+#pragma once
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t
+#include <string.h> // memcpy
+
+/// @addtogroup KVComm
+/// @{
+
+/**
+ * @file
+ * @brief   Conversion between the native byte order and the byte order of the
+ *          dictionary buffers. All multi-byte values are stored in
+ *          little-endian order, regardless of the architecture that created
+ *          the buffer.
+ *
+ * On little-endian targets (AVR, ARM, ESP32, x86), all conversions are plain
+ * copies, the byte swaps are removed by the preprocessor.
+ */
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) &&                \
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+/// Whether the native byte order is big-endian.
+#define KV_BIG_ENDIAN 1
+#else
+#define KV_BIG_ENDIAN 0
+#endif
+
+/// Conversion between native byte order and little-endian wire byte order.
+namespace KV_Endian {
+
+/**
+ * @brief   Reverse the byte order of each element of an array in place.
+ *
+ * Only used on big-endian targets.
+ *
+ * @param   data
+ *          Pointer to the first byte of the array.
+ * @param   elementSize
+ *          The size of a single element in bytes.
+ * @param   count
+ *          The number of elements in the array.
+ */
+void swapArray(uint8_t *data, size_t elementSize, size_t count);
+
+/// Reverse the byte order of a single value in place.
+inline void reverseBytes(uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size / 2; ++i) {
+        uint8_t tmp        = data[i];
+        data[i]            = data[size - 1 - i];
+        data[size - 1 - i] = tmp;
+    }
+}
+
+/// Write a value to the buffer in wire byte order.
+template <class T>
+inline void toWire(const T &t, uint8_t *buffer) {
+    memcpy(buffer, &t, sizeof(T));
+#if KV_BIG_ENDIAN
+    reverseBytes(buffer, sizeof(T));
+#endif
+}
+
+/// Read a value in wire byte order from the buffer.
+template <class T>
+inline void fromWire(T &t, const uint8_t *buffer) {
+    memcpy(&t, buffer, sizeof(T));
+#if KV_BIG_ENDIAN
+    reverseBytes(reinterpret_cast<uint8_t *>(&t), sizeof(T));
+#endif
+}
+
+/// Write an array of values to the buffer in wire byte order.
+template <class T>
+inline void arrayToWire(const T *data, size_t count, uint8_t *buffer) {
+    memcpy(buffer, data, sizeof(T) * count);
+#if KV_BIG_ENDIAN
+    swapArray(buffer, sizeof(T), count);
+#endif
+}
+
+/// Read an array of values in wire byte order from the buffer.
+template <class T>
+inline void arrayFromWire(T *data, size_t count, const uint8_t *buffer) {
+    memcpy(data, buffer, sizeof(T) * count);
+#if KV_BIG_ENDIAN
+    swapArray(reinterpret_cast<uint8_t *>(data), sizeof(T), count);
+#endif
+}
+
+} // namespace KV_Endian
+
+/// @}
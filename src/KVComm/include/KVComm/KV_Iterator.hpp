@@ -2,8 +2,11 @@
 
 #ifdef ARDUINO
 
+#include <KVComm/include/KVComm/KV_ArrayView.hpp> // KV_ArrayView<T>
 #include <KVComm/include/KVComm/KV_Error.hpp> // KV_ERROR
 #include <KVComm/include/KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
+#include <KVComm/include/KVComm/KV_NarrowTypes.hpp> // KV_Float16, KV_Q15
+#include <KVComm/include/KVComm/KV_Result.hpp> // KV_Result<T>, KV_Errc
 #include <KVComm/include/KVComm/KV_Types.hpp> // KV_Type<T>
 
 #include <AH/STL/array>    // std::array
@@ -16,9 +19,12 @@
 
 #else
 
-#include <KVComm/KV_Error.hpp>   // KV_ERROR
-#include <KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
-#include <KVComm/KV_Types.hpp>   // KV_Type<T>
+#include <KVComm/KV_ArrayView.hpp>    // KV_ArrayView<T>
+#include <KVComm/KV_Error.hpp>        // KV_ERROR
+#include <KVComm/KV_Helpers.hpp>     // nextWord, roundUpToWordSizeMultiple
+#include <KVComm/KV_NarrowTypes.hpp> // KV_Float16, KV_Q15
+#include <KVComm/KV_Result.hpp>      // KV_Result<T>, KV_Errc
+#include <KVComm/KV_Types.hpp>       // KV_Type<T>
 
 #include <array>    // std::array
 #include <cstddef>  // size_t
@@ -28,6 +34,8 @@
 
 #endif
 
+class KV_KeyTable;
+
 /// @addtogroup KVComm
 /// @{
 
@@ -41,13 +49,50 @@
 /// parsing and for checking if a key is already in the entry.
 class KV_Iterator {
   public:
-    KV_Iterator(const uint8_t *buffer, size_t length)
-        : buffer(buffer), bufferSize(length) {}
+    /// Whether the headers of the entries should be checked while iterating.
+    enum Mode : uint8_t {
+        /// Trust the headers in the buffer (fastest). Only use this for 
+        /// buffers generated by a KV_Builder, or after @ref validate succeeded.
+        Unchecked,
+        /// Check every header against the remaining length of the buffer 
+        /// before accessing the entry. Iteration stops at the first malformed
+        /// entry. Use this for untrusted input.
+        Checked,
+    };
+
+    /// Create a KV_Iterator over an empty dictionary.
+    KV_Iterator() : KV_Iterator(nullptr, 0) {}
+
+    /**
+     * @brief   Create a KV_Iterator that iterates over the elements in the
+     *          buffer.
+     * 
+     * @param   buffer
+     *          A pointer to the buffer containing the dictionary.
+     * @param   length
+     *          The length of the dictionary (in bytes).
+     * @param   mode
+     *          Whether the headers of the entries should be checked.
+     * @param   keys
+     *          The key table used to resolve the numeric IDs of entries (see
+     *          @ref KV_KeyTable). It has to outlive the iterator and the
+     *          entries.
+     */
+    KV_Iterator(const uint8_t *buffer, size_t length, Mode mode = Unchecked,
+                const KV_KeyTable *keys = nullptr)
+        : buffer(buffer), bufferSize(length), mode(mode), keys(keys) {}
 
     class KV {
       public:
+        /// Default constructor. Creates an invalid (non-existent) entry.
+        KV() : buffer(nullptr), key(nullptr) {}
         /// Constructor
-        KV(const uint8_t *buffer) : buffer(buffer) {}
+        KV(const uint8_t *buffer)
+            : buffer(buffer),
+              key(buffer ? (const char *) buffer + 4 : nullptr) {}
+        /// Constructor for entries with a key ID that was resolved to the 
+        /// given key.
+        KV(const uint8_t *buffer, const char *key) : buffer(buffer), key(key) {}
         /// Get the type ID of the current element.
         uint8_t getTypeID() const { return buffer[1]; }
         /// Get the length of the identifier / key of the current element.
@@ -59,7 +104,20 @@ class KV_Iterator {
         /// Get a pointer to the beginning of the current element.
         const uint8_t *getBuffer() const { return buffer; }
         /// Get the identifier / key of the current element.
-        const char *getID() const { return (const char *) buffer + 4; }
+        /// For entries with a numeric key ID, this is the key it was resolved
+        /// to, or an empty string if it couldn't be resolved.
+        const char *getID() const { return key; }
+        /// Check if the key of the current element is a numeric ID (see
+        /// @ref KV_KeyTable).
+        bool hasKeyID() const {
+            return (getIDLength() == 2 || getIDLength() == 3) &&
+                   buffer[4] == '\0';
+        }
+        /// Get the numeric key ID of the current element. Only valid if
+        /// @ref hasKeyID returns true.
+        uint16_t getKeyID() const {
+            return buffer[5] | (getIDLength() == 3 ? buffer[6] << 8 : 0);
+        }
         /// Get a pointer to the data of the current element.
         const uint8_t *getData() const {
             return buffer + nextWord(getIDLength()) + 4;
@@ -118,7 +176,8 @@ class KV_Iterator {
          *          The index of the element of the array to read (if the value 
          *          is an array).
          * @return  The requested element of the value from this key-value pair,
-         *          casted to the given type `T`.
+         *          casted to the given type `T` (or to `float` for the types in
+         *          @ref KV_NarrowTypes.hpp).
          * 
          * @throw   0x7566
          *          Trying to extract data from non-existent entry.
@@ -129,7 +188,7 @@ class KV_Iterator {
          *          Index out of range.
          */
         template <class T>
-        T getAs(size_t index = 0) const {
+        typename KV_ValueType<T>::type getAs(size_t index = 0) const {
             T t;
             get(t, index);
             return t;
@@ -142,7 +201,8 @@ class KV_Iterator {
          *          The type of the data. This must be the same as the dynamic
          *          type of the data.
          * @return  A vector containing the data of the element, converted to 
-         *          the correct type.
+         *          the correct type (`float` for the types in 
+         *          @ref KV_NarrowTypes.hpp).
          * 
          * @throw   0x7566
          *          Trying to extract data from non-existent entry.
@@ -151,7 +211,7 @@ class KV_Iterator {
          *          of `T`.
          */
         template <class T>
-        std::vector<T> getVector() const {
+        std::vector<typename KV_ValueType<T>::type> getVector() const {
             if (!*this) {
                 KV_ERROR(F("Trying to extract data from non-existent entry"),
                          0x7566);
@@ -160,12 +220,8 @@ class KV_Iterator {
             if (!checkType<T>())
                 return {}; // LCOV_EXCL_LINE
             size_t size = getDataLength() / KV_Type<T>::getLength();
-            std::vector<T> result(size);
-            auto readlocation = getData();
-            for (T &t : result) {
-                KV_Type<T>::readFromBuffer(t, readlocation);
-                readlocation += KV_Type<T>::getLength();
-            }
+            std::vector<typename KV_ValueType<T>::type> result(size);
+            KV_readArrayAs<T>(result.data(), size, getData());
             return result;
         }
 
@@ -179,7 +235,8 @@ class KV_Iterator {
          *          The number of elements in the array. This must be the same
          *          as the length of the data.
          * @return  An array containing the data of the element, converted to 
-         *          the correct type.
+         *          the correct type (`float` for the types in 
+         *          @ref KV_NarrowTypes.hpp).
          * @throw   0x7566
          *          Trying to extract data from non-existent entry.
          * @throw   0x7563
@@ -190,7 +247,7 @@ class KV_Iterator {
          *          the actual dynamic size of the element.
          */
         template <class T, size_t N>
-        std::array<T, N> getArray() const {
+        std::array<typename KV_ValueType<T>::type, N> getArray() const {
             if (!*this) {
                 KV_ERROR(F("Trying to extract data from non-existent entry"),
                          0x7566);
@@ -202,15 +259,100 @@ class KV_Iterator {
                 KV_ERROR(F("Incorrect length"), 0x7565);
                 return {{}}; // LCOV_EXCL_LINE
             }
-            std::array<T, N> result;
-            auto readlocation = getData();
-            for (T &t : result) {
-                KV_Type<T>::readFromBuffer(t, readlocation);
-                readlocation += KV_Type<T>::getLength();
-            }
+            std::array<typename KV_ValueType<T>::type, N> result;
+            KV_readArrayAs<T>(result.data(), N, getData());
             return result;
         }
 
+        /**
+         * @brief   Get the data as the given type, without throwing exceptions
+         *          or raising errors.
+         * 
+         * @tparam  T
+         *          The type of value to read.
+         * @param[out]  t
+         *          The value is read from the dictionary into this variable.
+         *          It is left untouched if an error occurs.
+         * @param[in]   index
+         *          The index of the element of the array to read (if the value 
+         *          is an array).
+         * @return  @ref KV_Errc::OK on success, otherwise one of 
+         *          @ref KV_Errc::NonExistentEntry, @ref KV_Errc::TypeMismatch
+         *          or @ref KV_Errc::IndexOutOfRange.
+         */
+        template <class T>
+        KV_Errc tryGet(T &t, size_t index = 0) const {
+            KV_Errc errc = checkAccess<T>();
+            if (errc != KV_Errc::OK)
+                return errc;
+            if (index * KV_Type<T>::getLength() >= getDataLength())
+                return KV_Errc::IndexOutOfRange;
+            auto readlocation = getData() + KV_Type<T>::getLength() * index;
+            KV_Type<T>::readFromBuffer(t, readlocation);
+            return KV_Errc::OK;
+        }
+
+        /**
+         * @brief   Get the data as the given type, without throwing exceptions
+         *          or raising errors.
+         * 
+         * @tparam  T
+         *          The type of value to read.
+         * @param   index
+         *          The index of the element of the array to read (if the value 
+         *          is an array).
+         * @return  The requested element, or an error code, see @ref tryGet.
+         */
+        template <class T>
+        KV_Result<typename KV_ValueType<T>::type>
+        tryGetAs(size_t index = 0) const {
+            T t;
+            KV_Errc errc = tryGet(t, index);
+            if (errc != KV_Errc::OK)
+                return errc;
+            return typename KV_ValueType<T>::type(t);
+        }
+
+        /**
+         * @brief   Get the data of the element as an array of the given type,
+         *          without throwing exceptions or raising errors.
+         * 
+         * @tparam  T 
+         *          The type of the data.
+         * @tparam  N
+         *          The number of elements in the array.
+         * @return  An array containing the data of the element, or one of the
+         *          error codes @ref KV_Errc::NonExistentEntry, 
+         *          @ref KV_Errc::TypeMismatch or @ref KV_Errc::IncorrectLength.
+         */
+        template <class T, size_t N>
+        KV_Result<std::array<typename KV_ValueType<T>::type, N>>
+        tryGetArray() const {
+            KV_Errc errc = checkAccess<T>();
+            if (errc != KV_Errc::OK)
+                return errc;
+            if (N * KV_Type<T>::getLength() != getDataLength())
+                return KV_Errc::IncorrectLength;
+            std::array<typename KV_ValueType<T>::type, N> result;
+            KV_readArrayAs<T>(result.data(), N, getData());
+            return result;
+        }
+
+        /**
+         * @brief   Get the character array as a null-terminated C-string, 
+         *          without throwing exceptions or raising errors.
+         * 
+         * @return  The string, or one of the error codes
+         *          @ref KV_Errc::NonExistentEntry or 
+         *          @ref KV_Errc::TypeMismatch.
+         */
+        KV_Result<const char *> tryGetString() const {
+            KV_Errc errc = checkAccess<char>();
+            if (errc != KV_Errc::OK)
+                return errc;
+            return reinterpret_cast<const char *>(getData());
+        }
+
 // #if !defined(ARDUINO) || defined(DOXYGEN)
 //         /**
 //          * @brief   Get the character array as an std::string.
@@ -246,6 +388,122 @@ class KV_Iterator {
          */
         const char *getString() const;
 
+        /// Check if this entry is a multi-dimensional array with a shape
+        /// header (see @ref KV_ArrayView.hpp).
+        bool hasShape() const { return getTypeID() & KV_Shape::Flag; }
+        /// Get the type ID of the elements of the array, without the shape
+        /// flag.
+        uint8_t getElementTypeID() const {
+            return getTypeID() & ~KV_Shape::Flag;
+        }
+        /// Get the number of dimensions of the array (1 if the entry has no
+        /// shape header).
+        uint8_t getRank() const { return hasShape() ? getData()[0] : 1; }
+
+        /**
+         * @brief   Get a view of the data of the element as a 
+         *          (multi-dimensional) array of the given type, without copying
+         *          it.
+         * 
+         * Entries without a shape header are viewed as one-dimensional arrays.
+         * 
+         * @tparam  T
+         *          The type of the elements. This must be the same as the
+         *          dynamic type of the elements.
+         * @throw   0x7566
+         *          Trying to extract data from non-existent entry.
+         * @throw   0x7563
+         *          Type mismatch: The dynamic type ID of the elements doesn't 
+         *          match the type ID of `T`.
+         * @throw   0x7567
+         *          Malformed shape: The shape header is invalid, or it doesn't
+         *          match the length of the data.
+         */
+        template <class T>
+        KV_ArrayView<T> getArrayView() const {
+            if (!*this) {
+                KV_ERROR(F("Trying to extract data from non-existent entry"),
+                         0x7566);
+                return {}; // LCOV_EXCL_LINE
+            }
+            if (getElementTypeID() != KV_Type<T>::getTypeID()) {
+                KV_ERROR(F("Type mismatch (typeid=")
+                             << getTypeID() << F(", view requested of ")
+                             << KV_Type<T>::getTypeID() << ')',
+                         0x7563);
+                return {}; // LCOV_EXCL_LINE
+            }
+            KV_Result<KV_ArrayView<T>> view = tryGetArrayView<T>();
+            if (!view) {
+                KV_ERROR(F("Malformed shape"), 0x7567);
+                return {}; // LCOV_EXCL_LINE
+            }
+            return *view;
+        }
+
+        /**
+         * @brief   Get a view of the data of the element as a 
+         *          (multi-dimensional) array of the given type, without 
+         *          throwing exceptions or raising errors.
+         * 
+         * @tparam  T
+         *          The type of the elements.
+         * @return  A view of the data, or one of the error codes 
+         *          @ref KV_Errc::NonExistentEntry, @ref KV_Errc::TypeMismatch
+         *          or @ref KV_Errc::Malformed.
+         */
+        template <class T>
+        KV_Result<KV_ArrayView<T>> tryGetArrayView() const {
+            if (!*this)
+                return KV_Errc::NonExistentEntry;
+            if (getElementTypeID() != KV_Type<T>::getTypeID())
+                return KV_Errc::TypeMismatch;
+            uint16_t shape[KV_Shape::MaxRank];
+            uint8_t rank;
+            const uint8_t *elements;
+            KV_Errc errc = getShape(shape, rank, elements,
+                                    KV_Type<T>::getLength());
+            if (errc != KV_Errc::OK)
+                return errc;
+            return KV_ArrayView<T>(elements, shape, rank);
+        }
+
+        /// Check if this entry contains a nested dictionary (see 
+        /// @ref KV_Builder::addDictionary).
+        bool isDictionary() const { return hasType<KV_Dictionary>(); }
+
+        /**
+         * @brief   Get the nested dictionary contained in this entry.
+         * 
+         * @param   mode
+         *          Whether the headers of the nested entries should be 
+         *          checked.
+         * @param   keys
+         *          The key table used to resolve the numeric IDs of the nested
+         *          entries.
+         * @return  A KV_Iterator over the entries of the nested dictionary.
+         * 
+         * @throw   0x7566
+         *          Trying to extract data from non-existent entry.
+         * @throw   0x7563
+         *          Type mismatch: The entry doesn't contain a dictionary.
+         */
+        KV_Iterator getDictionary(Mode mode = Unchecked,
+                                  const KV_KeyTable *keys = nullptr) const;
+
+        /**
+         * @brief   Get the nested dictionary contained in this entry, without
+         *          throwing exceptions or raising errors.
+         * 
+         * @return  A KV_Iterator over the entries of the nested dictionary, or
+         *          one of the error codes @ref KV_Errc::NonExistentEntry or
+         *          @ref KV_Errc::TypeMismatch.
+         * @see     @ref getDictionary
+         */
+        KV_Result<KV_Iterator>
+        tryGetDictionary(Mode mode = Unchecked,
+                         const KV_KeyTable *keys = nullptr) const;
+
         /**
          * @brief   Check if the type of this element is the same as the given 
          *          type.
@@ -276,8 +534,25 @@ class KV_Iterator {
             return true;
         }
 
+        /// Check that this entry exists and that its type matches the given
+        /// type `T`, without raising an error.
+        template <class T>
+        KV_Errc checkAccess() const {
+            if (!*this)
+                return KV_Errc::NonExistentEntry;
+            if (!hasType<T>())
+                return KV_Errc::TypeMismatch;
+            return KV_Errc::OK;
+        }
+
       private:
+        /// Parse the shape header (if any), and check it against the length
+        /// of the data.
+        KV_Errc getShape(uint16_t *shape, uint8_t &rank,
+                         const uint8_t *&elements, size_t elementLength) const;
+
         const uint8_t *buffer;
+        const char *key;
     };
 
     class iterator {
@@ -288,7 +563,10 @@ class KV_Iterator {
         /// buffer.
         /// Only the pointer is saved, the buffer itself is not copied over, so
         /// its lifetime must be longer than all iterators that point to it.
-        iterator(const uint8_t *buffer, size_t length);
+        /// The optional key table is used to resolve the numeric IDs of
+        /// entries.
+        iterator(const uint8_t *buffer, size_t length, Mode mode = Unchecked,
+                 const KV_KeyTable *keys = nullptr);
 
         /// Advance the iterator.
         iterator &operator++();
@@ -307,6 +585,10 @@ class KV_Iterator {
         /// Check if the iterator is valid.
         explicit operator bool() const { return !!kv; }
 
+        /// Check if iteration was stopped because of a malformed entry (only
+        /// in @ref Checked mode).
+        bool isMalformed() const { return malformed; }
+
         using difference_type   = void;
         using value_type        = KV;
         using pointer           = KV *;
@@ -315,23 +597,85 @@ class KV_Iterator {
 
       protected:
         void checkLength();
+        /// Check that the header of the current entry is consistent and that
+        /// the entry fits in the remaining part of the buffer.
+        bool checkEntry() const;
 
       private:
         KV kv;
         size_t remainingBufferLength;
+        const KV_KeyTable *keys;
+        bool checked;
+        bool malformed = false;
     };
 
     /// Iterator to the first key-value entry of the dictionary.
-    iterator begin() const { return {buffer, bufferSize}; }
+    iterator begin() const { return {buffer, bufferSize, mode, keys}; }
     /// End/sentinel iterator.
     static iterator end() { return {}; }
 
     /// Find the entry with the given key (iterates over entire dictionary).
     iterator find(const char *key) const;
 
+    /**
+     * @brief   Find the entry with the given path of keys in nested 
+     *          dictionaries, e.g. `find("motor", "left", "rpm")`.
+     * 
+     * Only the dictionaries along the path are searched, all other nested
+     * dictionaries are skipped in constant time, without looking at their
+     * entries. The mode and key table of this iterator are used for the 
+     * nested dictionaries as well.
+     * 
+     * @return  An iterator to the entry, or @ref end() if one of the keys 
+     *          doesn't exist, or if one of the entries along the path is not
+     *          a dictionary.
+     */
+    template <class... Keys>
+    iterator find(const char *key, const char *subkey, Keys... rest) const {
+        iterator parent = find(key);
+        if (!parent || !parent->isDictionary())
+            return end();
+        return parent->getDictionary(mode, keys).find(subkey, rest...);
+    }
+    /// Find the entry with the given numeric key ID (iterates over entire 
+    /// dictionary, but only compares integers).
+    iterator findID(uint16_t id) const;
+
+    /**
+     * @brief   Check that all entries in the given buffer are well-formed, in
+     *          a single linear pass.
+     * 
+     * For each entry, the header is checked against the remaining length of
+     * the buffer, the key must be null-terminated, and strings must be 
+     * null-terminated within their data. Nested dictionaries are validated
+     * as well, up to a depth of @ref MaxNestingDepth.  
+     * If validation succeeds, the buffer can be accessed using the 
+     * @ref Unchecked mode (and by @ref KV_Parser) without reading out of 
+     * bounds.
+     * 
+     * @param   buffer
+     *          A pointer to the (untrusted) buffer containing the dictionary.
+     * @param   length
+     *          The length of the buffer (in bytes).
+     * @retval  KV_Errc::OK
+     *          All entries are well-formed.
+     * @retval  KV_Errc::Malformed
+     *          The buffer contains a malformed or truncated entry.
+     */
+    static KV_Errc validate(const uint8_t *buffer, size_t length);
+
+    /// The maximum depth of nested dictionaries accepted by @ref validate.
+    constexpr static uint8_t MaxNestingDepth = 8;
+
+  private:
+    static KV_Errc validate(const uint8_t *buffer, size_t length,
+                            uint8_t depth);
+
   private:
     const uint8_t *buffer;
     size_t bufferSize;
+    Mode mode;
+    const KV_KeyTable *keys;
 };
 
 /// @}
\ No newline at end of file
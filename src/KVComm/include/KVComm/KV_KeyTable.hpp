@@ -0,0 +1,214 @@
+#pragma once
+
+#ifdef ARDUINO
+
+#include <KVComm/include/KVComm/KV_Iterator.hpp> // KV_Iterator
+#include <KVComm/include/KVComm/KV_Result.hpp>   // KV_Result, KV_Errc
+#include <KVComm/include/KVComm/KV_Types.hpp>    // KV_Type
+
+#include <AH/STL/cstddef> // size_t
+#include <AH/STL/cstdint> // uint8_t, uint16_t
+#include <AH/STL/memory>  // std::unique_ptr
+#include <AH/STL/vector>  // std::vector
+
+#else
+
+#include <KVComm/KV_Iterator.hpp> // KV_Iterator
+#include <KVComm/KV_Result.hpp>   // KV_Result, KV_Errc
+#include <KVComm/KV_Types.hpp>    // KV_Type
+
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t, uint16_t
+#include <memory>  // std::unique_ptr
+#include <vector>  // std::vector
+
+#endif
+
+class KV_Builder;
+
+/// @addtogroup KVComm
+/// @{
+
+/**
+ * @file
+ * @brief   Key tables for replacing the string keys of dictionary entries by
+ *          short numeric IDs.
+ */
+
+/// The data of a key definition entry: the numeric ID of the key of the entry.
+struct KV_KeyDefinition {
+    uint16_t id;
+};
+
+/// Key definitions use the reserved type ID 0, so they can't be confused with
+/// normal values.
+template <>
+struct KV_Type<KV_KeyDefinition> {
+    constexpr static uint8_t getTypeID() { return 0; }
+    constexpr static size_t getLength() { return sizeof(uint16_t); }
+    static void writeToBuffer(const KV_KeyDefinition &t, uint8_t *buffer) {
+        KV_Endian::toWire(t.id, buffer);
+    }
+    static void readFromBuffer(KV_KeyDefinition &t, const uint8_t *buffer) {
+        KV_Endian::fromWire(t.id, buffer);
+    }
+};
+
+/**
+ * @brief   Maps the string keys of dictionary entries to numeric IDs and
+ *          back.
+ *
+ * Long keys are sent in full in every frame. If both the sender and the
+ * receiver use a key table, entries whose key is in the table carry a 1-byte
+ * (IDs up to 255) or 2-byte ID instead of the key, so the key always fits in
+ * a single word:
+ *
+ *          0         1         2         3
+ *     +---------+---------+---------+---------+
+ *     | key len |  type   |    data length    |
+ *     +---------+---------+---------+---------+
+ *     |  NULL   | ID low  | ID high |  NULL   |
+ *     +---------+---------+---------+---------+
+ *     |                 data                  |
+ *     +---------+---------+---------+---------+
+ *
+ * The key length is 2 for 1-byte IDs and 3 for 2-byte IDs. Normal keys can't
+ * be empty, so the leading null byte distinguishes IDs from normal keys.
+ *
+ * The sender periodically sends a frame with key definitions (see
+ * @ref writeDefinitions): entries with type ID 0, the full key, and the
+ * numeric ID as data. The receiver learns these definitions (see @ref learn),
+ * and @ref KV_Iterator, @ref KV_Parser and @ref KV_ArenaParser then resolve
+ * the IDs back to the original keys, so `getID()` returns the full key.
+ * Entries with IDs that haven't been defined yet have an empty key.
+ *
+ * **Sender**
+ *
+ * ~~~cpp
+ * const char *keys[] = {"analog 0", "seconds"};
+ * KV_KeyTable keyTable = keys;
+ * Static_KV_Builder<256> dict;
+ * dict.setKeyTable(&keyTable);
+ * dict.add("seconds", 12.07); // sent as ID 1
+ *
+ * Static_KV_Builder<256> definitions;
+ * keyTable.writeDefinitions(definitions); // send this every few seconds
+ * ~~~
+ *
+ * **Receiver**
+ *
+ * ~~~cpp
+ * KV_KeyTable keyTable;
+ * KV_Parser parsed = {buffer, length, KV_Iterator::Unchecked, &keyTable};
+ * parsed["seconds"].getAs<double>();
+ * ~~~
+ */
+class KV_KeyTable {
+  public:
+    /// Create an empty key table (e.g. on the receiving side).
+    KV_KeyTable() = default;
+
+    /// Create a key table where the ID of each key is its index in the given
+    /// array. Only the pointers are copied, so the strings have to outlive the
+    /// key table.
+    KV_KeyTable(const char *const *keys, size_t count)
+        : keys(keys, keys + count) {}
+
+    /// @copydoc KV_KeyTable(const char *const *, size_t)
+    template <size_t N>
+    KV_KeyTable(const char *const (&keys)[N]) : KV_KeyTable(keys, N) {}
+
+    /**
+     * @brief   Get the ID of the given key.
+     *
+     * @param   key
+     *          The key to look up.
+     * @return  The ID of the key, or @ref KV_Errc::NonExistentEntry if the
+     *          key is not in the table.
+     */
+    KV_Result<uint16_t> lookup(const char *key) const;
+
+    /// Get the key with the given ID, or a null pointer if the ID is not in
+    /// the table.
+    const char *resolve(uint16_t id) const {
+        return id < keys.size() ? keys[id] : nullptr;
+    }
+
+    /// Get the number of IDs in the table (one more than the largest ID).
+    size_t size() const { return keys.size(); }
+
+    /**
+     * @brief   Add the ID of the given key to the table, replacing the
+     *          previous key with this ID, if any.
+     *
+     * The key is copied. The copy of the previous key with this ID is
+     * released, so keys of this ID that were resolved earlier (e.g. the keys
+     * of a @ref KV_Parser of an earlier frame) are no longer valid.
+     */
+    void define(uint16_t id, const char *key);
+
+    /**
+     * @brief   Add all key definitions in the given dictionary to the table.
+     *
+     * @param   buffer
+     *          A pointer to the buffer containing the dictionary.
+     * @param   length
+     *          The length of the dictionary (in bytes).
+     * @param   mode
+     *          Use @ref KV_Iterator::Checked for untrusted input.
+     * @return  The number of key definitions that were added. Definitions
+     *          with an ID larger than @ref getMaxID are ignored.
+     */
+    size_t learn(const uint8_t *buffer, size_t length,
+                 KV_Iterator::Mode mode = KV_Iterator::Unchecked);
+
+    /**
+     * @brief   Set the largest ID accepted by @ref learn.
+     *
+     * The table has an entry for every ID up to the largest one, so this
+     * limits the memory used for definitions received from untrusted peers.
+     * The default is @ref DefaultMaxID.
+     */
+    void setMaxID(uint16_t maxID) { this->maxID = maxID; }
+    /// Get the largest ID accepted by @ref learn.
+    uint16_t getMaxID() const { return maxID; }
+
+    /// The default largest ID accepted by @ref learn: all 1-byte IDs.
+    constexpr static uint16_t DefaultMaxID = 0xFF;
+
+    /**
+     * @brief   Add a key definition for every key in the table to the given
+     *          dictionary.
+     *
+     * @retval  true
+     *          All definitions were added successfully.
+     * @retval  false
+     *          The buffer of the dictionary is full.
+     */
+    bool writeDefinitions(KV_Builder &dict) const;
+
+    /// Remove all keys from the table.
+    void clear();
+
+    /// Write the key of an entry with the given ID to the buffer (which must
+    /// be at least 3 bytes long). Returns the length of the key.
+    static uint8_t writeKeyID(uint16_t id, char *buffer) {
+        buffer[0] = '\0';
+        buffer[1] = id >> 0;
+        if (id <= 0xFF)
+            return 2;
+        buffer[2] = id >> 8;
+        return 3;
+    }
+
+  private:
+    /// The key of every ID, or null pointers for unused IDs.
+    std::vector<const char *> keys;
+    /// The copy of the key of every ID added by @ref define, or null
+    /// pointers for IDs that weren't added by @ref define.
+    std::vector<std::unique_ptr<char[]>> storage;
+    /// The largest ID accepted by @ref learn.
+    uint16_t maxID = DefaultMaxID;
+};
+
+/// @}
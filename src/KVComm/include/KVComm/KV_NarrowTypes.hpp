@@ -0,0 +1,218 @@
+#pragma once
+
+#ifdef ARDUINO
+#include <KVComm/include/KVComm/KV_Types.hpp> // KV_Type, KV_Endian
+#else
+#include <KVComm/KV_Types.hpp> // KV_Type, KV_Endian
+#endif
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint16_t, int16_t
+#include <string.h> // memcpy
+
+/// @addtogroup KVComm
+/// @{
+
+/**
+ * @file
+ * @brief   Two-byte KV_Type definitions for values that don't need the full
+ *          precision of a `float`: IEEE 754 half precision, and the Q15 and
+ *          Q7.8 fixed-point formats.
+ * 
+ * These types are meant to be used as the wire type of a dictionary entry,
+ * with a `float` as the value type:
+ * 
+ * ~~~cpp
+ * float motors[4] = {0.56, 0.55, 0.54, 0.57};
+ * dict.addAs<KV_Q15>("motor outputs", motors);
+ * // ...
+ * std::vector<float> received = parsed["motor outputs"].getVector<KV_Q15>();
+ * ~~~
+ * 
+ * Arrays are converted in bulk, using tight loops that can be vectorized by
+ * the compiler, and using the F16C instructions for half precision if they
+ * are available.
+ */
+
+/// IEEE 754 half-precision (binary16) floating point number: 11 significant
+/// bits, with a range of +/-65504.
+struct KV_Float16 {
+    /// The binary representation.
+    uint16_t bits;
+
+    KV_Float16() = default;
+    KV_Float16(float f) : bits(fromFloat(f)) {}
+    operator float() const { return toFloat(bits); }
+
+    /// Convert a float to half precision (round to nearest even).
+    static uint16_t fromFloat(float f) {
+        const uint32_t denormMagic = 0x3F000000; // 0.5f
+        uint32_t x;
+        memcpy(&x, &f, sizeof(x));
+        uint32_t sign = x & 0x80000000;
+        x ^= sign;
+        uint16_t h;
+        if (x >= 0x47800000) { // Inf or NaN (or too large)
+            h = x > 0x7F800000 ? 0x7E00 : 0x7C00;
+        } else if (x < 0x38800000) { // Subnormal or zero
+            // Align the 10 mantissa bits at the bottom using a float addition,
+            // which takes care of the rounding
+            float magic, g;
+            memcpy(&magic, &denormMagic, sizeof(magic));
+            memcpy(&g, &x, sizeof(g));
+            g += magic;
+            memcpy(&x, &g, sizeof(x));
+            h = x - denormMagic;
+        } else {
+            uint32_t mantissaOdd = (x >> 13) & 1;
+            // Rebias the exponent, and round to nearest even
+            x += ((uint32_t(15) - 127) << 23) + 0xFFF + mantissaOdd;
+            h = x >> 13;
+        }
+        return h | (sign >> 16);
+    }
+
+    /// Convert a half-precision number to a float.
+    static float toFloat(uint16_t h) {
+        const uint32_t shiftedExp = uint32_t(0x7C00) << 13;
+        uint32_t x   = uint32_t(h & 0x7FFF) << 13;
+        uint32_t exp = x & shiftedExp;
+        x += uint32_t(127 - 15) << 23;
+        if (exp == shiftedExp) { // Inf or NaN
+            x += uint32_t(128 - 16) << 23;
+        } else if (exp == 0) { // Zero or subnormal: renormalize
+            const uint32_t magic = uint32_t(113) << 23;
+            x += uint32_t(1) << 23;
+            float f, m;
+            memcpy(&f, &x, sizeof(f));
+            memcpy(&m, &magic, sizeof(m));
+            f -= m;
+            memcpy(&x, &f, sizeof(x));
+        }
+        x |= uint32_t(h & 0x8000) << 16;
+        float f;
+        memcpy(&f, &x, sizeof(f));
+        return f;
+    }
+};
+
+/**
+ * @brief   Signed 16-bit fixed-point number with the given number of
+ *          fractional bits. Conversion from float rounds to the nearest
+ *          representable value and saturates.
+ * 
+ * @tparam  FractionalBits
+ *          The number of fractional bits. Only Q15 and Q7.8 have a type ID.
+ */
+template <uint8_t FractionalBits>
+struct KV_Fixed16 {
+    /// The raw integer representation.
+    int16_t raw;
+
+    /// The value of the least significant bit.
+    constexpr static float resolution() { return 1.f / (1L << FractionalBits); }
+
+    KV_Fixed16() = default;
+    KV_Fixed16(float f) : raw(fromFloat(f)) {}
+    operator float() const { return toFloat(raw); }
+
+    /// Convert a float to fixed-point (round to nearest, saturate).
+    static int16_t fromFloat(float f) {
+        float scaled = f * (1L << FractionalBits);
+        // Written without branches, so conversion of arrays can be vectorized
+        // (NaN is mapped to the minimum)
+        scaled = scaled > -32768.f ? scaled : -32768.f;
+        scaled = scaled < 32767.f ? scaled : 32767.f;
+        return int16_t(scaled + (scaled >= 0 ? 0.5f : -0.5f));
+    }
+
+    /// Convert a fixed-point number to a float.
+    static float toFloat(int16_t raw) { return raw * resolution(); }
+};
+
+/// Signed fixed-point number in [-1, 1), with a resolution of 2^-15.
+using KV_Q15 = KV_Fixed16<15>;
+/// Signed fixed-point number in [-128, 128), with a resolution of 2^-8.
+using KV_Q7_8 = KV_Fixed16<8>;
+
+template <>
+struct KV_ValueType<KV_Float16> {
+    using type = float;
+};
+
+template <uint8_t FractionalBits>
+struct KV_ValueType<KV_Fixed16<FractionalBits>> {
+    using type = float;
+};
+
+/// Half precision uses the reserved type ID 13.
+template <>
+struct KV_Type<KV_Float16> {
+    constexpr static uint8_t getTypeID() { return 13; }
+    constexpr static size_t getLength() { return 2; }
+    static void writeToBuffer(const KV_Float16 &t, uint8_t *buffer) {
+        KV_Endian::toWire(t.bits, buffer);
+    }
+    static void readFromBuffer(KV_Float16 &t, const uint8_t *buffer) {
+        KV_Endian::fromWire(t.bits, buffer);
+    }
+
+    /// Convert an array of floats to half precision.
+    static void writeArray(const float *data, size_t count, uint8_t *buffer);
+    /// Convert an array of half-precision numbers to floats.
+    static void readArray(float *data, size_t count, const uint8_t *buffer);
+
+    /// Convert an array of other arithmetic types to half precision.
+    template <class T>
+    static void writeArray(const T *data, size_t count, uint8_t *buffer) {
+        for (size_t i = 0; i < count; ++i)
+            KV_Endian::toWire(KV_Float16::fromFloat(data[i]), buffer + 2 * i);
+    }
+    /// Convert an array of half-precision numbers to other arithmetic types.
+    template <class T>
+    static void readArray(T *data, size_t count, const uint8_t *buffer) {
+        for (size_t i = 0; i < count; ++i) {
+            uint16_t h;
+            KV_Endian::fromWire(h, buffer + 2 * i);
+            data[i] = KV_Float16::toFloat(h);
+        }
+    }
+};
+
+/// Q15 and Q7.8 use the reserved type IDs 14 and 15.
+template <uint8_t FractionalBits>
+struct KV_Type<KV_Fixed16<FractionalBits>> {
+    static_assert(FractionalBits == 15 || FractionalBits == 8,
+                  "Only Q15 and Q7.8 have a reserved type ID");
+    using Fixed = KV_Fixed16<FractionalBits>;
+
+    constexpr static uint8_t getTypeID() {
+        return FractionalBits == 15 ? 14 : 15;
+    }
+    constexpr static size_t getLength() { return 2; }
+    static void writeToBuffer(const Fixed &t, uint8_t *buffer) {
+        KV_Endian::toWire(t.raw, buffer);
+    }
+    static void readFromBuffer(Fixed &t, const uint8_t *buffer) {
+        KV_Endian::fromWire(t.raw, buffer);
+    }
+
+    /// Convert an array of floats (or other arithmetic types) to fixed-point.
+    template <class T>
+    static void writeArray(const T *data, size_t count, uint8_t *buffer) {
+        for (size_t i = 0; i < count; ++i)
+            KV_Endian::toWire(Fixed::fromFloat(data[i]), buffer + 2 * i);
+    }
+    /// Convert an array of fixed-point numbers to floats (or other arithmetic
+    /// types).
+    template <class T>
+    static void readArray(T *data, size_t count, const uint8_t *buffer) {
+        for (size_t i = 0; i < count; ++i) {
+            int16_t raw;
+            KV_Endian::fromWire(raw, buffer + 2 * i);
+            data[i] = Fixed::toFloat(raw);
+        }
+    }
+};
+
+/// @}
@@ -2,7 +2,10 @@
 
 #if !defined(ARDUINO) || defined(DOXYGEN)
 
-#include <KVComm/KV_Types.hpp>  // KV_Type
+#include <KVComm/KV_Iterator.hpp> // KV_Iterator
+#include <KVComm/KV_KeyTable.hpp> // KV_KeyTable
+#include <KVComm/KV_Result.hpp>   // KV_Result, KV_Errc
+#include <KVComm/KV_Types.hpp>    // KV_Type
 
 #include <cstdint>    // uint8_t, uint32_t
 #include <map>        // std::map
@@ -50,9 +53,20 @@ class KV_Parser {
      *          the accessors.
      * @param   length
      *          The length of the dictionary in the buffer (in bytes).
+     * @param   mode
+     *          Use @ref KV_Iterator::Checked for untrusted input: parsing then
+     *          stops at the first malformed entry.
+     * @param   keys
+     *          Optional key table: the key definitions in the buffer are added
+     *          to it, and the numeric key IDs of the entries are resolved 
+     *          using it (see @ref KV_KeyTable). The key definitions themselves
+     *          and entries with unknown IDs are not included in the result.
+     *          The key table has to outlive the parser.
      */
-    KV_Parser(const uint8_t *buffer, size_t length)
-        : parseResult{parse(buffer, length)} {}
+    KV_Parser(const uint8_t *buffer, size_t length,
+              KV_Iterator::Mode mode = KV_Iterator::Unchecked,
+              KV_KeyTable *keys = nullptr)
+        : parseResult{parse(buffer, length, mode, keys)} {}
 
     /**
      * @brief   Check if the dictionary contains an element with the given key.
@@ -80,6 +94,26 @@ class KV_Parser {
     KV getElement(const char *key) const { return parseResult.at(key); }
     /// @copydoc getElement
     KV operator[](const char *key) const { return getElement(key); }
+    /**
+     * @brief   Get the element with the given key, without throwing exceptions.
+     * 
+     * @param   key 
+     *          The key of the element to retreive.
+     * @return  The element with the given key, or 
+     *          @ref KV_Errc::NonExistentEntry if there is no element with the
+     *          given key. In the latter case, the value is an invalid KV, so
+     *          calling `tryGetAs` etc. on it results in the same error.
+     */
+    KV_Result<KV> tryGetElement(const char *key) const {
+        auto found = find(key);
+        if (found == end())
+            return KV_Errc::NonExistentEntry;
+        return found->second;
+    }
+    /// Find the entry with the given key, returns @ref end() if not found.
+    map_t::const_iterator find(const char *key) const {
+        return parseResult.find(key);
+    }
     /// Begin iterator over all entries in the dictionary.
     map_t::iterator begin() { return parseResult.begin(); }
     /// Begin iterator over all entries in the dictionary.
@@ -99,9 +133,14 @@ class KV_Parser {
      *          A pointer to the raw buffer containing the dictionary.
      * @param   length 
      *          The length of the dictionary in the buffer (in bytes).
+     * @param   mode
+     *          Whether to check the headers of the entries.
+     * @param   keys
+     *          The key table used to resolve the numeric key IDs (optional).
      * @return  A map mapping the keys to the key-value dictionary entries.
      */
-    map_t parse(const uint8_t *buffer, size_t length);
+    map_t parse(const uint8_t *buffer, size_t length, KV_Iterator::Mode mode,
+                KV_KeyTable *keys);
 };
 
 /// @}
@@ -0,0 +1,221 @@
+#pragma once
+
+#ifdef ARDUINO
+
+#include <KVComm/include/KVComm/KV_Builder.hpp> // KV_Builder
+#include <KVComm/include/KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
+
+#include <AH/STL/array>   // std::array
+#include <AH/STL/cstddef> // size_t
+#include <AH/STL/cstdint> // uint8_t
+
+#else
+
+#include <KVComm/KV_Builder.hpp> // KV_Builder
+#include <KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
+
+#include <array>   // std::array
+#include <cstddef> // size_t
+#include <cstdint> // uint8_t
+
+#endif
+
+/// @addtogroup KVComm
+/// @{
+
+/**
+ * @file
+ * @brief   A ring buffer of dictionary snapshots ("flight recorder").
+ */
+
+/**
+ * @brief   Fixed-capacity ring buffer that keeps the most recent snapshots of
+ *          a dictionary, to export them after a fault occurs.
+ *
+ * All snapshots must have the same layout: the same keys, types and data
+ * lengths, in the same order, like the frames produced by a @ref KV_Builder
+ * that is updated using the same keys every time. The headers and keys are
+ * stored only once, when the first snapshot is recorded, and the ring only
+ * contains the data of each snapshot.
+ *
+ * The snapshots are exported as complete dictionaries, by writing the stored
+ * headers and data directly to a packet sender, without reassembling the
+ * frames in a separate buffer.
+ *
+ * The storage is used as follows:
+ *
+ * ~~~
+ * +-------------------------+----------+----------+-----+-----------+
+ * | headers and keys (once) | record 0 | record 1 | ... | (unused)  |
+ * +-------------------------+----------+----------+-----+-----------+
+ * ~~~
+ */
+class KV_Recorder {
+  public:
+    /**
+     * @brief   Constructor.
+     *
+     * @param   storage
+     *          The buffer to store the layout and the snapshots in.
+     * @param   size
+     *          The size of the buffer.
+     */
+    KV_Recorder(uint8_t *storage, size_t size)
+        : storage(storage), storageSize(size) {}
+
+    /**
+     * @brief   Record a snapshot of the given dictionary, overwriting the
+     *          oldest snapshot if the ring is full.
+     *
+     * The first snapshot defines the layout.
+     *
+     * @param   buffer
+     *          The dictionary, as generated by a @ref KV_Builder.
+     * @param   length
+     *          The length of the dictionary.
+     * @retval  true
+     *          The snapshot was recorded.
+     * @retval  false
+     *          The layout of the dictionary doesn't match the layout of the
+     *          first snapshot, or (for the first snapshot) the storage is too
+     *          small to hold the layout and a single snapshot. Nothing is
+     *          recorded.
+     */
+    bool record(const uint8_t *buffer, size_t length);
+    /// @copydoc record(const uint8_t *, size_t)
+    bool record(const KV_Builder &dict) {
+        return record(dict.getBuffer(), dict.getLength());
+    }
+
+    /// Use a different buffer to store the layout and the snapshots. Removes
+    /// all snapshots and the layout.
+    void changeStorage(uint8_t *storage, size_t size) {
+        this->storage     = storage;
+        this->storageSize = size;
+        reset();
+    }
+
+    /// Remove all snapshots, but keep the layout.
+    void clear() { head = count = 0; }
+    /// Remove all snapshots and the layout, so the next snapshot can have a
+    /// different layout.
+    void reset() {
+        clear();
+        layoutLength = recordLength = maxCount = 0;
+    }
+
+    /// Get the number of snapshots in the ring.
+    size_t size() const { return count; }
+    /// Get the maximum number of snapshots in the ring. Only known after the
+    /// layout is defined by the first snapshot.
+    size_t capacity() const { return maxCount; }
+    /// Get the size of a single snapshot's data (including padding).
+    size_t getRecordLength() const { return recordLength; }
+    /// Get the length of the dictionaries produced by @ref copySnapshot and
+    /// @ref exportTo.
+    size_t getFrameLength() const { return layoutLength + recordLength; }
+
+    /**
+     * @brief   Reassemble a snapshot into a complete dictionary.
+     *
+     * @param   index
+     *          The index of the snapshot, zero is the oldest one.
+     * @param   out
+     *          The buffer for the dictionary, of at least
+     *          @ref getFrameLength bytes.
+     * @return  False if the index is out of range.
+     */
+    bool copySnapshot(size_t index, uint8_t *out) const;
+
+    /**
+     * @brief   Send a snapshot as a single packet.
+     *
+     * @param   sender
+     *          The packet sender, with `beginPacket`, `write` and `endPacket`
+     *          member functions, for example a @ref SLIPStreamCRC.
+     * @param   index
+     *          The index of the snapshot, zero is the oldest one.
+     * @return  The number of bytes sent by the packet sender.
+     */
+    template <class PacketSender>
+    size_t exportSnapshot(PacketSender &sender, size_t index) const {
+        if (index >= count)
+            return 0;
+        size_t sent = sender.beginPacket();
+        forEachSegment(index, [&](const uint8_t *data, size_t length) {
+            sent += sender.write(data, length);
+        });
+        return sent + sender.endPacket();
+    }
+
+    /**
+     * @brief   Send all snapshots, from oldest to newest, as one packet per
+     *          snapshot.
+     *
+     * @param   sender
+     *          The packet sender, see @ref exportSnapshot.
+     * @return  The number of bytes sent by the packet sender.
+     */
+    template <class PacketSender>
+    size_t exportTo(PacketSender &sender) const {
+        size_t sent = 0;
+        for (size_t i = 0; i < count; ++i)
+            sent += exportSnapshot(sender, i);
+        return sent;
+    }
+
+  private:
+    /// Store the headers and keys of the given dictionary as the layout.
+    bool setLayout(const uint8_t *buffer, size_t length);
+    /// Check if the headers and keys of the dictionary match the layout.
+    bool matchesLayout(const uint8_t *buffer, size_t length) const;
+    /// Get the data of the snapshot with the given index (zero is oldest).
+    const uint8_t *getRecord(size_t index) const {
+        size_t slot = (head + maxCount - count + index) % maxCount;
+        return storage + layoutLength + slot * recordLength;
+    }
+    /// Call the callback for every segment of the reassembled snapshot with
+    /// the given index, alternating between headers and data.
+    template <class Callback>
+    void forEachSegment(size_t index, Callback callback) const {
+        const uint8_t *header = storage;
+        const uint8_t *data   = getRecord(index);
+        while (header != storage + layoutLength) {
+            size_t headerLength = 4 + nextWord(header[0]);
+            size_t dataLength =
+                roundUpToWordSizeMultiple(header[2] | (header[3] << 8));
+            callback(header, headerLength);
+            callback(data, dataLength);
+            header += headerLength;
+            data += dataLength;
+        }
+    }
+
+  private:
+    uint8_t *storage;
+    size_t storageSize;
+    /// The size of the stored headers and keys.
+    size_t layoutLength = 0;
+    /// The size of the data of a single snapshot.
+    size_t recordLength = 0;
+    /// The number of snapshots that fit in the storage.
+    size_t maxCount = 0;
+    /// The slot where the next snapshot will be stored.
+    size_t head = 0;
+    /// The number of snapshots in the ring.
+    size_t count = 0;
+};
+
+/// A @ref KV_Recorder with a statically allocated storage buffer.
+template <size_t N>
+class Static_KV_Recorder : public KV_Recorder {
+  public:
+    Static_KV_Recorder() : KV_Recorder(nullptr, 0) {
+        changeStorage(storage.data(), N);
+    }
+
+  private:
+    std::array<uint8_t, N> storage = {{}};
+};
+
+/// @}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h> // uint16_t
+
+/// @addtogroup KVComm
+/// @{
+
+/**
+ * @file
+ * @brief   Error codes and an expected-like result type for the non-throwing
+ *          accessors of KV_Iterator::KV, KV_Parser and KV_ArenaParser.
+ */
+
+/// Error codes used by the KVComm accessors. These are the same codes that are
+/// passed to @ref KV_ERROR by the throwing accessors.
+enum class KV_Errc : uint16_t {
+    OK               = 0x0000, ///< No error.
+    TypeMismatch     = 0x7563, ///< The type ID doesn't match the type ID of T.
+    IndexOutOfRange  = 0x7564, ///< The index is larger than the array size.
+    IncorrectLength  = 0x7565, ///< The array size doesn't match the data size.
+    NonExistentEntry = 0x7566, ///< The entry/key doesn't exist.
+    Malformed        = 0x7567, ///< The buffer contains a malformed entry.
+    BufferTooSmall   = 0x7568, ///< The output buffer is too small.
+};
+
+/**
+ * @brief   The result of a non-throwing accessor: either a value, or an error
+ *          code.
+ *
+ * Creating or checking a result never allocates memory, formats a message or
+ * throws an exception, so the failure path is as cheap as the success path.
+ *
+ * ~~~cpp
+ * auto result = parser.tryGetElement("key")->tryGetAs<float>();
+ * if (result)
+ *     use(result.value());
+ * else
+ *     handle(result.error());
+ * ~~~
+ *
+ * @tparam  T
+ *          The type of the value. Must be default-constructible.
+ */
+template <class T>
+class KV_Result {
+  public:
+    /// Create a successful result containing the given value.
+    KV_Result(const T &value) : val(value), errc(KV_Errc::OK) {}
+    /// Create a failed result with the given error code.
+    KV_Result(KV_Errc errc) : val(), errc(errc) {}
+
+    /// Check if the result contains a value.
+    bool hasValue() const { return errc == KV_Errc::OK; }
+    /// @copydoc hasValue
+    explicit operator bool() const { return hasValue(); }
+
+    /// Get the error code (@ref KV_Errc::OK if the result contains a value).
+    KV_Errc error() const { return errc; }
+
+    /// Get the value. Only valid if @ref hasValue returns true, otherwise,
+    /// a default-constructed value is returned.
+    const T &value() const { return val; }
+    /// @copydoc value
+    const T &operator*() const { return val; }
+    /// @copydoc value
+    const T *operator->() const { return &val; }
+
+    /// Get the value, or the given fallback value if there is no value.
+    T valueOr(const T &fallback) const { return hasValue() ? val : fallback; }
+
+  private:
+    T val;
+    KV_Errc errc;
+};
+
+/// @}
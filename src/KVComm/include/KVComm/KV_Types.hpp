@@ -1,5 +1,20 @@
 #pragma once
 
+#ifdef ARDUINO
+
+#include <KVComm/include/KVComm/KV_Endian.hpp> // KV_Endian
+
+#include <AH/STL/type_traits> // std::enable_if, std::is_integral
+
+#else
+
+#include <KVComm/KV_Endian.hpp> // KV_Endian
+
+#include <type_traits> // std::enable_if, std::is_integral
+
+#endif
+
+#include <stddef.h> // size_t
 #include <stdint.h> // uint#_t
 #include <string.h> // memcpy
 
@@ -12,6 +27,33 @@
  *          float, double, bool, char). These definitions specify how variables
  *          of these types should be serialized and deserialized when writing
  *          and reading them from/to the buffer.
+ * 
+ * Integer and floating point types are mapped onto fixed-width wire types
+ * based on their size and signedness, not on their name, so `int`, `long`,
+ * `double` etc. are encoded the same way on all architectures that agree on
+ * their size. For example, `int` is sent as an `int16_t` on AVR, and as an
+ * `int32_t` on ARM and x86, and `double` is sent as a 32-bit `float` on AVR.
+ * The data is always stored in little-endian byte order (see 
+ * @ref KV_Endian.hpp).
+ * 
+ * | Type ID | Wire type |
+ * |:-------:|-----------|
+ * | 0       | Reserved for @ref KV_KeyDefinition |
+ * | 1, 2    | `int8_t`, `uint8_t` |
+ * | 3, 4    | `int16_t`, `uint16_t` |
+ * | 5, 6    | `int32_t`, `uint32_t` |
+ * | 7, 8    | `int64_t`, `uint64_t` |
+ * | 9       | IEEE 754 binary32 |
+ * | 10      | IEEE 754 binary64 |
+ * | 11      | `bool` |
+ * | 12      | `char` |
+ * | 13      | IEEE 754 binary16, see @ref KV_Float16 |
+ * | 14      | Q15 fixed-point, see @ref KV_Q15 |
+ * | 15      | Q7.8 fixed-point, see @ref KV_Q7_8 |
+ * | 16      | Nested dictionary, see @ref KV_Dictionary |
+ * 
+ * Arrays with a shape header have the @ref KV_Shape::Flag bit set in the type
+ * ID of their elements (see @ref KV_ArrayView.hpp).
  */
 
 /**
@@ -39,7 +81,7 @@
  * @tparam  T
  *          The type to make serializable.
  */
-template <class T>
+template <class T, class Enable = void>
 struct KV_Type {
     constexpr static uint8_t getTypeID();
     constexpr static size_t getLength();
@@ -50,6 +92,8 @@ struct KV_Type {
 /// @}
 
 /// Add a KV_Type definition that can be (de)serialized by just `memcpy`ing.
+/// The native representation is used, so only use this for types that have the
+/// same size and byte representation on all architectures.
 #define KV_ADD_TRIVIAL_TYPE(type, typeid)                                      \
     template <>                                                                \
     struct KV_Type<type> {                                                     \
@@ -63,22 +107,189 @@ struct KV_Type {
         }                                                                      \
     }
 
-KV_ADD_TRIVIAL_TYPE(int8_t, 1);
-KV_ADD_TRIVIAL_TYPE(uint8_t, 2);
-KV_ADD_TRIVIAL_TYPE(int16_t, 3);
-KV_ADD_TRIVIAL_TYPE(uint16_t, 4);
-KV_ADD_TRIVIAL_TYPE(int32_t, 5);
-KV_ADD_TRIVIAL_TYPE(uint32_t, 6);
-KV_ADD_TRIVIAL_TYPE(int64_t, 7);
-KV_ADD_TRIVIAL_TYPE(uint64_t, 8);
-KV_ADD_TRIVIAL_TYPE(float, 9);
-KV_ADD_TRIVIAL_TYPE(double, sizeof(double) == sizeof(float) ? 9 : 10);
+/// Whether `T` is sent as a fixed-width integer (all integers except for bool
+/// and char).
+template <class T>
+struct KV_IsFixedWidthInteger
+    : std::integral_constant<bool, std::is_integral<T>::value &&
+                                       !std::is_same<T, bool>::value &&
+                                       !std::is_same<T, char>::value> {};
+
+/// Integer types, mapped onto `int#_t` and `uint#_t` by size and signedness.
+template <class T>
+struct KV_Type<
+    T, typename std::enable_if<KV_IsFixedWidthInteger<T>::value>::type> {
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 ||
+                      sizeof(T) == 8,
+                  "Integer type has no fixed-width wire type");
+    constexpr static uint8_t getTypeID() {
+        return std::is_signed<T>::value ? signedTypeID() : signedTypeID() + 1;
+    }
+    constexpr static size_t getLength() { return sizeof(T); }
+    static void writeToBuffer(const T &t, uint8_t *buffer) {
+        KV_Endian::toWire(t, buffer);
+    }
+    static void readFromBuffer(T &t, const uint8_t *buffer) {
+        KV_Endian::fromWire(t, buffer);
+    }
+
+  private:
+    /// Type ID of the signed integer type with the same size as `T`.
+    constexpr static uint8_t signedTypeID() {
+        return sizeof(T) == 1 ? 1 : sizeof(T) == 2 ? 3 : sizeof(T) == 4 ? 5 : 7;
+    }
+};
+
+/// Floating point types of 32 or 64 bits.
+template <class T>
+struct KV_Type<T, typename std::enable_if<std::is_floating_point<T>::value &&
+                                          (sizeof(T) == 4 ||
+                                           sizeof(T) == 8)>::type> {
+    constexpr static uint8_t getTypeID() { return sizeof(T) == 4 ? 9 : 10; }
+    constexpr static size_t getLength() { return sizeof(T); }
+    static void writeToBuffer(const T &t, uint8_t *buffer) {
+        KV_Endian::toWire(t, buffer);
+    }
+    static void readFromBuffer(T &t, const uint8_t *buffer) {
+        KV_Endian::fromWire(t, buffer);
+    }
+};
+
+static_assert(sizeof(bool) == 1, "bool should be a single byte");
 KV_ADD_TRIVIAL_TYPE(bool, 11);
 KV_ADD_TRIVIAL_TYPE(char, 12);
 
-#if defined(__arm__)
-// TODO: integers are a separate data type on ARM
-// are there more platforms with this quirk?
-KV_ADD_TRIVIAL_TYPE(int, 5);
-KV_ADD_TRIVIAL_TYPE(unsigned int, 6);
-#endif
\ No newline at end of file
+/// Tag type for entries that contain a nested dictionary: the data of such an
+/// entry is the buffer of another KV_Builder. See 
+/// @ref KV_Builder::addDictionary and @ref KV_Iterator::KV::getDictionary.
+struct KV_Dictionary {};
+
+/// The nested dictionary is copied as-is, byte by byte.
+template <>
+struct KV_Type<KV_Dictionary> {
+    constexpr static uint8_t getTypeID() { return 16; }
+    constexpr static size_t getLength() { return 1; }
+    static void writeArray(const uint8_t *data, size_t count,
+                           uint8_t *buffer) {
+        if (count > 0)
+            memcpy(buffer, data, count);
+    }
+    static void readArray(uint8_t *data, size_t count,
+                          const uint8_t *buffer) {
+        if (count > 0)
+            memcpy(data, buffer, count);
+    }
+};
+
+/// Whether arrays of type `T` can be copied from and to the buffer at once.
+template <class T>
+struct KV_IsBulkCopyable : std::is_arithmetic<T> {};
+
+/// @cond
+
+template <class T>
+void KV_writeArray(const T *data, size_t count, uint8_t *buffer,
+                   std::true_type) {
+    KV_Endian::arrayToWire(data, count, buffer);
+}
+
+template <class T>
+void KV_writeArray(const T *data, size_t count, uint8_t *buffer,
+                   std::false_type) {
+    for (size_t i = 0; i < count; ++i) {
+        KV_Type<T>::writeToBuffer(*data++, buffer);
+        buffer += KV_Type<T>::getLength();
+    }
+}
+
+template <class T>
+void KV_readArray(T *data, size_t count, const uint8_t *buffer,
+                  std::true_type) {
+    KV_Endian::arrayFromWire(data, count, buffer);
+}
+
+template <class T>
+void KV_readArray(T *data, size_t count, const uint8_t *buffer,
+                  std::false_type) {
+    for (size_t i = 0; i < count; ++i) {
+        KV_Type<T>::readFromBuffer(*data++, buffer);
+        buffer += KV_Type<T>::getLength();
+    }
+}
+
+/// @endcond
+
+/// Write an array of values to the buffer, in bulk for arithmetic types.
+template <class T>
+void KV_writeArray(const T *data, size_t count, uint8_t *buffer) {
+    KV_writeArray(data, count, buffer, KV_IsBulkCopyable<T>{});
+}
+
+/// Read an array of values from the buffer, in bulk for arithmetic types.
+template <class T>
+void KV_readArray(T *data, size_t count, const uint8_t *buffer) {
+    KV_readArray(data, count, buffer, KV_IsBulkCopyable<T>{});
+}
+
+/**
+ * @brief   The type that values of type `T` are converted to when reading them
+ *          from the buffer using @ref KV_Iterator::KV::getAs, 
+ *          @ref KV_Iterator::KV::getVector etc.
+ * 
+ * This is `T` itself for most types, and `float` for the types in 
+ * @ref KV_NarrowTypes.hpp.
+ */
+template <class T>
+struct KV_ValueType {
+    using type = T;
+};
+
+/// Nested dictionaries are read as raw bytes.
+template <>
+struct KV_ValueType<KV_Dictionary> {
+    using type = uint8_t;
+};
+
+/// @cond
+
+template <class W, class T>
+void KV_writeArrayAs(const T *data, size_t count, uint8_t *buffer,
+                     std::true_type) {
+    KV_writeArray(data, count, buffer);
+}
+
+template <class W, class T>
+void KV_writeArrayAs(const T *data, size_t count, uint8_t *buffer,
+                     std::false_type) {
+    KV_Type<W>::writeArray(data, count, buffer);
+}
+
+template <class W, class T>
+void KV_readArrayAs(T *data, size_t count, const uint8_t *buffer,
+                    std::true_type) {
+    KV_readArray(data, count, buffer);
+}
+
+template <class W, class T>
+void KV_readArrayAs(T *data, size_t count, const uint8_t *buffer,
+                    std::false_type) {
+    KV_Type<W>::readArray(data, count, buffer);
+}
+
+/// @endcond
+
+/// Write an array of values to the buffer, converted to type `W`. 
+/// `KV_Type<W>` should provide a static `writeArray(const T *, size_t, 
+/// uint8_t *)` function if `W` is not the same as `T`.
+template <class W, class T>
+void KV_writeArrayAs(const T *data, size_t count, uint8_t *buffer) {
+    KV_writeArrayAs<W>(data, count, buffer, std::is_same<W, T>{});
+}
+
+/// Read an array of values of type `W` from the buffer, and convert them to
+/// `T`. `KV_Type<W>` should provide a static `readArray(T *, size_t, 
+/// const uint8_t *)` function if `W` is not the same as `T`.
+template <class W, class T>
+void KV_readArrayAs(T *data, size_t count, const uint8_t *buffer) {
+    KV_readArrayAs<W>(data, count, buffer, std::is_same<W, T>{});
+}
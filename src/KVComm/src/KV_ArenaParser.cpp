@@ -0,0 +1,48 @@
+#if !defined(ARDUINO) || defined(DOXYGEN)
+
+#include <KVComm/KV_ArenaParser.hpp> // KV_ArenaParser
+#include <KVComm/KV_Iterator.hpp>    // KV_Iterator
+
+#include <algorithm> // sort, unique, lower_bound
+#include <cstring>   // strcmp
+
+void KV_ArenaParser::reparse(const uint8_t *buffer, size_t length,
+                             KV_Iterator::Mode mode, KV_KeyTable *keys) {
+    entries.clear(); // keeps the capacity
+    if (keys)
+        keys->learn(buffer, length, mode);
+    KV_Iterator::iterator it = {buffer, length, mode, keys};
+    for (; it; ++it) {
+        // Skip key definitions and entries with unknown key IDs
+        if (keys && (it->hasType<KV_KeyDefinition>() || *it->getID() == '\0'))
+            continue;
+        entries.emplace_back(it->getID(), *it);
+    }
+    malformed = it.isMalformed();
+    // Sort by key. Entries with the same key are kept in the order they appear
+    // in the buffer (std::stable_sort would allocate a temporary buffer), so
+    // only the first one is kept, like std::map::emplace.
+    auto less = [](const entry_t &a, const entry_t &b) {
+        int cmp = std::strcmp(a.first, b.first);
+        return cmp < 0 || (cmp == 0 && a.second.getBuffer() < //
+                                           b.second.getBuffer());
+    };
+    auto equal = [](const entry_t &a, const entry_t &b) {
+        return std::strcmp(a.first, b.first) == 0;
+    };
+    std::sort(entries.begin(), entries.end(), less);
+    entries.erase(std::unique(entries.begin(), entries.end(), equal),
+                  entries.end());
+}
+
+KV_ArenaParser::const_iterator KV_ArenaParser::find(const char *key) const {
+    auto found = std::lower_bound(begin(), end(), key,
+                                  [](const entry_t &entry, const char *key) {
+                                      return std::strcmp(entry.first, key) < 0;
+                                  });
+    if (found != end() && std::strcmp(found->first, key) == 0)
+        return found;
+    return end();
+}
+
+#endif // ARDUINO
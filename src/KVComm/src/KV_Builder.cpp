@@ -4,36 +4,26 @@
 #include <KVComm/include/KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
 
 #include <AH/STL/limits> // std::numeric_limits
-#include <AH/STL/memory> // std::make_unique
-
-using AH::make_unique;
+#include <ctype.h>       // isprint
 
 #else
 
 #include <KVComm/KV_Builder.hpp>
 #include <KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
 
-#include <iomanip> // setw
+#include <cctype>  // isprint
 #include <limits>  // std::numeric_limits
-#include <memory>  // std::make_unique
 #include <ostream> // os
 
-using std::make_unique;
-
-#endif
-
-#if defined(ARDUINO) || defined(ARDUINO_TEST)
-#include <AH/PrintStream/PrintStream.hpp> // <<
 #endif
 
-uint8_t *KV_Builder::writeHeader(const char *key, uint8_t typeID,
-                                 size_t length) {
+uint8_t *KV_Builder::writeHeader(const char *key, size_t keyLen,
+                                 uint8_t typeID, size_t length) {
 
     // Ensure that the length is not too large
     if (length > std::numeric_limits<uint16_t>::max())
         return nullptr;
-    // Get the length of the key, and ensure it's not zero and not too large
-    size_t keyLen = strlen(key);
+    // Ensure that the length of the key is not zero and not too large
     if (keyLen == 0 || keyLen > std::numeric_limits<uint8_t>::max())
         return nullptr;
     // Calculate the length of the entire key-value pair
@@ -47,8 +37,9 @@ uint8_t *KV_Builder::writeHeader(const char *key, uint8_t typeID,
     bufferwritelocation[1] = typeID;
     bufferwritelocation[2] = length >> 0;
     bufferwritelocation[3] = length >> 8;
-    // Write the key
-    strcpy((char *) bufferwritelocation + 4, key);
+    // Write the key (which can be a numeric ID that contains null bytes)
+    memcpy(bufferwritelocation + 4, key, keyLen);
+    bufferwritelocation[4 + keyLen] = '\0';
     // Compute the index where the data is to be written
     size_t dataStartIndex = 4 + nextWord(keyLen);
     uint8_t *dataStart    = bufferwritelocation + dataStartIndex;
@@ -64,86 +55,219 @@ uint8_t *KV_Builder::writeHeader(const char *key, uint8_t typeID,
 
 // LCOV_EXCL_START
 
-static inline char nibbleToHex(uint8_t val) {
+namespace {
+
+inline char nibbleToHex(uint8_t val) {
     val &= 0x0F;
     return val >= 10 ? val + 'A' - 10 : val + '0';
 }
 
-template <class S>
-static inline void printHex(S &os, uint8_t val) {
-    os << nibbleToHex(val >> 4) << nibbleToHex(val);
-}
+/// Number of characters of a key that are printed in an annotation.
+constexpr uint8_t maxAnnotatedKeyLength = 32;
+/// Length of the longest line of a dump: the offset, hexadecimal and ASCII
+/// columns, followed by the longest annotation (key, type and data length),
+/// and the newline.
+constexpr size_t maxLineLength = (4 + 3 + 4 * 3 + 2 + 4 * 2) +
+                                 (4 + 1 + maxAnnotatedKeyLength + 4) +
+                                 (6 + 3 + 2 + 5 + 6) + 1;
 
-template <class S>
-void printW(S &os, unsigned u, uint8_t w, char fill = ' ') {
-    auto str    = make_unique<char[]>(w + 1);
-    str[w]      = '\0';
-    char *begin = &str[0];
-    char *end   = begin + w - 1;
-    do {
-        *end-- = u % 10 + '0';
-        u /= 10;
-    } while (u > 0 && end >= begin);
-    if (u > 0) {
-        end  = begin + w - 1;
-        fill = '*';
+/// Small buffer on the stack that collects a single line of a dump, so it can
+/// be written to the output with a single call.
+class LineBuffer {
+  public:
+    /// Append a character. The last byte is reserved for the newline, so a
+    /// line that is too long is truncated, but it is always terminated.
+    void put(char c) {
+        if (length < sizeof(line) - 1 || (c == '\n' && length < sizeof(line)))
+            line[length++] = c;
+    }
+    void put(const char *s) {
+        while (*s)
+            put(*s++);
     }
-    while (end >= begin) {
-        *end-- = fill;
+    void putHex(uint8_t val) {
+        put(nibbleToHex(val >> 4));
+        put(nibbleToHex(val));
+    }
+    /// Right-align the number in a field of the given width, or fill the
+    /// field with asterisks if it doesn't fit. A width of zero uses as many
+    /// characters as necessary.
+    void putUnsigned(unsigned long u, uint8_t width = 0) {
+        char digits[20];
+        uint8_t n = 0;
+        do {
+            digits[n++] = u % 10 + '0';
+            u /= 10;
+        } while (u > 0);
+        if (width != 0 && n > width) {
+            while (width-- > 0)
+                put('*');
+            return;
+        }
+        for (; width > n; --width)
+            put(' ');
+        while (n > 0)
+            put(digits[--n]);
+    }
+    /// Hand the line to the sink and start a new line.
+    template <class Sink>
+    void flush(Sink &sink) {
+        sink(line, length);
+        length = 0;
+    }
+
+  private:
+    char line[96];
+    uint8_t length = 0;
+
+    static_assert(sizeof(line) >= maxLineLength, "Dump lines don't fit");
+};
+
+/// Annotation of the header of an entry, e.g. `  # "key" type 9, 4 bytes`.
+void annotate(LineBuffer &line, const KV_Iterator::KV &kv) {
+    line.put("  # ");
+    if (kv.hasKeyID()) {
+        line.put("ID ");
+        line.putUnsigned(kv.getKeyID());
+    } else {
+        line.put('"');
+        const char *key = kv.getID();
+        uint8_t i       = 0;
+        for (; key[i] != '\0' && i < maxAnnotatedKeyLength; ++i)
+            line.put(key[i]);
+        line.put(key[i] == '\0' ? "\"" : "...\"");
     }
-    os << begin;
+    line.put(" type ");
+    line.putUnsigned(kv.getTypeID());
+    line.put(", ");
+    line.putUnsigned(kv.getDataLength());
+    line.put(" bytes");
 }
 
-template <class S>
-void print(const KV_Builder &dict, S &os) {
+/// Write the dump (offset + hexadecimal + ASCII) line by line to the sink.
+template <class Sink>
+void dump(const KV_Builder &dict, bool annotateEntries, Sink &sink) {
+    const uint8_t *buffer = dict.getBuffer();
+    size_t nextEntry      = 0;
+    LineBuffer line;
     for (size_t i = 0; i < dict.getLength(); i += 4) {
-        printW(os, i, 4, ' ');
-        os << "   ";
+        line.putUnsigned(i, 4);
+        line.put("   ");
         for (uint8_t j = 0; j < 4; ++j) {
-            printHex(os, dict.getBuffer()[i + j]);
-            os << ' ';
+            line.putHex(buffer[i + j]);
+            line.put(' ');
         }
-        os << "  ";
+        line.put("  ");
         for (uint8_t j = 0; j < 4; ++j) {
-            char c = isprint(dict.getBuffer()[i + j])
-                         ? (char) dict.getBuffer()[i + j]
-                         : '.';
-            os << c << ' ';
+            line.put(isprint(buffer[i + j]) ? (char) buffer[i + j] : '.');
+            line.put(' ');
         }
-        os << '\n';
+        if (annotateEntries && i == nextEntry) {
+            KV_Iterator::KV kv = buffer + i;
+            annotate(line, kv);
+            nextEntry += 4 + nextWord(kv.getIDLength()) +
+                         roundUpToWordSizeMultiple(kv.getDataLength());
+        }
+        line.put('\n');
+        line.flush(sink);
     }
 }
 
-template <class S>
-void printPython(const KV_Builder &dict, S &os) {
-    os << "bytes((\n";
+/// Write the dump as a Python bytes object line by line to the sink.
+template <class Sink>
+void dumpPython(const KV_Builder &dict, Sink &sink) {
+    const uint8_t *buffer = dict.getBuffer();
+    LineBuffer line;
+    line.put("bytes((\n");
+    line.flush(sink);
     for (size_t i = 0; i < dict.getLength(); i += 4) {
-        os << "   ";
+        line.put("   ");
         for (uint8_t j = 0; j < 4; ++j) {
-            os << " 0x";
-            printHex(os, dict.getBuffer()[i + j]);
-            os << ",";
+            line.put(" 0x");
+            line.putHex(buffer[i + j]);
+            line.put(',');
         }
-        os << '\n';
+        line.put('\n');
+        line.flush(sink);
+    }
+    line.put("))\n");
+    line.flush(sink);
+}
+
+/// Sink that copies the dump into a character buffer, and counts the total
+/// length of the dump, like `snprintf`.
+class BufferSink {
+  public:
+    BufferSink(char *buffer, size_t size) : buffer(buffer), size(size) {}
+    void operator()(const char *line, size_t length) {
+        for (size_t i = 0; i < length; ++i, ++total)
+            if (total + 1 < size)
+                buffer[total] = line[i];
     }
-    os << "))" << '\n';
+    size_t finish() const {
+        if (size > 0)
+            buffer[total < size ? total : size - 1] = '\0';
+        return total;
+    }
+
+  private:
+    char *buffer;
+    size_t size;
+    size_t total = 0;
+};
+
+} // namespace
+
+size_t KV_Builder::print(char *buffer, size_t size, bool annotate) const {
+    BufferSink sink = {buffer, size};
+    dump(*this, annotate, sink);
+    return sink.finish();
+}
+
+size_t KV_Builder::printPython(char *buffer, size_t size) const {
+    BufferSink sink = {buffer, size};
+    dumpPython(*this, sink);
+    return sink.finish();
 }
 
 #if !defined(ARDUINO) || defined(DOXYGEN)
-void KV_Builder::print(std::ostream &os) const { ::print(*this, os); }
+void KV_Builder::print(std::ostream &os, bool annotate) const {
+    auto sink = [&os](const char *line, size_t length) {
+        os.write(line, length);
+    };
+    dump(*this, annotate, sink);
+}
 void KV_Builder::printPython(std::ostream &os) const {
-    ::printPython(*this, os);
+    auto sink = [&os](const char *line, size_t length) {
+        os.write(line, length);
+    };
+    dumpPython(*this, sink);
 }
 #endif
 
 #if defined(ARDUINO) || defined(ARDUINO_TEST)
-void KV_Builder::print(Print &os) const { ::print(*this, os); }
-void KV_Builder::printPython(Print &os) const { ::printPython(*this, os); }
+void KV_Builder::print(Print &os, bool annotate) const {
+    auto sink = [&os](const char *line, size_t length) {
+        os.write(reinterpret_cast<const uint8_t *>(line), length);
+    };
+    dump(*this, annotate, sink);
+}
+void KV_Builder::printPython(Print &os) const {
+    auto sink = [&os](const char *line, size_t length) {
+        os.write(reinterpret_cast<const uint8_t *>(line), length);
+    };
+    dumpPython(*this, sink);
+}
 #endif
 
 // LCOV_EXCL_END
 
 KV_Iterator::iterator KV_Builder::find(const char *key) const {
-    KV_Iterator dict = {getBuffer(), getLength()};
+    KV_Iterator dict = {getBuffer(), getLength(), KV_Iterator::Unchecked, keys};
     return dict.find(key);
+}
+
+KV_Iterator::iterator KV_Builder::findID(uint16_t id) const {
+    KV_Iterator dict = {getBuffer(), getLength(), KV_Iterator::Unchecked, keys};
+    return dict.findID(id);
 }
\ No newline at end of file
@@ -0,0 +1,207 @@
+#ifdef ARDUINO
+
+#include <KVComm/include/KVComm/KV_Compact.hpp>
+#include <KVComm/include/KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
+#include <KVComm/include/KVComm/KV_Iterator.hpp>
+#include <KVComm/include/KVComm/KV_Types.hpp>
+
+#include <string.h> // memcpy, memset, memchr
+
+#else
+
+#include <KVComm/KV_Compact.hpp>
+#include <KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
+#include <KVComm/KV_Iterator.hpp>
+#include <KVComm/KV_Types.hpp>
+
+#include <cstring> // memcpy, memset, memchr
+
+#endif
+
+namespace {
+
+/// Returns the size of one element if the given type is encoded as varints,
+/// zero otherwise. @p isSigned is set to true for signed types.
+size_t varintElementSize(uint8_t typeID, bool &isSigned) {
+    isSigned = typeID == KV_Type<int16_t>::getTypeID() ||
+               typeID == KV_Type<int32_t>::getTypeID() ||
+               typeID == KV_Type<int64_t>::getTypeID();
+    if (typeID == KV_Type<int16_t>::getTypeID() ||
+        typeID == KV_Type<uint16_t>::getTypeID())
+        return 2;
+    if (typeID == KV_Type<int32_t>::getTypeID() ||
+        typeID == KV_Type<uint32_t>::getTypeID())
+        return 4;
+    if (typeID == KV_Type<int64_t>::getTypeID() ||
+        typeID == KV_Type<uint64_t>::getTypeID())
+        return 8;
+    return 0;
+}
+
+/// Read a little-endian integer of the given size.
+uint64_t readLE(const uint8_t *buffer, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i)
+        value |= uint64_t(buffer[i]) << (8 * i);
+    return value;
+}
+
+/// Write a little-endian integer of the given size.
+void writeLE(uint64_t value, uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+        buffer[i] = value >> (8 * i);
+}
+
+/// Sign-extend an integer of the given size to 64 bits.
+int64_t signExtend(uint64_t value, size_t size) {
+    if (size == 8)
+        return int64_t(value);
+    uint64_t signBit = uint64_t(1) << (8 * size - 1);
+    return int64_t((value ^ signBit) - signBit);
+}
+
+} // namespace
+
+KV_Result<size_t> KV_Compact::encode(const uint8_t *aligned, size_t length,
+                                     uint8_t *out, size_t outSize,
+                                     uint8_t flags) {
+    uint8_t *const begin = out;
+    uint8_t *const end   = out + outSize;
+    if (out == end)
+        return KV_Errc::BufferTooSmall;
+    *out++ = flags;
+
+    KV_Iterator::iterator it = {aligned, length, KV_Iterator::Checked};
+    for (; it; ++it) {
+        const KV_Iterator::KV &kv = *it;
+        // Header: key length, type, data length, key
+        size_t n = writeVarint(kv.getIDLength(), out, end - out);
+        if (n == 0 || out + n == end)
+            return KV_Errc::BufferTooSmall;
+        out += n;
+        *out++ = kv.getTypeID();
+        n      = writeVarint(kv.getDataLength(), out, end - out);
+        if (n == 0 || size_t(end - out - n) < kv.getIDLength())
+            return KV_Errc::BufferTooSmall;
+        out += n;
+        memcpy(out, kv.getID(), kv.getIDLength());
+        out += kv.getIDLength();
+
+        // Payload
+        bool isSigned = false;
+        size_t elementSize = (flags & VarintIntegers)
+                                 ? varintElementSize(kv.getTypeID(), isSigned)
+                                 : 0;
+        if (elementSize == 0) {
+            if (size_t(end - out) < kv.getDataLength())
+                return KV_Errc::BufferTooSmall;
+            memcpy(out, kv.getData(), kv.getDataLength());
+            out += kv.getDataLength();
+        } else {
+            if (kv.getDataLength() % elementSize != 0)
+                return KV_Errc::Malformed;
+            const uint8_t *data = kv.getData();
+            const uint8_t *dataEnd = data + kv.getDataLength();
+            for (; data != dataEnd; data += elementSize) {
+                uint64_t value = readLE(data, elementSize);
+                if (isSigned)
+                    value = zigzagEncode(signExtend(value, elementSize));
+                n = writeVarint(value, out, end - out);
+                if (n == 0)
+                    return KV_Errc::BufferTooSmall;
+                out += n;
+            }
+        }
+    }
+    if (it.isMalformed())
+        return KV_Errc::Malformed;
+    return size_t(out - begin);
+}
+
+KV_Result<size_t> KV_Compact::decode(const uint8_t *compact, size_t length,
+                                     uint8_t *out, size_t outSize) {
+    const uint8_t *in    = compact;
+    const uint8_t *inEnd = compact + length;
+    uint8_t *const begin = out;
+    uint8_t *const end   = out + outSize;
+
+    if (in == inEnd)
+        return KV_Errc::Malformed;
+    uint8_t flags = *in++;
+    if (flags & ~VarintIntegers) // unknown flags
+        return KV_Errc::Malformed;
+
+    while (in != inEnd) {
+        // Header: key length, type, data length
+        uint64_t keyLen, dataLen;
+        size_t n = readVarint(keyLen, in, inEnd - in);
+        if (n == 0 || keyLen == 0 || keyLen > 0xFF || in + n == inEnd)
+            return KV_Errc::Malformed;
+        in += n;
+        uint8_t typeID = *in++;
+        n              = readVarint(dataLen, in, inEnd - in);
+        if (n == 0 || dataLen > 0xFFFF)
+            return KV_Errc::Malformed;
+        in += n;
+        // Key (either a null-terminated string or a numeric key ID, see
+        // KV_KeyTable)
+        if (size_t(inEnd - in) < keyLen)
+            return KV_Errc::Malformed;
+        bool isKeyID = in[0] == '\0' && (keyLen == 2 || keyLen == 3);
+        if (!isKeyID && memchr(in, '\0', keyLen) != nullptr)
+            return KV_Errc::Malformed;
+        size_t entryLen = 4 + nextWord(keyLen) +
+                          roundUpToWordSizeMultiple(dataLen);
+        if (size_t(end - out) < entryLen)
+            return KV_Errc::BufferTooSmall;
+        memset(out, 0, entryLen);
+        out[0] = keyLen;
+        out[1] = typeID;
+        out[2] = dataLen >> 0;
+        out[3] = dataLen >> 8;
+        memcpy(out + 4, in, keyLen);
+        in += keyLen;
+        uint8_t *data = out + 4 + nextWord(keyLen);
+
+        // Payload
+        bool isSigned = false;
+        size_t elementSize = (flags & VarintIntegers)
+                                 ? varintElementSize(typeID, isSigned)
+                                 : 0;
+        if (elementSize == 0) {
+            if (size_t(inEnd - in) < dataLen)
+                return KV_Errc::Malformed;
+            memcpy(data, in, dataLen);
+            in += dataLen;
+        } else {
+            if (dataLen % elementSize != 0)
+                return KV_Errc::Malformed;
+            uint8_t *dataEnd = data + dataLen;
+            for (; data != dataEnd; data += elementSize) {
+                uint64_t value;
+                n = readVarint(value, in, inEnd - in);
+                if (n == 0)
+                    return KV_Errc::Malformed;
+                in += n;
+                // Zig-zag encoding maps the range of a signed element onto
+                // the range of an unsigned element of the same size, so the
+                // same check applies to both
+                if (elementSize < 8 && (value >> (8 * elementSize)) != 0)
+                    return KV_Errc::Malformed;
+                if (isSigned)
+                    value = uint64_t(zigzagDecode(value));
+                writeLE(value, data, elementSize);
+            }
+        }
+        out += entryLen;
+    }
+    // The payloads are copied as-is, so check that strings, shapes and 
+    // nested dictionaries are well-formed as well
+    if (KV_Iterator::validate(begin, out - begin) != KV_Errc::OK)
+        return KV_Errc::Malformed;
+    // Write the sentinel null byte if the buffer is not full yet, like
+    // KV_Builder does
+    if (out != end)
+        *out = 0x00;
+    return size_t(out - begin);
+}
@@ -0,0 +1,10 @@
+#ifdef ARDUINO
+#include <KVComm/include/KVComm/KV_Endian.hpp>
+#else
+#include <KVComm/KV_Endian.hpp>
+#endif
+
+void KV_Endian::swapArray(uint8_t *data, size_t elementSize, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        reverseBytes(data + i * elementSize, elementSize);
+}
@@ -2,6 +2,7 @@
 
 #include <KVComm/include/KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
 #include <KVComm/include/KVComm/KV_Iterator.hpp>
+#include <KVComm/include/KVComm/KV_KeyTable.hpp>
 
 #include <AH/STL/algorithm> // find_if
 #include <string.h>         // strlen
@@ -10,16 +11,20 @@
 
 #include <KVComm/KV_Helpers.hpp> // nextWord, roundUpToWordSizeMultiple
 #include <KVComm/KV_Iterator.hpp>
+#include <KVComm/KV_KeyTable.hpp>
 
 #include <algorithm> // find_if
 #include <cstring>   // strlen
 
 #endif
 
-KV_Iterator::iterator::iterator() : kv(nullptr), remainingBufferLength(0) {}
+KV_Iterator::iterator::iterator()
+    : kv(nullptr), remainingBufferLength(0), keys(nullptr), checked(false) {}
 
-KV_Iterator::iterator::iterator(const uint8_t *buffer, size_t length)
-    : kv(buffer), remainingBufferLength(length) {
+KV_Iterator::iterator::iterator(const uint8_t *buffer, size_t length,
+                                Mode mode, const KV_KeyTable *keys)
+    : kv(buffer), remainingBufferLength(length), keys(keys),
+      checked(mode == Checked) {
     checkLength();
 }
 
@@ -50,7 +55,61 @@ void KV_Iterator::iterator::checkLength() {
     } else if (!kv || kv.getIDLength() == 0) {
         remainingBufferLength = 0;
         kv                    = nullptr;
+    } else if (checked && !checkEntry()) {
+        malformed             = true;
+        remainingBufferLength = 0;
+        kv                    = nullptr;
+    } else if (keys && kv.hasKeyID()) {
+        const char *key = keys->resolve(kv.getKeyID());
+        kv              = {kv.getBuffer(), key ? key : kv.getID()};
+    }
+}
+
+bool KV_Iterator::iterator::checkEntry() const {
+    // The header itself has to fit
+    if (remainingBufferLength < 4)
+        return false;
+    // The entire entry (header, key, padding, data) has to fit
+    size_t totalLength = 4 + nextWord(kv.getIDLength()) +
+                         roundUpToWordSizeMultiple(kv.getDataLength());
+    if (totalLength > remainingBufferLength)
+        return false;
+    // The key has to be null-terminated
+    if (kv.getBuffer()[4 + kv.getIDLength()] != '\0')
+        return false;
+    // Keys can only be empty if they're numeric IDs
+    if (kv.getID()[0] == '\0' && !kv.hasKeyID())
+        return false;
+    // Shape headers have to fit, and have a supported rank
+    if (kv.hasShape())
+        return kv.getDataLength() >= 2 && kv.getRank() > 0 &&
+               kv.getRank() <= KV_Shape::MaxRank &&
+               KV_Shape::headerSize(kv.getRank()) <= kv.getDataLength();
+    // Strings have to be null-terminated
+    if (kv.hasType<char>())
+        return kv.getDataLength() > 0 &&
+               kv.getData()[kv.getDataLength() - 1] == '\0';
+    return true;
+}
+
+constexpr uint8_t KV_Iterator::MaxNestingDepth;
+
+KV_Errc KV_Iterator::validate(const uint8_t *buffer, size_t length) {
+    return validate(buffer, length, MaxNestingDepth);
+}
+
+KV_Errc KV_Iterator::validate(const uint8_t *buffer, size_t length,
+                              uint8_t depth) {
+    iterator it = {buffer, length, Checked};
+    for (; it; ++it) {
+        if (!it->isDictionary())
+            continue;
+        if (depth == 0 ||
+            validate(it->getData(), it->getDataLength(), depth - 1) !=
+                KV_Errc::OK)
+            return KV_Errc::Malformed;
     }
+    return it.isMalformed() ? KV_Errc::Malformed : KV_Errc::OK;
 }
 
 // #if !defined(ARDUINO) || defined(DOXYGEN)
@@ -103,8 +162,69 @@ const char *KV_Iterator::KV::getString() const {
     return reinterpret_cast<const char *>(getData());
 }
 
+KV_Errc KV_Iterator::KV::getShape(uint16_t *shape, uint8_t &rank,
+                                   const uint8_t *&elements,
+                                   size_t elementLength) const {
+    size_t length       = getDataLength();
+    const uint8_t *data = getData();
+    // Entries without a shape header are one-dimensional arrays
+    if (!hasShape()) {
+        if (length % elementLength != 0)
+            return KV_Errc::IncorrectLength;
+        rank     = 1;
+        shape[0] = length / elementLength;
+        elements = data;
+        return KV_Errc::OK;
+    }
+    if (length < 2)
+        return KV_Errc::Malformed;
+    rank = data[0];
+    if (rank == 0 || rank > KV_Shape::MaxRank ||
+        KV_Shape::headerSize(rank) > length)
+        return KV_Errc::Malformed;
+    size_t headerSize = KV_Shape::headerSize(rank);
+    // The number of elements can't exceed the length of the data, checking
+    // this after every dimension prevents overflow
+    size_t count = 1;
+    for (uint8_t i = 0; i < rank; ++i) {
+        shape[i] = data[2 + 2 * i] | (data[3 + 2 * i] << 8);
+        count *= shape[i];
+        if (count > length)
+            return KV_Errc::Malformed;
+    }
+    if (count * elementLength != length - headerSize)
+        return KV_Errc::Malformed;
+    elements = data + headerSize;
+    return KV_Errc::OK;
+}
+
+KV_Iterator KV_Iterator::KV::getDictionary(Mode mode,
+                                           const KV_KeyTable *keys) const {
+    if (!*this) {
+        KV_ERROR(F("Trying to extract data from non-existent entry"), 0x7566);
+        return {}; // LCOV_EXCL_LINE
+    }
+    if (!checkType<KV_Dictionary>())
+        return {}; // LCOV_EXCL_LINE
+    return {getData(), getDataLength(), mode, keys};
+}
+
+KV_Result<KV_Iterator>
+KV_Iterator::KV::tryGetDictionary(Mode mode, const KV_KeyTable *keys) const {
+    KV_Errc errc = checkAccess<KV_Dictionary>();
+    if (errc != KV_Errc::OK)
+        return errc;
+    return KV_Iterator(getData(), getDataLength(), mode, keys);
+}
+
 KV_Iterator::iterator KV_Iterator::find(const char *key) const {
     return std::find_if(begin(), end(), [key](KV_Iterator::KV kv) {
         return strcmp(kv.getID(), key) == 0;
     });
+}
+
+KV_Iterator::iterator KV_Iterator::findID(uint16_t id) const {
+    return std::find_if(begin(), end(), [id](KV_Iterator::KV kv) {
+        return kv.hasKeyID() && kv.getKeyID() == id;
+    });
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifdef ARDUINO
+
+#include <KVComm/include/KVComm/KV_Builder.hpp>
+#include <KVComm/include/KVComm/KV_KeyTable.hpp>
+
+#include <string.h> // strcmp, strlen, memcpy
+
+#else
+
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_KeyTable.hpp>
+
+#include <cstring> // strcmp, strlen, memcpy
+
+#endif
+
+KV_Result<uint16_t> KV_KeyTable::lookup(const char *key) const {
+    for (size_t id = 0; id < keys.size(); ++id)
+        if (keys[id] != nullptr &&
+            (keys[id] == key || strcmp(keys[id], key) == 0))
+            return uint16_t(id);
+    return KV_Errc::NonExistentEntry;
+}
+
+void KV_KeyTable::define(uint16_t id, const char *key) {
+    // Definitions are sent periodically, don't copy keys that are known
+    if (id < keys.size() && keys[id] != nullptr && strcmp(keys[id], key) == 0)
+        return;
+    if (id >= keys.size())
+        keys.resize(size_t(id) + 1, nullptr);
+    if (id >= storage.size())
+        storage.resize(size_t(id) + 1);
+    // Replaces (and frees) the previous copy of this ID, if any
+    size_t length = strlen(key) + 1;
+    storage[id].reset(new char[length]);
+    memcpy(storage[id].get(), key, length);
+    keys[id] = storage[id].get();
+}
+
+size_t KV_KeyTable::learn(const uint8_t *buffer, size_t length,
+                          KV_Iterator::Mode mode) {
+    size_t count = 0;
+    for (auto &entry : KV_Iterator(buffer, length, mode)) {
+        if (!entry.hasType<KV_KeyDefinition>() || entry.hasKeyID() ||
+            entry.getDataLength() != KV_Type<KV_KeyDefinition>::getLength())
+            continue;
+        uint16_t id = entry.getAs<KV_KeyDefinition>().id;
+        if (id > maxID)
+            continue;
+        define(id, entry.getID());
+        ++count;
+    }
+    return count;
+}
+
+bool KV_KeyTable::writeDefinitions(KV_Builder &dict) const {
+    for (size_t id = 0; id < keys.size(); ++id)
+        if (keys[id] != nullptr &&
+            !dict.add(keys[id], KV_KeyDefinition{uint16_t(id)}))
+            return false;
+    return true;
+}
+
+void KV_KeyTable::clear() {
+    keys.clear();
+    storage.clear();
+}
@@ -0,0 +1,40 @@
+#ifdef ARDUINO
+#include <KVComm/include/KVComm/KV_NarrowTypes.hpp>
+#else
+#include <KVComm/KV_NarrowTypes.hpp>
+#endif
+
+#if defined(__F16C__) && !KV_BIG_ENDIAN
+#include <immintrin.h> // _mm_cvtps_ph, _mm_cvtph_ps
+#endif
+
+void KV_Type<KV_Float16>::writeArray(const float *data, size_t count,
+                                     uint8_t *buffer) {
+    size_t i = 0;
+#if defined(__F16C__) && !KV_BIG_ENDIAN
+    for (; i + 4 <= count; i += 4) {
+        __m128 f  = _mm_loadu_ps(data + i);
+        __m128i h = _mm_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(buffer + 2 * i), h);
+    }
+#endif
+    for (; i < count; ++i)
+        KV_Endian::toWire(KV_Float16::fromFloat(data[i]), buffer + 2 * i);
+}
+
+void KV_Type<KV_Float16>::readArray(float *data, size_t count,
+                                    const uint8_t *buffer) {
+    size_t i = 0;
+#if defined(__F16C__) && !KV_BIG_ENDIAN
+    for (; i + 4 <= count; i += 4) {
+        __m128i h = _mm_loadl_epi64(
+            reinterpret_cast<const __m128i *>(buffer + 2 * i));
+        _mm_storeu_ps(data + i, _mm_cvtph_ps(h));
+    }
+#endif
+    for (; i < count; ++i) {
+        uint16_t h;
+        KV_Endian::fromWire(h, buffer + 2 * i);
+        data[i] = KV_Float16::toFloat(h);
+    }
+}
@@ -6,10 +6,16 @@
 #include <cstring>  // strcmp
 #include <iostream> // cout
 
-KV_Parser::map_t KV_Parser::parse(const uint8_t *buffer, size_t length) {
+KV_Parser::map_t KV_Parser::parse(const uint8_t *buffer, size_t length,
+                                  KV_Iterator::Mode mode, KV_KeyTable *keys) {
     map_t parseResult{};
-    for (auto &entry : KV_Iterator(buffer, length)) {
+    if (keys)
+        keys->learn(buffer, length, mode);
+    for (auto &entry : KV_Iterator(buffer, length, mode, keys)) {
         const char *identifier = entry.getID();
+        // Skip key definitions and entries with unknown key IDs
+        if (keys && (entry.hasType<KV_KeyDefinition>() || *identifier == '\0'))
+            continue;
         parseResult.emplace(std::make_pair(identifier, entry));
     }
     return parseResult;
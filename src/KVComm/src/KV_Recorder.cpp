@@ -0,0 +1,76 @@
+#ifdef ARDUINO
+
+#include <KVComm/include/KVComm/KV_Iterator.hpp>
+#include <KVComm/include/KVComm/KV_Recorder.hpp>
+
+#include <string.h> // memcpy, memcmp
+
+#else
+
+#include <KVComm/KV_Iterator.hpp>
+#include <KVComm/KV_Recorder.hpp>
+
+#include <cstring> // memcpy, memcmp
+
+#endif
+
+bool KV_Recorder::setLayout(const uint8_t *buffer, size_t length) {
+    size_t headers = 0, data = 0;
+    for (auto &kv : KV_Iterator(buffer, length)) {
+        headers += kv.getData() - kv.getBuffer();
+        data += roundUpToWordSizeMultiple(kv.getDataLength());
+    }
+    if (data == 0 || headers + data > storageSize)
+        return false;
+    uint8_t *layout = storage;
+    for (auto &kv : KV_Iterator(buffer, length)) {
+        size_t headerLength = kv.getData() - kv.getBuffer();
+        memcpy(layout, kv.getBuffer(), headerLength);
+        layout += headerLength;
+    }
+    layoutLength = headers;
+    recordLength = data;
+    maxCount     = (storageSize - headers) / data;
+    head = count = 0;
+    return true;
+}
+
+bool KV_Recorder::matchesLayout(const uint8_t *buffer, size_t length) const {
+    if (length != getFrameLength())
+        return false;
+    const uint8_t *layout = storage;
+    for (auto &kv : KV_Iterator(buffer, length)) {
+        size_t headerLength = kv.getData() - kv.getBuffer();
+        if (layout + headerLength > storage + layoutLength ||
+            memcmp(layout, kv.getBuffer(), headerLength) != 0)
+            return false;
+        layout += headerLength;
+    }
+    return layout == storage + layoutLength;
+}
+
+bool KV_Recorder::record(const uint8_t *buffer, size_t length) {
+    if (maxCount == 0 ? !setLayout(buffer, length)
+                      : !matchesLayout(buffer, length))
+        return false;
+    uint8_t *slot = storage + layoutLength + head * recordLength;
+    for (auto &kv : KV_Iterator(buffer, length)) {
+        size_t dataLength = roundUpToWordSizeMultiple(kv.getDataLength());
+        memcpy(slot, kv.getData(), dataLength);
+        slot += dataLength;
+    }
+    head = (head + 1) % maxCount;
+    if (count < maxCount)
+        ++count;
+    return true;
+}
+
+bool KV_Recorder::copySnapshot(size_t index, uint8_t *out) const {
+    if (index >= count)
+        return false;
+    forEachSegment(index, [&out](const uint8_t *data, size_t length) {
+        memcpy(out, data, length);
+        out += length;
+    });
+    return true;
+}
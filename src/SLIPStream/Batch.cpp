@@ -0,0 +1,24 @@
+#include <SLIPStream/Batch.hpp>
+
+BatchReader::BatchReader(const uint8_t *packet, size_t size) : packet(packet) {
+    using namespace Batch_Constants;
+    if (size < HEADER_SIZE || packet[1] != 0x00)
+        return;
+    size_t dirSize = directorySize(packet[0]);
+    if (dirSize > size)
+        return;
+    size_t total = dirSize;
+    for (uint8_t i = 0; i < packet[0]; ++i)
+        total += pad(length(i));
+    if (total != size)
+        return;
+    records = packet + dirSize;
+    valid   = true;
+}
+
+BatchReader::Record BatchReader::operator[](uint8_t index) const {
+    const uint8_t *data = records;
+    for (uint8_t i = 0; i < index; ++i)
+        data += Batch_Constants::pad(length(i));
+    return {data, length(index)};
+}
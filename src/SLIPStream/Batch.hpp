@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t, uint16_t
+
+/// @addtogroup SLIP
+/// @{
+
+/**
+ * @brief   Constants for batched packets, see @ref BatchSender.
+ *
+ * A batched packet starts with a directory that contains the number of
+ * records and the length of each record, followed by the records themselves:
+ *
+ * ~~~
+ * +-------+------+-------+-----+-------+---------+----------+-----+
+ * | count | 0x00 | len 0 | ... | len N | padding | record 0 | ... |
+ * +-------+------+-------+-----+-------+---------+----------+-----+
+ *   1 B     1 B    2 B LE                 to 4 B
+ * ~~~
+ *
+ * Every record is padded to a multiple of four bytes as well, so if the
+ * packet buffer is aligned, all records are aligned.
+ */
+namespace Batch_Constants {
+/// The size of the directory without the record lengths.
+const static uint8_t HEADER_SIZE = 2;
+/// The maximum number of records in a single packet.
+const static uint8_t MAX_RECORDS = 255;
+/// Round up a size to a multiple of four bytes.
+inline size_t pad(size_t size) { return (size + 3) & ~size_t(3); }
+/// The size of the directory (including padding) for the given number of
+/// records.
+inline size_t directorySize(uint8_t count) {
+    return pad(HEADER_SIZE + 2 * size_t(count));
+}
+} // namespace Batch_Constants
+
+/// Conditions that cause a @ref BatchSender to send its records. A value of
+/// zero disables that condition.
+struct BatchPolicy {
+    /// Send the batch when it contains this many records.
+    uint8_t maxRecords = 0;
+    /// Send the batch when the records take up at least this many bytes
+    /// (including padding).
+    uint16_t maxBytes = 0;
+    /// Send the batch when its first record is older than this (in the same
+    /// unit as the timestamps passed to the sender, e.g. milliseconds).
+    unsigned long maxAge = 0;
+};
+
+/**
+ * @brief   Class for reading the records of a batched packet, without looking
+ *          at the records themselves.
+ *
+ * Only the directory is parsed. The records are not copied, so the packet
+ * buffer has to outlive the reader.
+ */
+class BatchReader {
+  public:
+    /// A single record in the packet.
+    struct Record {
+        const uint8_t *data;
+        size_t length;
+    };
+
+    /// Iterator over the records in the packet.
+    class iterator {
+      public:
+        iterator(const BatchReader *reader, uint8_t index, const uint8_t *data)
+            : reader(reader), index(index), data(data) {}
+        Record operator*() const { return {data, reader->length(index)}; }
+        iterator &operator++() {
+            data += Batch_Constants::pad(reader->length(index++));
+            return *this;
+        }
+        bool operator!=(const iterator &other) const {
+            return index != other.index;
+        }
+
+      private:
+        const BatchReader *reader;
+        uint8_t index;
+        const uint8_t *data;
+    };
+
+    /**
+     * @brief   Constructor.
+     *
+     * @param   packet
+     *          The received packet (without framing and checksum).
+     * @param   size
+     *          The size of the received packet.
+     */
+    BatchReader(const uint8_t *packet, size_t size);
+
+    /**
+     * @brief   Check that the directory fits the packet, and that the lengths
+     *          of the records add up to the size of the packet.
+     *
+     * If the packet is not valid, the reader contains no records.
+     */
+    bool isValid() const { return valid; }
+
+    /// Get the number of records in the packet.
+    uint8_t size() const { return valid ? packet[0] : 0; }
+
+    /// Get the length of the record with the given index.
+    size_t length(uint8_t index) const {
+        const uint8_t *len = packet + Batch_Constants::HEADER_SIZE + 2 * index;
+        return len[0] | (len[1] << 8);
+    }
+
+    /// Get the record with the given index. Iterating over the records is
+    /// faster than random access.
+    Record operator[](uint8_t index) const;
+
+    iterator begin() const { return {this, 0, records}; }
+    iterator end() const { return {this, size(), nullptr}; }
+
+  private:
+    const uint8_t *packet;
+    const uint8_t *records = nullptr;
+    bool valid             = false;
+};
+
+/// @}
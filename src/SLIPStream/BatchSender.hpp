@@ -0,0 +1,132 @@
+#pragma once
+
+#include <AH/STL/utility> // std::forward
+#include <stddef.h>       // size_t
+
+#include <SLIPStream/Batch.hpp>
+
+/// @addtogroup SLIP
+/// @{
+
+/**
+ * @brief   Stage in front of a packet sender that collects multiple small
+ *          records (e.g. the buffers of KV_Builder snapshots) into a single
+ *          packet.
+ *
+ * This saves the framing and checksum overhead of every record except for
+ * the first, and the receiver can handle all records after reading a single
+ * packet. The packet starts with a directory of record lengths (see
+ * @ref Batch_Constants), so the receiver can iterate over the records using a
+ * @ref BatchReader without parsing them.
+ *
+ * Records are buffered until the @ref BatchPolicy says that the batch should
+ * be sent, until the next record doesn't fit the buffer, or until
+ * @ref flush is called.
+ *
+ * @tparam  PacketSender
+ *          The sender for the batched packets, with `beginPacket`, `write`
+ *          and `endPacket` member functions, for example @ref SLIPSenderCRC
+ *          or a reference to a @ref SLIPStreamCRC.
+ * @tparam  BufferSize
+ *          The size of the buffer for the records (including padding).
+ * @tparam  MaxRecords
+ *          The maximum number of records in a single packet.
+ */
+template <class PacketSender, size_t BufferSize = 256, uint8_t MaxRecords = 16>
+class BatchSender {
+    static_assert(MaxRecords > 0, "Batches should contain at least one record");
+
+  public:
+    /**
+     * @brief   Default constructor.
+     */
+    BatchSender() = default;
+    /**
+     * @brief   Constructor with sender initialization.
+     *
+     * @param   sender
+     *          Initialization for the packet sender. Perfect forwarding is
+     *          used.
+     * @param   policy
+     *          When to send the batch.
+     */
+    BatchSender(PacketSender &&sender, BatchPolicy policy = {})
+        : sender(std::forward<PacketSender>(sender)), policy(policy) {}
+
+    /**
+     * @brief   Add a record to the batch.
+     *
+     * If the record doesn't fit the buffer, the current batch is sent first.
+     * Records that are larger than the buffer are sent on their own,
+     * without buffering them. Afterwards, the batch is sent if the policy
+     * says so.
+     *
+     * @param   data
+     *          The record to add.
+     * @param   len
+     *          The length of the record (at most 65535 bytes).
+     * @param   now
+     *          The current time, only used for the @ref BatchPolicy::maxAge
+     *          "maxAge" policy, e.g. `millis()`.
+     * @return  The number of bytes sent by the packet sender.
+     */
+    size_t add(const uint8_t *data, size_t len, unsigned long now = 0);
+
+    /**
+     * @brief   Send the batch if its first record is older than the maximum
+     *          age of the policy. Call this regularly.
+     *
+     * @param   now
+     *          The current time, e.g. `millis()`.
+     * @return  The number of bytes sent by the packet sender.
+     */
+    size_t update(unsigned long now) {
+        bool tooOld = policy.maxAge != 0 && count > 0 &&
+                      now - firstTimestamp >= policy.maxAge;
+        return tooOld ? flush() : 0;
+    }
+
+    /**
+     * @brief   Send all buffered records as a single packet.
+     *
+     * Does nothing if the batch is empty.
+     *
+     * @return  The number of bytes sent by the packet sender.
+     */
+    size_t flush();
+
+    /// Get the number of records in the current batch.
+    uint8_t getRecordCount() const { return count; }
+    /// Get the number of bytes buffered for the current batch (including
+    /// padding, excluding the directory).
+    size_t getBufferedLength() const { return used; }
+
+    /// Get the policy that decides when batches are sent.
+    const BatchPolicy &getPolicy() const { return policy; }
+    /// Set the policy that decides when batches are sent.
+    void setPolicy(BatchPolicy policy) { this->policy = policy; }
+
+  private:
+    /// Check whether the policy says that the batch should be sent.
+    bool full() const {
+        return count == MaxRecords || count == Batch_Constants::MAX_RECORDS ||
+               (policy.maxRecords != 0 && count >= policy.maxRecords) ||
+               (policy.maxBytes != 0 && used >= policy.maxBytes);
+    }
+    /// Send a packet with the given directory and records.
+    size_t send(const uint16_t *lengths, uint8_t count, const uint8_t *data,
+                size_t size);
+
+  private:
+    PacketSender sender;
+    BatchPolicy policy;
+    uint8_t buffer[BufferSize];
+    uint16_t lengths[MaxRecords];
+    size_t used                  = 0;
+    uint8_t count                = 0;
+    unsigned long firstTimestamp = 0;
+};
+
+/// @}
+
+#include "BatchSender.ipp"
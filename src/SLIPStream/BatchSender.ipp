@@ -0,0 +1,60 @@
+#include "BatchSender.hpp"
+
+#include <string.h> // memcpy, memset
+
+template <class PacketSender, size_t BufferSize, uint8_t MaxRecords>
+size_t BatchSender<PacketSender, BufferSize, MaxRecords>::add(
+    const uint8_t *data, size_t len, unsigned long now) {
+    using Batch_Constants::pad;
+    if (len > 0xFFFF)
+        return 0;
+    size_t sent = 0;
+    if (used + pad(len) > BufferSize)
+        sent += flush();
+    // Records that are too large for the buffer are sent on their own
+    if (pad(len) > BufferSize) {
+        uint16_t length = len;
+        return sent + send(&length, 1, data, len);
+    }
+    if (count == 0)
+        firstTimestamp = now;
+    memcpy(buffer + used, data, len);
+    memset(buffer + used + len, 0, pad(len) - len);
+    lengths[count++] = len;
+    used += pad(len);
+    if (full())
+        sent += flush();
+    return sent;
+}
+
+template <class PacketSender, size_t BufferSize, uint8_t MaxRecords>
+size_t BatchSender<PacketSender, BufferSize, MaxRecords>::flush() {
+    if (count == 0)
+        return 0;
+    size_t sent = send(lengths, count, buffer, used);
+    count       = 0;
+    used        = 0;
+    return sent;
+}
+
+template <class PacketSender, size_t BufferSize, uint8_t MaxRecords>
+size_t BatchSender<PacketSender, BufferSize, MaxRecords>::send(
+    const uint16_t *lengths, uint8_t count, const uint8_t *data, size_t size) {
+    using namespace Batch_Constants;
+    size_t sent = sender.beginPacket();
+    // Directory
+    uint8_t header[HEADER_SIZE] = {count, 0x00};
+    sent += sender.write(header, HEADER_SIZE);
+    for (uint8_t i = 0; i < count; ++i) {
+        uint8_t length[2] = {uint8_t(lengths[i] >> 0),
+                             uint8_t(lengths[i] >> 8)};
+        sent += sender.write(length, 2);
+    }
+    const uint8_t zeros[3] = {};
+    size_t dirSize         = HEADER_SIZE + 2 * size_t(count);
+    sent += sender.write(zeros, pad(dirSize) - dirSize);
+    // Records
+    sent += sender.write(data, size);
+    sent += sender.write(zeros, pad(size) - size);
+    return sent + sender.endPacket();
+}
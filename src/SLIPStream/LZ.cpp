@@ -0,0 +1,76 @@
+#include "LZ.hpp"
+
+#include <string.h> // memcpy
+
+namespace {
+
+/// Reads bits from a buffer, most significant bit first.
+class BitReader {
+  public:
+    BitReader(const uint8_t *data, size_t size)
+        : data(data), bitsLeft(size * 8) {}
+
+    size_t remaining() const { return bitsLeft; }
+
+    uint16_t read(uint8_t bits) {
+        uint16_t value = 0;
+        while (bits--) {
+            uint8_t bit = (*data >> (--bitsLeft % 8)) & 1;
+            if (bitsLeft % 8 == 0)
+                ++data;
+            value = (value << 1) | bit;
+        }
+        return value;
+    }
+
+  private:
+    const uint8_t *data;
+    size_t bitsLeft;
+};
+
+} // namespace
+
+size_t LZ_unpack(const uint8_t *packet, size_t size, uint8_t *out,
+                 size_t outSize) {
+    using namespace LZ_Constants;
+    if (size == 0)
+        return 0;
+    uint8_t flag = packet[0];
+    ++packet, --size;
+
+    if (flag == RAW) {
+        if (size > outSize)
+            return 0;
+        memcpy(out, packet, size);
+        return size;
+    }
+
+    uint8_t windowBits    = flag & 0x0F;
+    uint8_t lookaheadBits = (flag >> 4) & 0x07;
+    if (!(flag & COMPRESSED) || windowBits <= lookaheadBits ||
+        windowBits + lookaheadBits < 7)
+        return 0;
+
+    BitReader bits = {packet, size};
+    size_t written = 0;
+    while (bits.remaining() > 0) {
+        bool literal = bits.read(1);
+        // The remaining bits are padding if they don't contain a full token
+        if (bits.remaining() < (literal ? 8u : windowBits + lookaheadBits))
+            break;
+        if (literal) {
+            if (written == outSize)
+                return 0;
+            out[written++] = bits.read(8);
+        } else {
+            size_t offset = bits.read(windowBits) + 1;
+            size_t length = bits.read(lookaheadBits) + MIN_MATCH_LENGTH;
+            if (offset > written || length > outSize - written)
+                return 0;
+            // Byte by byte, because the source may overlap with the output
+            for (size_t i = 0; i < length; ++i, ++written)
+                out[written] = out[written - offset];
+        }
+    }
+    return written;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stddef.h> // size_t
+#include <stdint.h> // uint8_t, uint32_t
+
+/// @addtogroup SLIP
+/// @{
+
+/**
+ * @brief   Constants for the LZ compression stage.
+ *
+ * Every packet sent by an @ref LZSender starts with a flag byte. A flag of
+ * @ref RAW means that the rest of the packet is not compressed. Compressed
+ * packets have the @ref COMPRESSED bit set, the lower four bits contain the
+ * base-two logarithm of the window size, and bits 4 to 6 contain the base-two
+ * logarithm of the lookahead size. This means that the receiver doesn't need
+ * to know the compression parameters in advance.
+ *
+ * The compressed data is a stream of bits (most significant bit first):
+ *
+ * - `1` followed by 8 bits: literal byte
+ * - `0` followed by `WindowBits` bits containing the offset minus one, and
+ *   `LookaheadBits` bits containing the length minus
+ *   @ref MIN_MATCH_LENGTH: copy of earlier data
+ *
+ * The last byte is padded with zeros.
+ */
+namespace LZ_Constants {
+/// Flag for packets that are not compressed.
+const static uint8_t RAW = 0x00;
+/// Flag bit for packets that are compressed.
+const static uint8_t COMPRESSED = 0x80;
+/// Shorter matches are sent as literals.
+const static uint8_t MIN_MATCH_LENGTH = 2;
+} // namespace LZ_Constants
+
+/// Compression statistics kept by @ref LZSender.
+struct LZStatistics {
+    /// Number of payload bytes passed to the compression stage.
+    uint32_t uncompressed = 0;
+    /// Number of bytes passed to the packet sender, including flag bytes.
+    uint32_t compressed = 0;
+    /// Number of bytes saved by compression (negative if data grew).
+    int32_t bytesSaved() const { return int32_t(uncompressed - compressed); }
+};
+
+/**
+ * @brief   Decompress a packet sent by an @ref LZSender.
+ *
+ * Packets with the @ref LZ_Constants::RAW "RAW" flag are copied as-is.
+ * The output buffer is used as the history window, so decompression doesn't
+ * require any additional RAM.
+ *
+ * @param   packet
+ *          The received packet, including the flag byte.
+ * @param   size
+ *          The size of the received packet.
+ * @param   out
+ *          The buffer to write the decompressed data to. Must not overlap with
+ *          @p packet.
+ * @param   outSize
+ *          The size of the output buffer.
+ * @return  The number of decompressed bytes written to @p out, or zero if the
+ *          packet is malformed, or if the data doesn't fit the output buffer.
+ */
+size_t LZ_unpack(const uint8_t *packet, size_t size, uint8_t *out,
+                 size_t outSize);
+
+/// @}
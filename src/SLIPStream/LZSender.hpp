@@ -0,0 +1,127 @@
+#pragma once
+
+#include <AH/STL/utility> // std::forward
+#include <stddef.h>       // size_t
+
+#include <SLIPStream/LZ.hpp>
+
+/// @addtogroup SLIP
+/// @{
+
+/**
+ * @brief   Compression stage in front of a packet sender, using a small-window
+ *          streaming LZ compressor (similar to heatshrink).
+ *
+ * Data is compressed while it is written, so the packet never has to be
+ * buffered completely. The only RAM required is the window of
+ * 2<sup>WindowBits</sup> bytes.
+ *
+ * Each packet starts with a flag byte (see @ref LZ_Constants), so compressed
+ * and uncompressed packets can be mixed. Use @ref LZ_unpack on the receiving
+ * side.
+ *
+ * @tparam  PacketSender
+ *          The sender for the (compressed) packets, with `beginPacket`,
+ *          `write` and `endPacket` member functions, for example
+ *          @ref SLIPSenderCRC or a reference to a @ref SLIPStreamCRC.
+ * @tparam  WindowBits
+ *          Base-two logarithm of the window size, i.e. how far back the
+ *          compressor looks for repeated data.
+ * @tparam  LookaheadBits
+ *          Base-two logarithm of the number of different match lengths.
+ */
+template <class PacketSender, uint8_t WindowBits = 8, uint8_t LookaheadBits = 4>
+class LZSender {
+    static_assert(WindowBits <= 15 && LookaheadBits <= 7,
+                  "Window and lookahead sizes don't fit the flag byte");
+    static_assert(WindowBits > LookaheadBits,
+                  "Window should be larger than the lookahead");
+    static_assert(WindowBits + LookaheadBits >= 7,
+                  "Matches should be longer than the padding");
+
+  public:
+    /// The size of the window in bytes.
+    constexpr static uint16_t WindowSize = 1u << WindowBits;
+    /// The longest match that can be encoded.
+    constexpr static uint8_t MaxMatchLength =
+        (1u << LookaheadBits) + LZ_Constants::MIN_MATCH_LENGTH - 1;
+
+    /**
+     * @brief   Default constructor.
+     */
+    LZSender() = default;
+    /**
+     * @brief   Constructor with sender initialization.
+     *
+     * @param   sender
+     *          Initialization for the packet sender. Perfect forwarding is
+     *          used.
+     */
+    LZSender(PacketSender &&sender)
+        : sender(std::forward<PacketSender>(sender)) {}
+
+    /**
+     * @brief   Start a packet.
+     *
+     * @param   compress
+     *          Whether to compress the data of this packet. Data that is
+     *          known not to compress well can be sent uncompressed, which only
+     *          costs the single flag byte.
+     * @return  The number of bytes sent by the packet sender.
+     */
+    size_t beginPacket(bool compress = true);
+    /**
+     * @brief   Write some data as the body of a packet.
+     *
+     * Some of the data may only be sent by later calls to write or by
+     * @ref endPacket.
+     *
+     * @return  The number of bytes sent by the packet sender.
+     */
+    size_t write(const uint8_t *data, size_t len);
+    /**
+     * @brief   Compress the remaining data, and finish the packet.
+     *
+     * @return  The number of bytes sent by the packet sender.
+     */
+    size_t endPacket();
+
+    /// Send a complete packet.
+    size_t writePacket(const uint8_t *data, size_t len, bool compress = true) {
+        size_t sent = beginPacket(compress);
+        sent += write(data, len);
+        return sent + endPacket();
+    }
+
+    /// Get the compression statistics since construction or the last reset.
+    const LZStatistics &getStatistics() const { return stats; }
+    /// Reset the compression statistics to zero.
+    void resetStatistics() { stats = {}; }
+
+  private:
+    /// Encode the longest match at the current position, or a literal.
+    size_t step();
+    /// Append bits to the output, most significant bit first.
+    size_t emit(uint16_t value, uint8_t bits);
+
+    constexpr static uint16_t Mask = WindowSize - 1;
+
+  private:
+    PacketSender sender;
+    LZStatistics stats;
+    /// History and lookahead, indexed modulo the window size.
+    uint8_t window[WindowSize];
+    /// Index of the next byte to be written to the window.
+    uint16_t head = 0;
+    /// Index of the next byte to be encoded.
+    uint16_t pos = 0;
+    /// Number of encoded bytes in the window that can be referred to.
+    uint16_t history = 0;
+    uint8_t bitBuffer = 0;
+    uint8_t bitCount  = 0;
+    bool compressing  = false;
+};
+
+/// @}
+
+#include "LZSender.ipp"
@@ -0,0 +1,108 @@
+#include "LZSender.hpp"
+
+template <class PacketSender, uint8_t WindowBits, uint8_t LookaheadBits>
+size_t
+LZSender<PacketSender, WindowBits, LookaheadBits>::beginPacket(bool compress) {
+    using namespace LZ_Constants;
+    head        = 0;
+    pos         = 0;
+    history     = 0;
+    bitBuffer   = 0;
+    bitCount    = 0;
+    compressing = compress;
+    uint8_t flag =
+        compress ? COMPRESSED | (LookaheadBits << 4) | WindowBits : RAW;
+    ++stats.compressed;
+    size_t sent = sender.beginPacket();
+    return sent + sender.write(&flag, 1);
+}
+
+template <class PacketSender, uint8_t WindowBits, uint8_t LookaheadBits>
+size_t LZSender<PacketSender, WindowBits, LookaheadBits>::write(
+    const uint8_t *data, size_t len) {
+    stats.uncompressed += len;
+    if (!compressing) {
+        stats.compressed += len;
+        return sender.write(data, len);
+    }
+    size_t sent = 0;
+    while (len--) {
+        window[head++ & Mask] = *data++;
+        if (uint16_t(head - pos) == MaxMatchLength)
+            sent += step();
+    }
+    return sent;
+}
+
+template <class PacketSender, uint8_t WindowBits, uint8_t LookaheadBits>
+size_t LZSender<PacketSender, WindowBits, LookaheadBits>::endPacket() {
+    size_t sent = 0;
+    if (compressing) {
+        while (pos != head)
+            sent += step();
+        // Pad the last byte with zeros
+        if (bitCount > 0)
+            sent += emit(0, 8 - bitCount);
+    }
+    return sent + sender.endPacket();
+}
+
+template <class PacketSender, uint8_t WindowBits, uint8_t LookaheadBits>
+size_t LZSender<PacketSender, WindowBits, LookaheadBits>::step() {
+    using namespace LZ_Constants;
+    uint8_t lookahead = head - pos;
+    /*
+     * Only offsets that haven't been overwritten by the lookahead can be used.
+     */
+    uint16_t maxOffset = WindowSize - lookahead;
+    if (history < maxOffset)
+        maxOffset = history;
+
+    uint8_t bestLength  = 0;
+    uint16_t bestOffset = 0;
+    for (uint16_t offset = 1; offset <= maxOffset; ++offset) {
+        uint8_t length = 0;
+        // Matches may overlap with the lookahead itself
+        while (length < lookahead && window[(pos - offset + length) & Mask] ==
+                                         window[(pos + length) & Mask])
+            ++length;
+        if (length > bestLength) {
+            bestLength = length;
+            bestOffset = offset;
+            if (length == lookahead)
+                break;
+        }
+    }
+
+    size_t sent = 0;
+    uint8_t consumed;
+    if (bestLength >= MIN_MATCH_LENGTH) {
+        sent += emit(0, 1);
+        sent += emit(bestOffset - 1, WindowBits);
+        sent += emit(bestLength - MIN_MATCH_LENGTH, LookaheadBits);
+        consumed = bestLength;
+    } else {
+        sent += emit(1, 1);
+        sent += emit(window[pos & Mask], 8);
+        consumed = 1;
+    }
+    pos += consumed;
+    history = history + consumed < WindowSize ? history + consumed : WindowSize;
+    return sent;
+}
+
+template <class PacketSender, uint8_t WindowBits, uint8_t LookaheadBits>
+size_t LZSender<PacketSender, WindowBits, LookaheadBits>::emit(uint16_t value,
+                                                               uint8_t bits) {
+    size_t sent = 0;
+    while (bits--) {
+        bitBuffer = (bitBuffer << 1) | ((value >> bits) & 1);
+        if (++bitCount == 8) {
+            sent += sender.write(&bitBuffer, 1);
+            ++stats.compressed;
+            bitBuffer = 0;
+            bitCount  = 0;
+        }
+    }
+    return sent;
+}
@@ -111,15 +111,27 @@ class SLIPParser {
      */
     size_t numTruncated() const { return truncated; }
 
+    /**
+     * @brief   Get the total number of protocol violations since the parser
+     *          was created: escape characters that were not followed by
+     *          @ref SLIP_Constants::ESC_END "ESC_END" or
+     *          @ref SLIP_Constants::ESC_ESC "ESC_ESC".
+     */
+    uint32_t numProtocolViolations() const { return violations; }
+
+    /// Get the buffer that the parsed packets are stored in.
+    const uint8_t *getBuffer() const { return buffer; }
+
   private:
     void reset() { write = buffer; }
 
   private:
-    uint8_t *buffer   = nullptr;
-    uint8_t *write    = nullptr;
-    size_t bufferSize = 0;
-    size_t truncated  = 0;
-    bool escape       = false;
+    uint8_t *buffer     = nullptr;
+    uint8_t *write      = nullptr;
+    size_t bufferSize   = 0;
+    size_t truncated    = 0;
+    uint32_t violations = 0;
+    bool escape         = false;
 };
 
 /// @}
@@ -206,6 +218,14 @@ class SLIPParserCRC {
      */
     checksum_t checksum() const { return crc.checksum(); }
 
+    /// @copydoc    SLIPParser::numProtocolViolations
+    uint32_t numProtocolViolations() const {
+        return parser.numProtocolViolations();
+    }
+
+    /// @copydoc    SLIPParser::getBuffer
+    const uint8_t *getBuffer() const { return parser.getBuffer(); }
+
   private:
     SLIPParser parser;
     CRC crc;
@@ -21,7 +21,13 @@ size_t SLIPParser::parse(uint8_t c, Callback callback) {
              * turn sent to try to detect line noise.
              */
             auto packetLen = write - buffer;
-            escape         = false;
+            /*
+             * an END character right after an ESC character is a protocol
+             * violation
+             */
+            if (escape)
+                ++violations;
+            escape = false;
             reset();
             if (packetLen)
                 return packetLen;
@@ -51,7 +57,7 @@ size_t SLIPParser::parse(uint8_t c, Callback callback) {
                 switch (c) {
                     case ESC_END: c = END; break;
                     case ESC_ESC: c = ESC; break;
-                    default: break; // LCOV_EXCL_LINE (protocol violation)
+                    default: ++violations; break;
                 }
                 escape = false;
             }
@@ -62,6 +62,11 @@ class SLIPStream {
     /// @copydoc    SLIPParser::numTruncated
     size_t numTruncated() const { return parser.numTruncated(); }
 
+    /// @copydoc    SLIPParser::numProtocolViolations
+    uint32_t numProtocolViolations() const {
+        return parser.numProtocolViolations();
+    }
+
   private:
     Stream *stream;
     SLIPParser parser;
@@ -72,11 +77,46 @@ class SLIPStream {
 /// @addtogroup CRC
 /// @{
 
+/**
+ * @brief   Link statistics kept by @ref SLIPStreamCRC.
+ *
+ * All counters are updated once per packet, except for the byte counters,
+ * which are incremented once per byte.
+ */
+struct SLIPLinkStatistics {
+    /// Packets received with a correct checksum, not truncated, and not
+    /// duplicates.
+    uint32_t packetsOK = 0;
+    /// Packets received with an incorrect checksum.
+    uint32_t crcFailures = 0;
+    /// Packets with a correct checksum that didn't fit the buffer.
+    uint32_t truncated = 0;
+    /// Number of packets that went missing, based on the sequence numbers.
+    uint32_t gaps = 0;
+    /// Packets with a sequence number that was already received.
+    uint32_t duplicates = 0;
+    /// Number of times the receiver resynchronized with the sequence numbers
+    /// of a sender that restarted.
+    uint32_t resyncs = 0;
+    /// Bytes read from the Stream.
+    uint32_t bytesIn = 0;
+    /// Bytes written to the Stream.
+    uint32_t bytesOut = 0;
+    /// Invalid escape sequences, and packets too short for a sequence number.
+    uint32_t protocolViolations = 0;
+};
+
 /**
  * @brief   Class that implements SLIP, a simple packet framing protocol, and 
  *          that uses cyclic redundancy checks (CRCs) on transmitted and 
  *          received packets.
  * 
+ * Optionally, a 16-bit sequence number can be added to each packet, right
+ * before the checksum, so the receiver can detect lost and duplicate packets.
+ * Both sides have to agree on whether sequence numbers are used, see 
+ * @ref useSequenceNumbers. The sequence number is not part of the packet data
+ * returned by @ref readPacket.
+ * 
  * @see [**RFC 1055**](https://tools.ietf.org/html/rfc1055)
  * @see [**Boost::CRC**](https://www.boost.org/doc/libs/1_72_0/doc/html/crc.html)
  */
@@ -110,13 +150,30 @@ class SLIPStreamCRC {
     /// @copydoc    SLIPSenderCRC::endPacket
     size_t endPacket();
 
-    /// @copydoc    SLIPStream::readPacket
+    /**
+     * @brief   Receives a packet into the read buffer.
+     * 
+     * If more than len bytes are received, the packet will be truncated.
+     * 
+     * @return  The number of bytes stored in the buffer, without the
+     *          sequence number, or 0 if no complete packet was received yet.
+     * 
+     * @note    With sequence numbers enabled, a packet with an empty payload
+     *          also returns 0, so it can't be distinguished from "no packet
+     *          available" using the return value. It is still counted in the
+     *          statistics, and it updates the @ref sequenceNumber.
+     */
     size_t readPacket();
 
     /// @copydoc    SLIPParserCRC::wasTruncated
-    bool wasTruncated() const { return parser.wasTruncated(); }
+    bool wasTruncated() const { return numTruncated() > 0; }
     /// @copydoc    SLIPParserCRC::numTruncated
-    size_t numTruncated() const { return parser.numTruncated(); }
+    size_t numTruncated() const {
+        size_t seqSize = sequenceNumbers ? sizeof(uint16_t) : 0;
+        return parser.numTruncated() < seqSize
+                   ? 0
+                   : parser.numTruncated() - seqSize;
+    }
 
     /// @copydoc    SLIPParserCRC::checksum_t
     using checksum_t = typename SLIPParserCRC<CRC>::checksum_t;
@@ -124,10 +181,73 @@ class SLIPStreamCRC {
     /// @copydoc    SLIPParserCRC::checksum
     checksum_t checksum() const { return parser.checksum(); }
 
+    /**
+     * @brief   Enable or disable sequence numbers for sent and received 
+     *          packets. Disabled by default.
+     */
+    void useSequenceNumbers(bool enable = true) { sequenceNumbers = enable; }
+
+    /**
+     * @brief   Get the sequence number of the most recent packet that was
+     *          received correctly, in order. Only valid if sequence numbers
+     *          are enabled.
+     */
+    uint16_t sequenceNumber() const { return rxSequence; }
+
+    /**
+     * @brief   Check whether the last packet returned by @ref readPacket has a
+     *          sequence number that was already received. The data of such a
+     *          packet is a replay, and should usually be ignored.
+     * 
+     * When the sender restarts, its sequence numbers start at zero again.
+     * If @ref MaxConsecutiveDuplicates packets in a row have a sequence
+     * number that was already received, the receiver assumes that this
+     * happened: the last of these packets is not a duplicate, and its
+     * sequence number becomes the new reference. Use @ref resetSequence to
+     * resynchronize right away if you know that the sender restarted.
+     */
+    bool isDuplicate() const { return duplicate; }
+
+    /**
+     * @brief   Forget the sequence number of the last packet that was
+     *          received, so the next packet is accepted regardless of its
+     *          sequence number. Doesn't affect the sequence numbers of sent
+     *          packets.
+     */
+    void resetSequence() {
+        rxSequenceValid       = false;
+        consecutiveDuplicates = 0;
+    }
+
+    /// The number of consecutive duplicates after which the receiver
+    /// resynchronizes with the sequence numbers of the sender.
+    constexpr static uint8_t MaxConsecutiveDuplicates = 3;
+
+    /// Get the link statistics since construction or the last reset.
+    SLIPLinkStatistics getStatistics() const;
+    /// Reset all link statistics to zero.
+    void resetStatistics();
+
+  private:
+    /// Update the statistics and strip the sequence number from a packet.
+    size_t handlePacket(size_t packetSize);
+
   private:
     Stream *stream;
     SLIPSenderCRC<StreamSender, CRC> sender;
     SLIPParserCRC<CRC> parser;
+    SLIPLinkStatistics stats;
+    /// Protocol violations counted by the parser at the last reset.
+    uint32_t violationsAtReset = 0;
+    uint16_t txSequence        = 0;
+    uint16_t rxSequence        = 0;
+    bool sequenceNumbers       = false;
+    /// Whether a packet with a valid sequence number was received.
+    bool rxSequenceValid = false;
+    /// Whether the last packet was a duplicate.
+    bool duplicate = false;
+    /// The number of duplicates received in a row.
+    uint8_t consecutiveDuplicates = 0;
 };
 
 /// @}
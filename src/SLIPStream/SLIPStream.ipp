@@ -2,6 +2,9 @@
 
 #include <SLIPStream/SLIPSender.hpp>
 
+template <class CRC>
+constexpr uint8_t SLIPStreamCRC<CRC>::MaxConsecutiveDuplicates;
+
 template <class CRC>
 size_t SLIPStreamCRC<CRC>::writePacket(const uint8_t *data, size_t len) {
     size_t sent = 0;
@@ -13,25 +16,105 @@ size_t SLIPStreamCRC<CRC>::writePacket(const uint8_t *data, size_t len) {
 
 template <class CRC>
 size_t SLIPStreamCRC<CRC>::write(const uint8_t *data, size_t len) {
-    return sender.write(data, len);
+    size_t sent = sender.write(data, len);
+    stats.bytesOut += sent;
+    return sent;
 }
 
 template <class CRC>
 size_t SLIPStreamCRC<CRC>::beginPacket() {
-    return sender.beginPacket();
+    size_t sent = sender.beginPacket();
+    stats.bytesOut += sent;
+    return sent;
 }
 
 template <class CRC>
 size_t SLIPStreamCRC<CRC>::endPacket() {
-    return sender.endPacket();
+    size_t sent = 0;
+    if (sequenceNumbers) {
+        // Big endian, like the checksum
+        uint8_t seq[] = {uint8_t(txSequence >> 8), uint8_t(txSequence)};
+        sent += sender.write(seq, sizeof(seq));
+        ++txSequence;
+    }
+    sent += sender.endPacket();
+    stats.bytesOut += sent;
+    return sent;
 }
 
 template <class CRC>
 size_t SLIPStreamCRC<CRC>::readPacket() {
     while (stream->available()) {
+        ++stats.bytesIn;
         size_t packetSize = parser.parse(stream->read());
         if (packetSize > 0)
-            return packetSize;
+            return handlePacket(packetSize);
     }
     return 0;
 }
+
+template <class CRC>
+size_t SLIPStreamCRC<CRC>::handlePacket(size_t packetSize) {
+    constexpr size_t seqSize = sizeof(uint16_t);
+    size_t truncated         = parser.numTruncated();
+    // Strip the sequence number (or what's left of it) from the packet
+    size_t dataSize = packetSize;
+    if (sequenceNumbers) {
+        if (truncated < seqSize)
+            dataSize = packetSize + truncated < seqSize
+                           ? 0
+                           : packetSize + truncated - seqSize;
+    }
+
+    duplicate = false;
+    if (checksum() != 0) {
+        ++stats.crcFailures;
+    } else if (sequenceNumbers && packetSize + truncated < seqSize) {
+        // The sender didn't include a sequence number
+        ++stats.protocolViolations;
+    } else if (truncated > 0) {
+        // Truncated packets don't contain a (complete) sequence number
+        ++stats.truncated;
+    } else if (sequenceNumbers) {
+        const uint8_t *seq = parser.getBuffer() + dataSize;
+        uint16_t received  = (uint16_t(seq[0]) << 8) | seq[1];
+        // Distance from the expected sequence number (modulo 2^16)
+        uint16_t distance = received - uint16_t(rxSequence + 1);
+        if (!rxSequenceValid || distance < 0x8000) {
+            if (rxSequenceValid)
+                stats.gaps += distance;
+            rxSequence            = received;
+            rxSequenceValid       = true;
+            consecutiveDuplicates = 0;
+            ++stats.packetsOK;
+        } else if (++consecutiveDuplicates >= MaxConsecutiveDuplicates) {
+            // Too many duplicates in a row, the sender probably restarted and
+            // its sequence numbers started at zero again
+            rxSequence            = received;
+            consecutiveDuplicates = 0;
+            ++stats.resyncs;
+            ++stats.packetsOK;
+        } else {
+            // Sequence number was already received (or is very old)
+            duplicate = true;
+            ++stats.duplicates;
+        }
+    } else {
+        ++stats.packetsOK;
+    }
+    return dataSize;
+}
+
+template <class CRC>
+SLIPLinkStatistics SLIPStreamCRC<CRC>::getStatistics() const {
+    SLIPLinkStatistics result = stats;
+    result.protocolViolations +=
+        parser.numProtocolViolations() - violationsAtReset;
+    return result;
+}
+
+template <class CRC>
+void SLIPStreamCRC<CRC>::resetStatistics() {
+    stats             = {};
+    violationsAtReset = parser.numProtocolViolations();
+}
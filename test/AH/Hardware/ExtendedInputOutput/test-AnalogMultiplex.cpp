@@ -189,4 +189,73 @@ TEST(AnalogMultiplex, pinMode) {
     ExtIO::pinMode(mux.pin(0b1111), INPUT_PULLUP);
 
     ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
-}
\ No newline at end of file
+}
+
+TEST(AnalogMultiplex, analogReadBufferEnable) {
+    AnalogMultiplex<3> mux = {A0, {2, 3, 4}, 6};
+
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(3, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(4, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(6, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(6, HIGH));
+    ExtendedIOElement::beginAll();
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // The mux is enabled once, and only the changing address lines are written
+    ::testing::InSequence seq;
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(4, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(6, LOW));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(0))
+        .WillOnce(::testing::Return(101));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(0))
+        .WillOnce(::testing::Return(102));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), analogRead(A0))
+        .WillOnce(::testing::Return(0))
+        .WillOnce(::testing::Return(103));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(6, HIGH));
+    analog_t values[3];
+    ExtIO::analogReadBuffer(mux.pin(1), values, 3);
+    EXPECT_EQ(values[0], 101);
+    EXPECT_EQ(values[1], 102);
+    EXPECT_EQ(values[2], 103);
+
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(AnalogMultiplex, digitalReadBufferNoEnable) {
+    AnalogMultiplex<2> mux = {A0, {2, 3}};
+
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, OUTPUT));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(3, OUTPUT));
+    ExtendedIOElement::beginAll();
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    ::testing::InSequence seq;
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(A0))
+        .WillOnce(::testing::Return(1));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(A0))
+        .WillOnce(::testing::Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(A0))
+        .WillOnce(::testing::Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, 1));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(A0))
+        .WillOnce(::testing::Return(1));
+    uint8_t bits = 0xF0;
+    ExtIO::digitalReadBuffer(mux.pin(0), &bits, 4);
+    EXPECT_EQ(bits, 0b11111001);
+
+    ::testing::Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -2,7 +2,9 @@
 
 #include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
 #include <AH/Hardware/ExtendedInputOutput/ExtendedIOElement.hpp>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 using namespace ::testing;
 USING_AH_NAMESPACE;
@@ -367,4 +369,109 @@ TEST(ExtendedInputOutput, shiftOutLSBFIRST) {
     EXPECT_CALL(el, digitalWrite(clck, 0));
 
     shiftOut((int)el.pin(data), (int)el.pin(clck), LSBFIRST, 0b00111001);
-}
\ No newline at end of file
+}
+
+TEST(ExtendedInputOutput, findElementOfPin) {
+    MockExtIOElement el_1 = {8};
+    MockExtIOElement el_2 = {1};
+    MockExtIOElement el_3 = {16};
+    EXPECT_CALL(el_1, begin());
+    EXPECT_CALL(el_2, begin());
+    EXPECT_CALL(el_3, begin());
+    ExtendedIOElement::beginAll();
+
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_1.pin(0)), &el_1);
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_1.pin(7)), &el_1);
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_2.pin(0)), &el_2);
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_3.pin(15)), &el_3);
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_3.pin(0)), &el_3);
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_1.pin(3)), &el_1);
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(0), nullptr);
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_3.getEnd()), nullptr);
+
+    // Elements that are created or destroyed after beginAll
+    {
+        MockExtIOElement el_4 = {4};
+        EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_4.pin(2)), &el_4);
+        EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_2.pin(0)), &el_2);
+    }
+    pin_t removed = el_3.getEnd() + 2;
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(removed), nullptr);
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(el_3.pin(1)), &el_3);
+    EXPECT_THROW(getIOElementOfPin(removed), AH::ErrorException);
+}
+
+TEST(ExtendedInputOutput, findElementOfPinLinear) {
+    // More elements than fit in the dispatch table
+    std::vector<std::unique_ptr<NiceMock<MockExtIOElement>>> elements;
+    for (size_t i = 0; i < EXTIO_DISPATCH_TABLE_SIZE + 4; ++i)
+        elements.emplace_back(new NiceMock<MockExtIOElement>(i % 3 + 1));
+    ExtendedIOElement::beginAll();
+    for (auto &el : elements)
+        for (pin_t p = 0; p < el->getLength(); ++p)
+            EXPECT_EQ(ExtendedIOElement::findElementOfPin(el->pin(p)),
+                      el.get());
+    EXPECT_EQ(ExtendedIOElement::findElementOfPin(elements.back()->getEnd()),
+              nullptr);
+
+    InSequence seq;
+    EXPECT_CALL(*elements[5], digitalRead(0)).WillOnce(Return(HIGH));
+    EXPECT_EQ(digitalRead(elements[5]->pin(0)), HIGH);
+}
+
+TEST(ExtendedInputOutput, digitalWriteBuffer) {
+    MockExtIOElement el_1 = {10};
+    MockExtIOElement el_2 = {10};
+
+    // Bits 0-4 go to pins 5-9 of el_1, bits 5-11 go to pins 0-6 of el_2
+    const uint8_t bits[] = {0b01101001, 0b1011};
+    for (pin_t i = 0; i < 5; ++i)
+        EXPECT_CALL(el_1, digitalWrite(5 + i, (bits[0] >> i) & 1));
+    for (pin_t i = 5; i < 12; ++i)
+        EXPECT_CALL(el_2, digitalWrite(i - 5, (bits[i / 8] >> (i % 8)) & 1));
+    digitalWriteBuffer(el_1.pin(5), bits, 12);
+    Mock::VerifyAndClear(&el_1);
+    Mock::VerifyAndClear(&el_2);
+
+    // Arduino pins
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, HIGH));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, LOW));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(4, LOW));
+    digitalWriteBuffer(2, bits, 3);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(ExtendedInputOutput, digitalReadBuffer) {
+    MockExtIOElement el_1 = {10};
+    MockExtIOElement el_2 = {10};
+
+    for (pin_t i = 0; i < 10; ++i)
+        EXPECT_CALL(el_1, digitalRead(i)).WillOnce(Return(i % 3 == 0));
+    for (pin_t i = 0; i < 4; ++i)
+        EXPECT_CALL(el_2, digitalRead(i)).WillOnce(Return(i % 2));
+    uint8_t bits[2] = {0x00, 0xF0};
+    digitalReadBuffer(el_1.pin(0), bits, 14);
+    EXPECT_EQ(bits[0], 0b01001001);
+    // Pin 8 of el_1 is low, pin 9 is high, the upper bits are untouched
+    EXPECT_EQ(bits[1], 0b11101010);
+
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(7)).WillOnce(Return(1));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(8)).WillOnce(Return(0));
+    digitalReadBuffer(7, bits, 2);
+    EXPECT_EQ(bits[0], 0b01001001);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(ExtendedInputOutput, analogReadBuffer) {
+    MockExtIOElement el_1 = {3};
+    MockExtIOElement el_2 = {3};
+
+    EXPECT_CALL(el_1, analogRead(1)).WillOnce(Return(11));
+    EXPECT_CALL(el_1, analogRead(2)).WillOnce(Return(12));
+    EXPECT_CALL(el_2, analogRead(0)).WillOnce(Return(20));
+    analog_t values[3] = {};
+    analogReadBuffer(el_1.pin(1), values, 3);
+    EXPECT_EQ(values[0], 11);
+    EXPECT_EQ(values[1], 12);
+    EXPECT_EQ(values[2], 20);
+}
@@ -0,0 +1,144 @@
+#include <gmock-wrapper.h>
+#include <gtest-wrapper.h>
+
+#include <AH/Hardware/ExtendedInputOutput/ExtendedInputOutput.hpp>
+#include <AH/Hardware/ExtendedInputOutput/ScanningAnalogMultiplex.hpp>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+TEST(ScanningAnalogMultiplex, scan) {
+    ScanningAnalogMultiplex<2> mux = {A0, {2, 3}, 6, 10, false};
+    auto &mock = ArduinoMock::getInstance();
+
+    InSequence seq;
+    EXPECT_CALL(mock, pinMode(2, OUTPUT));
+    EXPECT_CALL(mock, pinMode(3, OUTPUT));
+    EXPECT_CALL(mock, pinMode(6, OUTPUT));
+    EXPECT_CALL(mock, digitalWrite(6, HIGH));
+    EXPECT_CALL(mock, digitalWrite(2, LOW));
+    EXPECT_CALL(mock, digitalWrite(3, LOW));
+    // The multiplexer stays enabled
+    EXPECT_CALL(mock, digitalWrite(6, LOW));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(100));
+    mux.begin();
+    Mock::VerifyAndClear(&mock);
+
+    // Not settled yet
+    EXPECT_CALL(mock, micros()).WillOnce(Return(109));
+    EXPECT_FALSE(mux.step());
+    Mock::VerifyAndClear(&mock);
+
+    // Gray code order: 0b00, 0b01, 0b11, 0b10, a single ADC conversion per
+    // input, and a single address line changes per step
+    EXPECT_CALL(mock, micros()).WillOnce(Return(110));
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(200));
+    EXPECT_CALL(mock, digitalWrite(2, HIGH));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(111));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(121));
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(201));
+    EXPECT_CALL(mock, digitalWrite(3, HIGH));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(122));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(132));
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(203));
+    EXPECT_CALL(mock, digitalWrite(2, LOW));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(133));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(143));
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(202));
+    EXPECT_CALL(mock, digitalWrite(3, LOW));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(144));
+    for (int i = 0; i < 4; ++i)
+        mux.update();
+    Mock::VerifyAndClear(&mock);
+
+    // Reading is a cache lookup
+    EXPECT_CALL(mock, analogRead(_)).Times(0);
+    EXPECT_CALL(mock, digitalWrite(_, _)).Times(0);
+    EXPECT_EQ(ExtIO::analogRead(mux.pin(0)), 200);
+    EXPECT_EQ(ExtIO::analogRead(mux.pin(3)), 203);
+    analog_t values[3];
+    ExtIO::analogReadBuffer(mux.pin(1), values, 3);
+    EXPECT_EQ(values[0], 201);
+    EXPECT_EQ(values[1], 202);
+    EXPECT_EQ(values[2], 203);
+    EXPECT_EQ(mux.getTimestamp(0), 110);
+    EXPECT_EQ(mux.getTimestamp(2), 143);
+    Mock::VerifyAndClear(&mock);
+}
+
+TEST(ScanningAnalogMultiplex, digitalRead) {
+    ScanningAnalogMultiplex<2> mux = {A0, {2, 3}, NO_PIN, 10};
+    auto &mock = ArduinoMock::getInstance();
+    EXPECT_CALL(mock, pinMode(_, _)).Times(2);
+    EXPECT_CALL(mock, digitalWrite(_, LOW)).Times(2);
+    EXPECT_CALL(mock, micros()).WillOnce(Return(100));
+    mux.begin();
+    Mock::VerifyAndClear(&mock);
+
+    // The input is read directly, and the scan continues afterwards
+    InSequence seq;
+    EXPECT_CALL(mock, digitalWrite(3, HIGH));
+    EXPECT_CALL(mock, digitalRead(A0)).WillOnce(Return(HIGH));
+    EXPECT_CALL(mock, digitalWrite(3, LOW));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(105));
+    EXPECT_EQ(ExtIO::digitalRead(mux.pin(2)), HIGH);
+    // The scanned input has to settle again
+    EXPECT_CALL(mock, micros()).WillOnce(Return(114));
+    EXPECT_FALSE(mux.step());
+    Mock::VerifyAndClear(&mock);
+}
+
+TEST(ScanningAnalogMultiplex, scanAll) {
+    ScanningAnalogMultiplex<3> mux = {A0, {2, 3, 4}, NO_PIN, 0};
+    auto &mock = ArduinoMock::getInstance();
+    EXPECT_CALL(mock, pinMode(_, _)).Times(AnyNumber());
+    EXPECT_CALL(mock, micros()).WillRepeatedly(Return(0));
+    // Exactly one address line changes per step
+    EXPECT_CALL(mock, digitalWrite(_, _)).Times(3 + 8);
+    int n = 0;
+    EXPECT_CALL(mock, analogRead(A0)).WillRepeatedly(Invoke([&](uint8_t) {
+        return n++;
+    }));
+    mux.begin();
+    mux.scanAll();
+    // The first reading of every input is discarded
+    const analog_t expected[] = {1, 3, 7, 5, 15, 13, 9, 11};
+    for (uint8_t i = 0; i < 8; ++i)
+        EXPECT_EQ(mux.analogRead(i), expected[i]) << +i;
+    Mock::VerifyAndClear(&mock);
+}
+
+/**
+ * When the ADC is shared with other code, the first conversion of every input
+ * carries the voltage of the previous pin, so it is discarded.
+ */
+TEST(ScanningAnalogMultiplex, interleavedReads) {
+    ScanningAnalogMultiplex<1> muxA = {A0, {2}, NO_PIN, 0};
+    ScanningAnalogMultiplex<1> muxB = {A1, {3}, NO_PIN, 0};
+    auto &mock = ArduinoMock::getInstance();
+    EXPECT_CALL(mock, pinMode(_, _)).Times(AnyNumber());
+    EXPECT_CALL(mock, digitalWrite(_, _)).Times(AnyNumber());
+    EXPECT_CALL(mock, micros()).WillRepeatedly(Return(0));
+    muxA.begin();
+    muxB.begin();
+
+    InSequence seq;
+    // Crosstalk of the previous pin in the first conversions
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(900));
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(100));
+    EXPECT_CALL(mock, analogRead(A1)).WillOnce(Return(120));
+    EXPECT_CALL(mock, analogRead(A1)).WillOnce(Return(800));
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(780));
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(101));
+    EXPECT_CALL(mock, analogRead(A1)).WillOnce(Return(110));
+    EXPECT_CALL(mock, analogRead(A1)).WillOnce(Return(801));
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_TRUE(muxA.step());
+        EXPECT_TRUE(muxB.step());
+    }
+    EXPECT_EQ(muxA.analogRead(0), 100);
+    EXPECT_EQ(muxA.analogRead(1), 101);
+    EXPECT_EQ(muxB.analogRead(0), 800);
+    EXPECT_EQ(muxB.analogRead(1), 801);
+    Mock::VerifyAndClear(&mock);
+}
@@ -0,0 +1,120 @@
+#include <gtest-wrapper.h>
+
+#include <AH/Hardware/ExtendedInputOutput/ShiftRegisterOut.hpp>
+
+USING_AH_NAMESPACE;
+using namespace ::testing;
+
+TEST(ShiftRegisterOut, digitalWriteBuffer) {
+    ShiftRegisterOut<16> sr = {2, 3, 4, LSBFIRST};
+
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(_, OUTPUT)).Times(3);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(_, _))
+        .Times(AnyNumber());
+    sr.begin();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // All pins are updated at once: a single latch pulse
+    const uint8_t bits[] = {0b10100101, 0b01};
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(4, LOW)).Times(1);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(4, HIGH)).Times(1);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(2, _)).Times(16);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(3, _)).Times(32);
+    ExtIO::digitalWriteBuffer(sr.pin(3), bits, 10);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    for (pin_t i = 0; i < 16; ++i) {
+        pin_t b       = i - 3;
+        bool expected = i >= 3 && i < 13 && ((bits[b / 8] >> (b % 8)) & 1);
+        EXPECT_EQ(sr.digitalRead(i), expected) << i;
+    }
+    uint8_t readBack[2] = {};
+    sr.digitalReadBuffer(3, readBack, 10);
+    EXPECT_EQ(readBack[0], bits[0]);
+    EXPECT_EQ(readBack[1], bits[1]);
+}
+
+namespace {
+
+/// Count the number of latch pulses (the number of times the outputs are
+/// written).
+void expectLatches(pin_t latchPin, int n) {
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(_, _))
+        .Times(AnyNumber());
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(latchPin, HIGH))
+        .Times(n);
+}
+
+} // namespace
+
+TEST(ShiftRegisterOut, updateOnWrite) {
+    ShiftRegisterOut<24> sr = {2, 3, 4};
+    expectLatches(4, 1);
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(_, OUTPUT)).Times(3);
+    sr.begin();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    expectLatches(4, 2);
+    sr.digitalWrite(0, HIGH);
+    sr.digitalWrite(0, HIGH); // Unchanged, nothing is sent
+    sr.digitalWrite(1, HIGH);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(ShiftRegisterOut, batch) {
+    ShiftRegisterOut<24> sr = {2, 3, 4};
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(_, OUTPUT)).Times(3);
+    expectLatches(4, 1);
+    sr.begin();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    expectLatches(4, 1);
+    sr.beginBatch();
+    sr.beginBatch(); // Nested
+    for (pin_t pin = 0; pin < 24; ++pin)
+        sr.digitalWrite(pin, HIGH);
+    sr.commit();
+    EXPECT_TRUE(sr.isBatchInProgress());
+    sr.commit();
+    EXPECT_FALSE(sr.isBatchInProgress());
+    sr.commit(); // No batch in progress, ignored
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    expectLatches(4, 1);
+    {
+        ShiftRegisterOut<24>::Transaction transaction{sr};
+        for (pin_t pin = 0; pin < 24; pin += 2)
+            sr.digitalWrite(pin, LOW);
+        EXPECT_FALSE(sr.digitalRead(0));
+        EXPECT_TRUE(sr.digitalRead(1));
+    }
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Nothing changed, so nothing is sent
+    expectLatches(4, 0);
+    {
+        ShiftRegisterOut<24>::Transaction transaction{sr};
+        sr.digitalWrite(1, HIGH);
+    }
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+TEST(ShiftRegisterOut, autoUpdateDisabled) {
+    ShiftRegisterOut<16> sr = {2, 3, 4};
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(_, OUTPUT)).Times(3);
+    expectLatches(4, 1);
+    ExtendedIOElement::beginAll();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    sr.setAutoUpdate(false);
+    EXPECT_FALSE(sr.getAutoUpdate());
+    expectLatches(4, 0);
+    for (pin_t pin = 0; pin < 16; ++pin)
+        ExtIO::digitalWrite(sr.pin(pin), HIGH);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    expectLatches(4, 1);
+    ExtendedIOElement::updateAll();
+    ExtendedIOElement::updateAll(); // Not dirty anymore
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -0,0 +1,130 @@
+#include <gmock-wrapper.h>
+
+#include <AH/Hardware/LEDs/MAX7219FrameBuffer.hpp>
+
+#include <utility>
+#include <vector>
+
+USING_AH_NAMESPACE;
+using namespace ::testing;
+
+namespace {
+
+using Packet = std::vector<uint8_t>;
+
+/// Record the packets (the bytes between two chip select pulses) that are sent
+/// over SPI.
+struct PacketRecorder {
+    PacketRecorder(uint8_t csPin) {
+        auto &spi = ArduinoMock::getSPI();
+        EXPECT_CALL(spi, begin()).Times(AnyNumber());
+        EXPECT_CALL(spi, beginTransaction(_, _, _))
+            .WillRepeatedly(InvokeWithoutArgs([this] { ++transactions; }));
+        EXPECT_CALL(spi, endTransaction()).Times(AnyNumber());
+        EXPECT_CALL(spi, transfer(_)).WillRepeatedly(Invoke([this](uint8_t b) {
+            packets.back().push_back(b);
+            return 0;
+        }));
+        auto &arduino = ArduinoMock::getInstance();
+        EXPECT_CALL(arduino, pinMode(csPin, OUTPUT)).Times(AnyNumber());
+        EXPECT_CALL(arduino, digitalWrite(csPin, _))
+            .WillRepeatedly(Invoke([this](uint8_t, uint8_t val) {
+                if (val == LOW)
+                    packets.emplace_back();
+            }));
+    }
+    ~PacketRecorder() {
+        Mock::VerifyAndClear(&ArduinoMock::getSPI());
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    }
+    void reset() {
+        packets.clear();
+        transactions = 0;
+    }
+    std::vector<Packet> packets;
+    int transactions = 0;
+};
+
+} // namespace
+
+TEST(MAX7219FrameBuffer, begin) {
+    PacketRecorder rec = {10};
+    MAX7219FrameBuffer<3> fb = {10};
+    fb.begin();
+    std::vector<Packet> expected = {
+        {15, 0, 15, 0, 15, 0},   // Display test
+        {11, 7, 11, 7, 11, 7},   // Scan limit
+        {9, 0, 9, 0, 9, 0},      // Decode mode
+        {10, 15, 10, 15, 10, 15} // Intensity
+    };
+    for (uint8_t r = 1; r <= 8; ++r)
+        expected.push_back({r, 0, r, 0, r, 0});
+    expected.push_back({12, 1, 12, 1, 12, 1}); // Shutdown
+    EXPECT_EQ(rec.packets, expected);
+    EXPECT_FALSE(fb.isDirty());
+}
+
+TEST(MAX7219FrameBuffer, dirtyRows) {
+    PacketRecorder rec = {10};
+    MAX7219FrameBuffer<3> fb = {10};
+    fb.begin();
+    rec.reset();
+
+    EXPECT_EQ(fb.display(), 0);
+    EXPECT_TRUE(rec.packets.empty());
+
+    fb.setPixel(0, 2, true);   // Module 0, row 2, MSB
+    fb.setPixel(17, 2, true);  // Module 2, row 2, bit 6
+    fb.setRow(1, 5, 0xA5);     // Module 1, row 5
+    fb.setPixel(9, 6, false);  // Unchanged
+    EXPECT_TRUE(fb.getPixel(17, 2));
+    EXPECT_FALSE(fb.getPixel(16, 2));
+    EXPECT_TRUE(fb.isDirty());
+    EXPECT_EQ(fb.display(), 2);
+    // One transaction, one packet per dirty row, last module first
+    EXPECT_EQ(rec.transactions, 1);
+    EXPECT_EQ(rec.packets, (std::vector<Packet>{
+                               {3, 0x40, 3, 0x00, 3, 0x80},
+                               {6, 0x00, 6, 0xA5, 6, 0x00},
+                           }));
+    rec.reset();
+
+    // Writing the same values again doesn't send anything
+    fb.setRow(1, 5, 0xA5);
+    EXPECT_EQ(fb.display(), 0);
+    EXPECT_TRUE(rec.packets.empty());
+
+    fb.clear();
+    EXPECT_EQ(fb.display(), 2);
+    fb.invalidate();
+    EXPECT_EQ(fb.display(), 8);
+}
+
+TEST(MAX7219FrameBuffer, asynchronous) {
+    PacketRecorder rec = {10};
+    PolledSPITransport transport;
+    MAX7219FrameBuffer<2> fb = {10, transport};
+    fb.begin();
+    rec.reset();
+
+    fb.setRow(0, 0, 0x01);
+    fb.setRow(0, 1, 0x02);
+    fb.setRow(0, 2, 0x03);
+    EXPECT_EQ(fb.display(), 3);
+    EXPECT_EQ(rec.packets.size(), 1);
+    // The second frame has to wait for the first one
+    fb.setRow(1, 3, 0x04);
+    EXPECT_EQ(fb.display(), 1);
+    EXPECT_EQ(rec.packets.size(), 2);
+    // The pending frame is replaced, so its row is included in the new one
+    fb.setRow(1, 4, 0x05);
+    EXPECT_EQ(fb.display(), 2);
+    fb.flush();
+    EXPECT_EQ(rec.packets, (std::vector<Packet>{
+                               {1, 0x00, 1, 0x01},
+                               {2, 0x00, 2, 0x02},
+                               {3, 0x00, 3, 0x03},
+                               {4, 0x04, 4, 0x00},
+                               {5, 0x05, 5, 0x00},
+                           }));
+}
@@ -0,0 +1,128 @@
+#include <gmock-wrapper.h>
+#include <gtest-wrapper.h>
+
+#include <AH/Hardware/ADCSampler.hpp>
+#include <AH/Hardware/FilteredAnalog.hpp>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+TEST(ADCSampler, roundRobin) {
+    ADCChannel a{A0};
+    ADCChannel b{A1};
+    auto &mock = ArduinoMock::getInstance();
+    EXPECT_TRUE(ADCSampler::supportsAsync(A0));
+    EXPECT_FALSE(ADCSampler::supportsAsync(2));
+
+    InSequence seq;
+    // Start the conversion of the first channel
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(100));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(0));
+    EXPECT_FALSE(ADCSampler::update());
+    EXPECT_TRUE(ADCSampler::isConverting());
+    // Still busy, the program doesn't have to wait
+    EXPECT_CALL(mock, micros()).WillOnce(Return(50));
+    EXPECT_FALSE(ADCSampler::update());
+    EXPECT_FALSE(a.available());
+    // Finished, store the result and start the next channel
+    EXPECT_CALL(mock, micros()).WillOnce(Return(104));
+    EXPECT_CALL(mock, analogRead(A1)).WillOnce(Return(200));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(105));
+    EXPECT_TRUE(ADCSampler::update());
+    EXPECT_TRUE(a.available());
+    EXPECT_FALSE(b.available());
+    EXPECT_EQ(a.getLatest(), 100);
+    // Wrap around to the first channel
+    EXPECT_CALL(mock, micros()).WillOnce(Return(300));
+    EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(111));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(301));
+    EXPECT_TRUE(ADCSampler::update());
+    EXPECT_EQ(b.getLatest(), 200);
+    // Wait for the last conversion
+    EXPECT_CALL(mock, micros()).WillOnce(Return(302));
+    EXPECT_CALL(mock, micros()).WillOnce(Return(405));
+    ADCSampler::flush();
+    EXPECT_FALSE(ADCSampler::isConverting());
+    Mock::VerifyAndClear(&mock);
+
+    // The samples are averaged (and rounded)
+    analog_t value = 0;
+    EXPECT_TRUE(a.read(value));
+    EXPECT_EQ(value, 106);
+    EXPECT_EQ(a.getLatest(), 111);
+    EXPECT_FALSE(a.available());
+    EXPECT_FALSE(a.read(value));
+    EXPECT_EQ(value, 106);
+    EXPECT_TRUE(b.read(value));
+    EXPECT_EQ(value, 200);
+}
+
+TEST(ADCSampler, blockingFallback) {
+    ADCChannel a{2};
+    auto &mock = ArduinoMock::getInstance();
+
+    // Pins that are not analog inputs of the built-in ADC are read directly
+    EXPECT_CALL(mock, analogRead(2)).WillOnce(Return(42)).WillOnce(Return(43));
+    EXPECT_CALL(mock, micros()).Times(0);
+    EXPECT_TRUE(ADCSampler::update());
+    EXPECT_FALSE(ADCSampler::isConverting());
+    EXPECT_TRUE(ADCSampler::update());
+    Mock::VerifyAndClear(&mock);
+
+    analog_t value = 0;
+    EXPECT_TRUE(a.read(value));
+    EXPECT_EQ(value, 43); // (42 + 43 + 1) / 2
+}
+
+TEST(ADCSampler, removeDuringConversion) {
+    auto &mock = ArduinoMock::getInstance();
+    unsigned long time = 0;
+    EXPECT_CALL(mock, micros()).WillRepeatedly(Invoke([&] { return time; }));
+    ADCChannel b{A1};
+    {
+        ADCChannel a{A0};
+        EXPECT_CALL(mock, analogRead(A1)).WillOnce(Return(1));
+        EXPECT_FALSE(ADCSampler::update());
+        time = 200;
+        EXPECT_CALL(mock, analogRead(A0)).WillOnce(Return(2));
+        EXPECT_TRUE(ADCSampler::update());
+        EXPECT_TRUE(ADCSampler::isConverting());
+    }
+    // The result of the removed channel is discarded
+    time = 400;
+    EXPECT_CALL(mock, analogRead(A1)).WillOnce(Return(3));
+    EXPECT_TRUE(ADCSampler::update());
+    time = 600;
+    ADCSampler::flush();
+    Mock::VerifyAndClear(&mock);
+
+    analog_t value = 0;
+    EXPECT_TRUE(b.read(value));
+    EXPECT_EQ(value, 2); // (1 + 3) / 2
+}
+
+TEST(ADCSampler, FilteredAnalog) {
+    ADCChannel channel{A0};
+    FilteredAnalog<> analog{A0};
+    auto &mock = ArduinoMock::getInstance();
+
+    // Nothing was sampled yet, the ADC is not used
+    EXPECT_CALL(mock, analogRead(_)).Times(0);
+    EXPECT_FALSE(analog.update(channel));
+    Mock::VerifyAndClear(&mock);
+
+    unsigned long time = 0;
+    EXPECT_CALL(mock, micros()).WillRepeatedly(Invoke([&] {
+        return time += 200;
+    }));
+    EXPECT_CALL(mock, analogRead(A0)).WillRepeatedly(Return(1023));
+    bool changed = false;
+    for (int i = 0; i < 200; ++i) {
+        ADCSampler::update();
+        changed |= analog.update(channel);
+    }
+    ADCSampler::flush();
+    Mock::VerifyAndClear(&mock);
+    EXPECT_TRUE(changed);
+    EXPECT_EQ(analog.getValue(), 1023);
+}
@@ -0,0 +1,158 @@
+#include <gmock-wrapper.h>
+
+#include <AH/Hardware/AsyncSPIOutput.hpp>
+#include <AH/Hardware/ExtendedInputOutput/MAX7219.hpp>
+#include <AH/Hardware/ExtendedInputOutput/SPIShiftRegisterOut.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+USING_AH_NAMESPACE;
+using namespace ::testing;
+
+namespace {
+
+constexpr int CS_LOW  = -1;
+constexpr int CS_HIGH = -2;
+constexpr int BEGIN   = -3;
+constexpr int END     = -4;
+
+/// Record all SPI traffic and the state of the chip select pin.
+struct SPIRecorder {
+    SPIRecorder(uint8_t csPin) {
+        auto &spi = ArduinoMock::getSPI();
+        EXPECT_CALL(spi, begin()).Times(AnyNumber());
+        auto logBegin = [this] { log.push_back(BEGIN); };
+        auto logEnd   = [this] { log.push_back(END); };
+        EXPECT_CALL(spi, beginTransaction(_, _, _))
+            .WillRepeatedly(InvokeWithoutArgs(logBegin));
+        EXPECT_CALL(spi, endTransaction())
+            .WillRepeatedly(InvokeWithoutArgs(logEnd));
+        EXPECT_CALL(spi, transfer(_)).WillRepeatedly(Invoke([this](uint8_t b) {
+            log.push_back(b);
+            return 0;
+        }));
+        auto &arduino = ArduinoMock::getInstance();
+        EXPECT_CALL(arduino, pinMode(csPin, OUTPUT)).Times(AnyNumber());
+        EXPECT_CALL(arduino, digitalWrite(csPin, _))
+            .WillRepeatedly(Invoke([this](uint8_t, uint8_t val) {
+                log.push_back(val ? CS_HIGH : CS_LOW);
+            }));
+    }
+    ~SPIRecorder() {
+        Mock::VerifyAndClear(&ArduinoMock::getSPI());
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    }
+    std::vector<int> take() { return std::move(log); }
+    std::vector<int> log;
+};
+
+/// Get the opcodes and values of all MAX7219 packets in the log.
+std::vector<std::pair<int, int>> getPackets(const std::vector<int> &log) {
+    std::vector<std::pair<int, int>> packets;
+    for (size_t i = 0; i + 3 < log.size(); ++i)
+        if (log[i] == CS_LOW && log[i + 3] == CS_HIGH)
+            packets.push_back({log[i + 1], log[i + 2]});
+    return packets;
+}
+
+} // namespace
+
+TEST(AsyncSPIOutput, MAX7219Blocking) {
+    SPIRecorder rec = {10};
+    MAX7219 max = {10};
+    max.begin();
+    rec.take();
+
+    max.digitalWrite(9, HIGH); // Row 1, bit 1
+    std::vector<int> expected = {BEGIN};
+    for (int row = 0; row < 8; ++row)
+        expected.insert(expected.end(),
+                        {CS_LOW, row + 1, row == 1 ? 0x02 : 0, CS_HIGH});
+    expected.push_back(END);
+    EXPECT_EQ(rec.take(), expected);
+
+    // Unchanged: nothing is sent
+    max.digitalWrite(9, HIGH);
+    max.update();
+    EXPECT_TRUE(rec.take().empty());
+
+    // Clearing the display uses a single transaction
+    max.clear();
+    EXPECT_EQ(std::count(rec.log.begin(), rec.log.end(), BEGIN), 1);
+    EXPECT_EQ(std::count(rec.log.begin(), rec.log.end(), CS_LOW), 8);
+}
+
+TEST(AsyncSPIOutput, MAX7219Polled) {
+    SPIRecorder rec = {10};
+    PolledSPITransport transport = {2};
+    MAX7219 max = {10, transport};
+    max.begin(); // Configuration commands are always flushed
+    rec.take();
+
+    max.digitalWrite(0, HIGH);
+    // Only the first two rows were sent
+    EXPECT_EQ(rec.take(), (std::vector<int>{BEGIN, CS_LOW, 1, 0x01, CS_HIGH,
+                                             CS_LOW, 2, 0x00, CS_HIGH, END}));
+    // New frames while the previous one is still being sent: only the most
+    // recent one is sent afterwards
+    max.digitalWrite(1, HIGH);
+    max.digitalWrite(8, HIGH);
+    while (max.poll())
+        ;
+    std::vector<std::pair<int, int>> expected;
+    for (int row = 2; row < 8; ++row)
+        expected.push_back({row + 1, 0x00});
+    for (int row = 0; row < 8; ++row)
+        expected.push_back({row + 1, row == 0 ? 0x03 : row == 1 ? 0x01 : 0});
+    EXPECT_EQ(getPackets(rec.take()), expected);
+    EXPECT_FALSE(max.poll());
+}
+
+TEST(AsyncSPIOutput, SPIShiftRegisterOut) {
+    SPIRecorder rec = {10};
+    SPIShiftRegisterOut<16> sr = {10, MSBFIRST};
+    sr.begin();
+    EXPECT_EQ(rec.take(), (std::vector<int>{BEGIN, CS_LOW, 0x00, 0x00,
+                                             CS_HIGH, END}));
+
+    {
+        SPIShiftRegisterOut<16>::Transaction transaction{sr};
+        sr.digitalWrite(0, HIGH);
+        sr.digitalWrite(15, HIGH);
+        sr.digitalWrite(9, HIGH);
+    }
+    // Most significant byte first
+    EXPECT_EQ(rec.take(), (std::vector<int>{BEGIN, CS_LOW, 0x82, 0x01,
+                                             CS_HIGH, END}));
+}
+
+TEST(AsyncSPIOutput, sharedTransport) {
+    SPIRecorder rec10 = {10};
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(9, OUTPUT))
+        .Times(AnyNumber());
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalWrite(9, _))
+        .WillRepeatedly(Invoke([&](uint8_t, uint8_t val) {
+            rec10.log.push_back(val ? CS_HIGH - 10 : CS_LOW - 10);
+        }));
+
+    PolledSPITransport transport;
+    AsyncSPIOutput<4> a = {transport, 10, {}};
+    AsyncSPIOutput<4> b = {transport, 9, {}};
+    const uint8_t dataA[] = {1, 2, 3, 4}, dataB[] = {5, 6};
+    EXPECT_TRUE(a.enqueue(dataA, 2, 2));
+    EXPECT_FALSE(b.enqueue(dataA, 4, 2)); // Too large
+    EXPECT_TRUE(b.enqueue(dataB, 1, 2));
+    // b has to wait for a to finish
+    while (a.poll() | b.poll())
+        ;
+    std::vector<int> expected = {
+        BEGIN, CS_LOW,      1, 2, CS_HIGH,      END, // a, packet 0
+        BEGIN, CS_LOW,      3, 4, CS_HIGH,      END, // a, packet 1
+        BEGIN, CS_LOW - 10, 5, CS_HIGH - 10,    END, // b, packet 0
+        BEGIN, CS_LOW - 10, 6, CS_HIGH - 10,    END, // b, packet 1
+    };
+    EXPECT_EQ(rec10.take(), expected);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -0,0 +1,139 @@
+#include <AH/Hardware/BitSlicedDebouncer.hpp>
+#include <gmock-wrapper.h>
+#include <gtest-wrapper.h>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+TEST(BitSlicedDebouncer, initialState) {
+    BitSlicedDebouncer<12> deb;
+    EXPECT_EQ(deb.NumWords, 2);
+    EXPECT_EQ(deb.getStates(0), 0xFF);
+    EXPECT_EQ(deb.getStates(1), 0x0F);
+    for (uint16_t i = 0; i < 12; ++i) {
+        EXPECT_TRUE(deb.getState(i));
+        EXPECT_EQ(deb.getButtonState(i), Button::Released);
+    }
+    deb.reset(LOW);
+    EXPECT_EQ(deb.getStates(0), 0x00);
+    EXPECT_EQ(deb.getButtonState(3), Button::Pressed);
+}
+
+/**
+ * The state only changes after four consecutive samples that differ from the
+ * debounced state, and the edge is reported only once.
+ */
+TEST(BitSlicedDebouncer, press) {
+    BitSlicedDebouncer<8> deb;
+    const uint8_t pressed[] = {0b11110110};
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_FALSE(deb.update(pressed)) << i;
+        EXPECT_EQ(deb.getStates(0), 0xFF);
+    }
+    EXPECT_TRUE(deb.update(pressed));
+    EXPECT_EQ(deb.getStates(0), 0b11110110);
+    EXPECT_EQ(deb.getFallingEdges(0), 0b00001001);
+    EXPECT_EQ(deb.getRisingEdges(0), 0);
+    EXPECT_EQ(deb.getButtonState(0), Button::Falling);
+    EXPECT_EQ(deb.getButtonState(1), Button::Released);
+    EXPECT_FALSE(deb.update(pressed));
+    EXPECT_EQ(deb.getFallingEdges(0), 0);
+    EXPECT_EQ(deb.getButtonState(0), Button::Pressed);
+
+    const uint8_t released[] = {0xFF};
+    for (int i = 0; i < 3; ++i)
+        EXPECT_FALSE(deb.update(released)) << i;
+    EXPECT_TRUE(deb.update(released));
+    EXPECT_EQ(deb.getRisingEdges(0), 0b00001001);
+    EXPECT_EQ(deb.getFallingEdges(0), 0);
+    EXPECT_EQ(deb.getButtonState(3), Button::Rising);
+}
+
+/**
+ * Bouncing inputs reset the counter.
+ */
+TEST(BitSlicedDebouncer, bounce) {
+    BitSlicedDebouncer<8> deb;
+    const uint8_t low[] = {0xFE}, high[] = {0xFF};
+    EXPECT_FALSE(deb.update(low));
+    EXPECT_FALSE(deb.update(high));
+    EXPECT_FALSE(deb.update(low));
+    EXPECT_FALSE(deb.update(low));
+    EXPECT_FALSE(deb.update(high));
+    for (int i = 0; i < 3; ++i)
+        EXPECT_FALSE(deb.update(low)) << i;
+    EXPECT_EQ(deb.getState(0), HIGH);
+    EXPECT_TRUE(deb.update(low));
+    EXPECT_EQ(deb.getState(0), LOW);
+}
+
+/**
+ * Buttons in different words and in the unused bits of the last word.
+ */
+TEST(BitSlicedDebouncer, words) {
+    BitSlicedDebouncer<40, uint32_t> deb;
+    EXPECT_EQ(deb.NumWords, 2);
+    // Bit 43 is not a button
+    const uint32_t samples[] = {0x7FFFFFFF, 0xFFFFF7FF};
+    for (int i = 0; i < 3; ++i)
+        deb.update(samples);
+    EXPECT_TRUE(deb.update(samples));
+    EXPECT_EQ(deb.getFallingEdges(0), 0x80000000);
+    EXPECT_EQ(deb.getFallingEdges(1), 0);
+    EXPECT_EQ(deb.getStates(1), 0xFF);
+    EXPECT_EQ(deb.getButtonState(31), Button::Falling);
+    EXPECT_EQ(deb.getButtonState(32), Button::Released);
+}
+
+TEST(BitSlicedDebouncer, bytes) {
+    BitSlicedDebouncer<20, uint16_t> deb;
+    const uint8_t bits[] = {0xFF, 0x7F, 0x0E};
+    for (int i = 0; i < 4; ++i)
+        deb.updateBytes(bits);
+    EXPECT_EQ(deb.getStates(0), 0x7FFF);
+    EXPECT_EQ(deb.getStates(1), 0x000E);
+    EXPECT_EQ(deb.getFallingEdges(1), 0x0001);
+
+    BitArray<20> array;
+    for (uint8_t i = 0; i < 20; ++i)
+        array.set(i, i != 3);
+    for (int i = 0; i < 4; ++i)
+        deb.update(array);
+    EXPECT_EQ(deb.getStates(0), 0xFFF7);
+    EXPECT_EQ(deb.getStates(1), 0x000F);
+    EXPECT_EQ(deb.getRisingEdges(0), 0x8000);
+    EXPECT_EQ(deb.getFallingEdges(0), 0x0008);
+}
+
+/**
+ * Reading the pins calls millis only once per scan, and samples at the given
+ * interval.
+ */
+TEST(BitSlicedDebouncer, readPins) {
+    BitSlicedDebouncer<3> deb = {5};
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, INPUT_PULLUP));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(3, INPUT_PULLUP));
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(4, INPUT_PULLUP));
+    deb.begin(2);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    for (unsigned long t = 10; t < 40; t += 5) {
+        EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(t));
+        EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(2))
+            .WillOnce(Return(HIGH));
+        EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(3))
+            .WillOnce(Return(LOW));
+        EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(4))
+            .WillOnce(Return(HIGH));
+        EXPECT_EQ(deb.readPins(2), t == 25) << t;
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+        // Too soon for the next sample: the pins are not read
+        EXPECT_CALL(ArduinoMock::getInstance(), millis())
+            .WillOnce(Return(t + 4));
+        EXPECT_FALSE(deb.readPins(2));
+        EXPECT_EQ(deb.getFallingEdges(0), 0);
+        Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    }
+    EXPECT_EQ(deb.getStates(0), 0b101);
+    EXPECT_EQ(deb.getButtonState(1), Button::Pressed);
+}
@@ -0,0 +1,140 @@
+#include <AH/Hardware/ButtonMatrix.hpp>
+#include <gmock-wrapper.h>
+#include <gtest-wrapper.h>
+
+#include <set>
+#include <tuple>
+#include <vector>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+namespace {
+
+using Event = std::tuple<uint8_t, uint8_t, bool>;
+
+template <uint8_t nb_rows, uint8_t nb_cols>
+class TestButtonMatrix : public ButtonMatrix<nb_rows, nb_cols> {
+  public:
+    using ButtonMatrix<nb_rows, nb_cols>::ButtonMatrix;
+    std::vector<Event> events;
+
+  private:
+    void onButtonChanged(uint8_t row, uint8_t col, bool state) override {
+        events.emplace_back(row, col, state);
+    }
+};
+
+/// Simulates a button matrix: the column pins read low if the button at the
+/// intersection with the selected row is pressed.
+struct FakeMatrix {
+    FakeMatrix() {
+        auto &mock = ArduinoMock::getInstance();
+        EXPECT_CALL(mock, pinMode(_, _))
+            .WillRepeatedly(Invoke([this](uint8_t pin, uint8_t mode) {
+                if (mode == OUTPUT)
+                    selectedRow = pin;
+                else if (pin == selectedRow)
+                    selectedRow = NO_PIN;
+            }));
+        EXPECT_CALL(mock, digitalRead(_))
+            .WillRepeatedly(Invoke([this](uint8_t pin) {
+                ++reads;
+                return pressed.count({selectedRow, pin}) ? LOW : HIGH;
+            }));
+        EXPECT_CALL(mock, millis()).WillRepeatedly(Invoke([this] {
+            return time;
+        }));
+    }
+    ~FakeMatrix() { Mock::VerifyAndClear(&ArduinoMock::getInstance()); }
+
+    std::set<std::pair<pin_t, pin_t>> pressed;
+    pin_t selectedRow = NO_PIN;
+    unsigned long time = 0;
+    unsigned reads = 0;
+
+    /// Update the matrix once per sample interval, for the given number of
+    /// samples.
+    template <class Matrix>
+    void run(Matrix &matrix, int samples) {
+        for (int i = 0; i < samples; ++i) {
+            time += matrix.getDebouncer().getSampleInterval();
+            matrix.update();
+        }
+    }
+};
+
+} // namespace
+
+TEST(ButtonMatrix, chord) {
+    FakeMatrix fake;
+    TestButtonMatrix<2, 3> matrix = {{2, 3}, {4, 5, 6}};
+    matrix.begin();
+    fake.run(matrix, 4);
+    EXPECT_TRUE(matrix.events.empty());
+
+    // Press three buttons at the same time
+    fake.pressed = {{2, 4}, {3, 4}, {3, 6}};
+    fake.run(matrix, 3);
+    EXPECT_TRUE(matrix.events.empty());
+    fake.time += matrix.getDebouncer().getSampleInterval();
+    EXPECT_EQ(matrix.update(), 3);
+    std::vector<Event> expected = {
+        Event{0, 0, LOW},
+        Event{1, 0, LOW},
+        Event{1, 2, LOW},
+    };
+    EXPECT_EQ(matrix.events, expected);
+    EXPECT_FALSE(matrix.getPrevState(0, 0));
+    EXPECT_TRUE(matrix.getPrevState(1, 0));
+    EXPECT_FALSE(matrix.getPrevState(2, 1));
+
+    // Release one of them, while pressing another one shortly after
+    matrix.events.clear();
+    fake.pressed = {{2, 4}, {3, 6}};
+    fake.run(matrix, 1);
+    fake.pressed = {{2, 4}, {3, 6}, {2, 5}};
+    fake.run(matrix, 4);
+    expected = {
+        Event{1, 0, HIGH},
+        Event{0, 1, LOW},
+    };
+    EXPECT_EQ(matrix.events, expected);
+}
+
+/**
+ * Short glitches are ignored, and don't block other buttons.
+ */
+TEST(ButtonMatrix, bounce) {
+    FakeMatrix fake;
+    TestButtonMatrix<2, 2> matrix = {{2, 3}, {4, 7}};
+    matrix.begin();
+    for (int i = 0; i < 3; ++i) {
+        fake.pressed = {{2, 4}, {3, 7}};
+        fake.run(matrix, 1);
+        fake.pressed = {{3, 7}};
+        fake.run(matrix, 1);
+    }
+    std::vector<Event> expected = {Event{1, 1, LOW}};
+    EXPECT_EQ(matrix.events, expected);
+}
+
+/**
+ * Every scan reads all buttons, and scans are limited to the sample rate.
+ */
+TEST(ButtonMatrix, scanTime) {
+    FakeMatrix fake;
+    TestButtonMatrix<3, 10> matrix = {{2, 3, 4}, {5, 6, 7, 8, 9, 10, 11, 12,
+                                                  13, 14}};
+    fake.time = 1000;
+    matrix.update();
+    EXPECT_EQ(fake.reads, 3 * 10);
+    matrix.update();
+    EXPECT_EQ(fake.reads, 3 * 10);
+    fake.pressed = {{4, 14}};
+    fake.run(matrix, 4);
+    EXPECT_EQ(fake.reads, 5 * 3 * 10);
+    std::vector<Event> expected = {Event{2, 9, LOW}};
+    EXPECT_EQ(matrix.events, expected);
+    EXPECT_FALSE(matrix.getPrevState(9, 2));
+}
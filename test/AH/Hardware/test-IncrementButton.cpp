@@ -82,4 +82,37 @@ TEST(IncrementButton, longPress) {
     EXPECT_EQ(b.update(), IncrementButton::Nothing);
 
     Mock::VerifyAndClear(&ArduinoMock::getInstance());
-}
\ No newline at end of file
+}
+
+TEST(IncrementButton, interrupts) {
+    Button::setDebounceTime(25);
+    InterruptIncrementButton b(2);
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(2))
+        .WillOnce(Return(HIGH));
+    ASSERT_TRUE(b.enableInterrupts());
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Released: neither the pin nor the time is read
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).Times(0);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(_)).Times(0);
+    EXPECT_EQ(b.update(), IncrementButton::Nothing);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Fall → increment
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1000));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(2))
+        .WillOnce(Return(LOW));
+    ArduinoMock::getInterrupts().trigger(2);
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1030));
+    EXPECT_EQ(b.update(), IncrementButton::Increment);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    // Long press → increment
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillOnce(Return(1000 + LONG_PRESS_DELAY));
+    EXPECT_EQ(b.update(), IncrementButton::Increment);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    b.disableInterrupts();
+}
@@ -0,0 +1,184 @@
+#include <AH/Hardware/InterruptButton.hpp>
+#include <gmock-wrapper.h>
+#include <gtest-wrapper.h>
+
+#include <vector>
+
+using namespace ::testing;
+USING_AH_NAMESPACE;
+
+namespace {
+
+/// Simulate a pin change interrupt at the given time.
+void pinChange(uint8_t pin, int level, unsigned long time) {
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(time));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(pin))
+        .WillOnce(Return(level));
+    EXPECT_TRUE(ArduinoMock::getInterrupts().trigger(pin));
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+/// Expect that the button doesn't read the pin or the time when updated.
+void expectIdleUpdate(InterruptButton &b, Button::State state) {
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).Times(0);
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(_)).Times(0);
+    EXPECT_EQ(b.update(), state);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+} // namespace
+
+/**
+ * Changes are captured by the interrupt handler, and debounced using their
+ * timestamps. When idle, no pins are read.
+ * ```
+ * Raw input:
+ *    HIGH  ─┐ ┌─┐      ┌─
+ *    LOW    └─┘ └──────┘
+ *         1000 1005  1200
+ * ```
+ */
+TEST(InterruptButton, interrupts) {
+    Button::setDebounceTime(25);
+    InterruptButton b(2);
+    EXPECT_CALL(ArduinoMock::getInstance(), pinMode(2, INPUT_PULLUP));
+    b.begin();
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(900));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(2))
+        .WillOnce(Return(HIGH));
+    ASSERT_TRUE(b.enableInterrupts());
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_TRUE(b.isInterruptDriven());
+    EXPECT_EQ(ArduinoMock::getInterrupts().getMode(2), CHANGE);
+
+    expectIdleUpdate(b, Button::Released);
+
+    pinChange(2, LOW, 1000);
+    pinChange(2, HIGH, 1003);
+    pinChange(2, LOW, 1005);
+    // Not stable for long enough yet
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1020));
+    EXPECT_EQ(b.update(), Button::Released);
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1031));
+    EXPECT_EQ(b.update(), Button::Falling);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(b.previousBounceTime(), 1005);
+
+    expectIdleUpdate(b, Button::Pressed);
+    expectIdleUpdate(b, Button::Pressed);
+
+    // A short glitch is ignored, without calling millis
+    pinChange(2, HIGH, 1100);
+    pinChange(2, LOW, 1101);
+    expectIdleUpdate(b, Button::Pressed);
+
+    pinChange(2, HIGH, 1200);
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(1300));
+    EXPECT_EQ(b.update(), Button::Rising);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    expectIdleUpdate(b, Button::Released);
+
+    b.disableInterrupts();
+    EXPECT_FALSE(b.isInterruptDriven());
+    EXPECT_FALSE(ArduinoMock::getInterrupts().isAttached(2));
+}
+
+/**
+ * If changes are lost because the queue is full, the pin is read again.
+ */
+TEST(InterruptButton, interruptsOverflow) {
+    Button::setDebounceTime(25);
+    InterruptButton b(3);
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(3))
+        .WillOnce(Return(HIGH));
+    ASSERT_TRUE(b.enableInterrupts());
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+
+    for (unsigned long t = 100; t < 100 + 2 * BUTTON_EVENT_QUEUE_SIZE; ++t)
+        pinChange(3, t % 2 ? HIGH : LOW, t);
+    // The queue ends with a change to LOW, the changes after that were lost
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(3))
+        .WillOnce(Return(HIGH));
+    EXPECT_CALL(ArduinoMock::getInstance(), millis()).WillOnce(Return(500));
+    EXPECT_EQ(b.update(), Button::Released);
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+    EXPECT_EQ(b.previousBounceTime(), 500);
+
+    b.disableInterrupts();
+}
+
+/**
+ * Pins without interrupt support keep polling.
+ */
+TEST(InterruptButton, interruptsUnsupported) {
+    InterruptButton analog(A0);
+    EXPECT_FALSE(analog.enableInterrupts());
+    EXPECT_FALSE(analog.isInterruptDriven());
+    InterruptButton extIO(AH_EXT_PIN(0));
+    EXPECT_FALSE(extIO.enableInterrupts());
+
+    // All slots in use
+    std::vector<InterruptButton> buttons;
+    for (uint8_t i = 0; i < MAX_INTERRUPT_BUTTONS; ++i)
+        buttons.emplace_back(i);
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(_))
+        .WillRepeatedly(Return(HIGH));
+    for (InterruptButton &b : buttons)
+        EXPECT_TRUE(b.enableInterrupts());
+    InterruptButton last(MAX_INTERRUPT_BUTTONS);
+    EXPECT_FALSE(last.enableInterrupts());
+    for (InterruptButton &b : buttons)
+        b.disableInterrupts();
+    EXPECT_TRUE(last.enableInterrupts());
+    last.disableInterrupts();
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
+
+/**
+ * The interrupt belongs to a single button: it is detached when the button is
+ * destroyed, copies poll the pin, and moving transfers the interrupt.
+ */
+TEST(InterruptButton, interruptsOwnership) {
+    EXPECT_CALL(ArduinoMock::getInstance(), millis())
+        .WillRepeatedly(Return(0));
+    EXPECT_CALL(ArduinoMock::getInstance(), digitalRead(_))
+        .WillRepeatedly(Return(HIGH));
+    {
+        InterruptButton b(2);
+        ASSERT_TRUE(b.enableInterrupts());
+        InterruptButton copy = b;
+        EXPECT_FALSE(copy.isInterruptDriven());
+        EXPECT_TRUE(b.isInterruptDriven());
+        copy.disableInterrupts();
+        EXPECT_TRUE(ArduinoMock::getInterrupts().isAttached(2));
+        // The copy can't take over the interrupt of the original
+        EXPECT_FALSE(copy.enableInterrupts());
+        EXPECT_FALSE(copy.isInterruptDriven());
+        EXPECT_TRUE(b.isInterruptDriven());
+        copy.disableInterrupts();
+        EXPECT_TRUE(ArduinoMock::getInterrupts().isAttached(2));
+
+        InterruptButton moved = std::move(b);
+        EXPECT_TRUE(moved.isInterruptDriven());
+        EXPECT_FALSE(b.isInterruptDriven());
+        EXPECT_TRUE(ArduinoMock::getInterrupts().isAttached(2));
+    }
+    EXPECT_FALSE(ArduinoMock::getInterrupts().isAttached(2));
+
+    // The slots are free again
+    std::vector<InterruptButton> buttons;
+    for (uint8_t i = 0; i < MAX_INTERRUPT_BUTTONS; ++i) {
+        buttons.emplace_back(i);
+        EXPECT_TRUE(buttons.back().enableInterrupts());
+    }
+    // Growing the vector moves the buttons, they keep their interrupts
+    for (InterruptButton &b : buttons)
+        EXPECT_TRUE(b.isInterruptDriven());
+    buttons.clear();
+    for (uint8_t i = 0; i < MAX_INTERRUPT_BUTTONS; ++i)
+        EXPECT_FALSE(ArduinoMock::getInterrupts().isAttached(i));
+    Mock::VerifyAndClear(&ArduinoMock::getInstance());
+}
@@ -2,6 +2,7 @@
 
 #include <AH/Math/IncreaseBitDepth.hpp>
 #include <algorithm>
+#include <array>
 
 USING_AH_NAMESPACE;
 
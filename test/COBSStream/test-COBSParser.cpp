@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <COBSStream/COBSParser.hpp>
+#include <COBSStream/COBSSender.hpp>
+#include <boost/crc.hpp>
+
+#include <random>
+#include <vector>
+
+TEST(COBSParser, parsePacket) {
+    std::vector<uint8_t> buffer(64);
+    COBSParser parser = {buffer.data(), buffer.size()};
+
+    std::vector<uint8_t> packet = {
+        0x00,                   // Delimiter
+        0x00,                   // Empty packet
+        0x02, 0x11, 0x01, 0x01, // data
+        0x03, 0x22, 0x33,       //
+        // No delimiter
+    };
+    for (auto c : packet)
+        EXPECT_EQ(parser.parse(c), 0);
+    size_t size = parser.parse(0x00);
+    buffer.resize(size);
+    std::vector<uint8_t> expected = {0x11, 0x00, 0x00, 0x00, 0x22, 0x33};
+    EXPECT_EQ(buffer, expected);
+    EXPECT_FALSE(parser.wasTruncated());
+}
+
+TEST(COBSParser, incompleteBlock) {
+    std::vector<uint8_t> buffer(64);
+    COBSParser parser = {buffer.data(), buffer.size()};
+
+    // The code byte promises four data bytes, but the packet ends after two
+    std::vector<uint8_t> packet = {0x05, 0x11, 0x22};
+    for (auto c : packet)
+        EXPECT_EQ(parser.parse(c), 0);
+    EXPECT_EQ(parser.parse(0x00), 0);
+
+    // The next packet is received correctly
+    packet = {0x03, 0x11, 0x22};
+    for (auto c : packet)
+        EXPECT_EQ(parser.parse(c), 0);
+    EXPECT_EQ(parser.parse(0x00), 2);
+    EXPECT_EQ(buffer[1], 0x22);
+}
+
+TEST(COBSParser, truncate) {
+    std::vector<uint8_t> buffer(4);
+    COBSParser parser = {buffer.data(), buffer.size()};
+    std::vector<uint8_t> packet = {0x07, 1, 2, 3, 4, 5, 6};
+    for (auto c : packet)
+        EXPECT_EQ(parser.parse(c), 0);
+    EXPECT_EQ(parser.parse(0x00), 4);
+    EXPECT_TRUE(parser.wasTruncated());
+    EXPECT_EQ(parser.numTruncated(), 2);
+}
+
+TEST(COBSParser, roundTrip) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> length(0, 1024);
+    std::vector<uint8_t> buffer(1024);
+    COBSParser parser = {buffer.data(), buffer.size()};
+
+    for (int i = 0; i < 100; ++i) {
+        std::vector<uint8_t> data(length(rng));
+        // Mostly zeros, mostly non-zero, or uniform
+        int kind = i % 3;
+        for (auto &d : data)
+            d = kind == 0 ? (byte(rng) < 240 ? 0 : byte(rng))
+                          : kind == 1 ? (byte(rng) < 2 ? 0 : byte(rng) | 1)
+                                      : byte(rng);
+
+        std::vector<uint8_t> encoded;
+        auto sender = [&encoded](uint8_t c) { return encoded.push_back(c), 1; };
+        COBSSender<decltype(sender)> cobssender(std::move(sender));
+        cobssender.beginPacket();
+        cobssender.write(data.data(), data.size());
+        cobssender.endPacket();
+        ASSERT_LE(encoded.size(), COBS_maxFrameLength(data.size()));
+
+        size_t size = 0;
+        for (auto c : encoded)
+            size = parser.parse(c);
+        ASSERT_EQ(size, data.size());
+        ASSERT_EQ(std::vector<uint8_t>(buffer.begin(), buffer.begin() + size),
+                  data);
+    }
+}
+
+TEST(COBSParser, parsePacketCRC) {
+    std::vector<uint8_t> buffer(64);
+
+    using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+
+    COBSParserCRC<CRC> parser = {{buffer.data(), buffer.size()}, CRC()};
+
+    std::vector<uint8_t> packet = {
+        0x00,                                                 // Delimiter
+        0x0C,                                                 // Code
+        0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, // data
+        0x29, 0xB1,                                           // Checksum
+        // No delimiter
+    };
+    std::vector<uint8_t> data = {0x31, 0x32, 0x33, 0x34, 0x35,
+                                 0x36, 0x37, 0x38, 0x39};
+    for (auto c : packet)
+        EXPECT_EQ(parser.parse(c), 0);
+    size_t size = parser.parse(0x00);
+    buffer.resize(size);
+    EXPECT_EQ(buffer, data);
+    EXPECT_EQ(parser.checksum(), 0);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <COBSStream/COBSSender.hpp>
+#include <boost/crc.hpp>
+
+#include <vector>
+
+static std::vector<uint8_t> encode(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> buffer;
+    auto sender = [&buffer](uint8_t c) { return buffer.push_back(c), 1; };
+    COBSSender<decltype(sender)> cobssender(std::move(sender));
+    size_t sent = cobssender.beginPacket();
+    sent += cobssender.write(data.data(), data.size());
+    sent += cobssender.endPacket();
+    EXPECT_EQ(sent, buffer.size());
+    return buffer;
+}
+
+// Examples from https://en.wikipedia.org/wiki/Consistent_Overhead_Byte_Stuffing
+TEST(COBSSender, examples) {
+    EXPECT_EQ(encode({}), std::vector<uint8_t>({0x00, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x00}), std::vector<uint8_t>({0x00, 0x01, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x00, 0x00}),
+              std::vector<uint8_t>({0x00, 0x01, 0x01, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x00, 0x11, 0x00}),
+              std::vector<uint8_t>({0x00, 0x01, 0x02, 0x11, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x22, 0x00, 0x33}),
+              std::vector<uint8_t>({0x00, 0x03, 0x11, 0x22, 0x02, 0x33, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x22, 0x33, 0x44}),
+              std::vector<uint8_t>({0x00, 0x05, 0x11, 0x22, 0x33, 0x44, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x00, 0x00, 0x00}),
+              std::vector<uint8_t>({0x00, 0x02, 0x11, 0x01, 0x01, 0x01, 0x00}));
+}
+
+TEST(COBSSender, longBlocks) {
+    // 01 02 03 ... FD FE
+    std::vector<uint8_t> data(254);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = i + 1;
+    std::vector<uint8_t> expected = {0x00, 0xFF};
+    expected.insert(expected.end(), data.begin(), data.end());
+    expected.push_back(0x00);
+    EXPECT_EQ(encode(data), expected);
+
+    // 00 01 02 ... FC FD FE
+    data.insert(data.begin(), 0x00);
+    expected = {0x00, 0x01, 0xFF};
+    expected.insert(expected.end(), data.begin() + 1, data.end());
+    expected.push_back(0x00);
+    EXPECT_EQ(encode(data), expected);
+
+    // 01 02 03 ... FD FE FF
+    data.erase(data.begin());
+    data.push_back(0xFF);
+    expected = {0x00, 0xFF};
+    expected.insert(expected.end(), data.begin(), data.end() - 1);
+    expected.insert(expected.end(), {0x02, 0xFF, 0x00});
+    EXPECT_EQ(encode(data), expected);
+}
+
+TEST(COBSSender, boundedOverhead) {
+    // Worst case for SLIP: every byte has to be escaped
+    std::vector<uint8_t> data(1000, 0xC0);
+    auto encoded = encode(data);
+    EXPECT_EQ(encoded.size(), 1000 + 4 + 2);
+    EXPECT_LE(encoded.size(), COBS_maxFrameLength(data.size()));
+    for (size_t len : {0, 1, 253, 254, 255, 508, 509, 1000}) {
+        for (uint8_t fill : {0x00, 0x01}) {
+            std::vector<uint8_t> data(len, fill);
+            EXPECT_LE(encode(data).size(), COBS_maxFrameLength(len))
+                << "len = " << len;
+        }
+    }
+}
+
+TEST(COBSSender, writePacketCRC) {
+    std::vector<uint8_t> buffer;
+
+    // This is "123456789" in ASCII
+    unsigned char const data[] = {0x31, 0x32, 0x33, 0x34, 0x35,
+                                  0x36, 0x37, 0x38, 0x39};
+
+    using CRC   = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+    auto sender = [&buffer](uint8_t c) { return buffer.push_back(c), 1; };
+    COBSSenderCRC<decltype(sender), CRC> cobssender(std::move(sender), CRC());
+
+    cobssender.beginPacket();
+    cobssender.write(data, 4);
+    cobssender.write(data + 4, sizeof(data) - 4);
+    cobssender.endPacket();
+
+    std::vector<uint8_t> expected = {
+        0x00,                                                 // Delimiter
+        0x0C,                                                 // Code
+        0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, // data
+        0x29, 0xB1,                                           // Checksum
+        0x00,                                                 // Delimiter
+    };
+    EXPECT_EQ(expected, buffer);
+}
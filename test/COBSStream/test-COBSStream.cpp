@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <COBSStream/COBSStream.hpp>
+#include <SLIPStream/SLIPStream.hpp>
+#include <boost/crc.hpp>
+
+#include <vector>
+
+namespace {
+
+struct MockStream : Stream {
+    int read() override {
+        return readIndex < readLength ? readBuffer[readIndex++] : -1;
+    }
+
+    int peek() override {
+        return readIndex < readLength ? readBuffer[readIndex] : -1;
+    }
+
+    int available() override { return readLength - readIndex; }
+
+    size_t write(uint8_t c) override {
+        if (writeIndex < writeLength) {
+            writeBuffer[writeIndex++] = c;
+            return 1;
+        } else {
+            return 0;
+        }
+    }
+
+    const uint8_t *readBuffer = nullptr;
+    size_t readLength         = 0;
+    size_t readIndex          = 0;
+
+    uint8_t *writeBuffer = nullptr;
+    size_t writeLength   = 0;
+    size_t writeIndex    = 0;
+};
+
+} // namespace
+
+TEST(COBSStream, send) {
+    MockStream stream;
+    std::vector<uint8_t> writeBuffer(300);
+    stream.writeBuffer = writeBuffer.data();
+    stream.writeLength = writeBuffer.size();
+
+    COBSStream cobsstream = {stream};
+    std::vector<uint8_t> packet = {0x11, 0x22, 0x00, 0x33};
+    EXPECT_EQ(cobsstream.writePacket(packet.data(), packet.size()), 7);
+
+    std::vector<uint8_t> expected = {0x00, 0x03, 0x11, 0x22, 0x02, 0x33, 0x00};
+    writeBuffer.resize(stream.writeIndex);
+    EXPECT_EQ(writeBuffer, expected);
+}
+
+TEST(COBSStream, read) {
+    MockStream stream;
+    std::vector<uint8_t> input = {
+        0x00, 0x03, 0x11, 0x22, 0x02, 0x33, 0x00, // 1
+        0x00, 0x01, 0x01, 0x00,                   // 2
+    };
+    stream.readBuffer = input.data();
+    stream.readLength = input.size();
+
+    std::vector<uint8_t> packetBuffer(300);
+    COBSStream cobsstream = {
+        stream,
+        {packetBuffer.data(), packetBuffer.size()},
+    };
+
+    size_t size = cobsstream.readPacket();
+    EXPECT_EQ(std::vector<uint8_t>(packetBuffer.begin(),
+                                   packetBuffer.begin() + size),
+              std::vector<uint8_t>({0x11, 0x22, 0x00, 0x33}));
+    size = cobsstream.readPacket();
+    EXPECT_EQ(std::vector<uint8_t>(packetBuffer.begin(),
+                                   packetBuffer.begin() + size),
+              std::vector<uint8_t>({0x00}));
+    EXPECT_EQ(cobsstream.readPacket(), 0);
+}
+
+TEST(COBSStreamCRC, sendAndRead) {
+    using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+
+    MockStream stream;
+    std::vector<uint8_t> wire(300);
+    stream.writeBuffer = wire.data();
+    stream.writeLength = wire.size();
+    stream.readBuffer  = wire.data();
+
+    std::vector<uint8_t> packetBuffer(300);
+    COBSStreamCRC<CRC> cobsstream = {
+        stream,
+        CRC(),
+        {packetBuffer.data(), packetBuffer.size()},
+        CRC(),
+    };
+
+    std::vector<uint8_t> packet = {0x00, 0xC0, 0xDB, 0x00, 0x42};
+    cobsstream.writePacket(packet.data(), packet.size());
+    stream.readLength = stream.writeIndex;
+
+    size_t size = cobsstream.readPacket();
+    EXPECT_EQ(cobsstream.checksum(), 0);
+    EXPECT_FALSE(cobsstream.wasTruncated());
+    EXPECT_EQ(std::vector<uint8_t>(packetBuffer.begin(),
+                                   packetBuffer.begin() + size),
+              packet);
+}
+
+TEST(COBSStream, overheadComparedToSLIP) {
+    // A float-heavy payload where SLIP has to escape many bytes
+    std::vector<uint8_t> packet;
+    for (int i = 0; i < 256; ++i)
+        packet.insert(packet.end(), {0xC0, 0xDB, 0x12, 0x34});
+
+    std::vector<uint8_t> slipBuffer(4096), cobsBuffer(4096);
+    MockStream slipMock, cobsMock;
+    slipMock.writeBuffer = slipBuffer.data();
+    slipMock.writeLength = slipBuffer.size();
+    cobsMock.writeBuffer = cobsBuffer.data();
+    cobsMock.writeLength = cobsBuffer.size();
+
+    SLIPStream slip = {slipMock};
+    COBSStream cobs = {cobsMock};
+    EXPECT_EQ(slip.writePacket(packet.data(), packet.size()),
+              2 + packet.size() * 3 / 2);
+    EXPECT_EQ(cobs.writePacket(packet.data(), packet.size()),
+              2 + packet.size() + 5);
+}
@@ -5,6 +5,7 @@
 #include <KVComm/KV_Parser.hpp>
 
 #include <iostream>
+#include <sstream>
 
 TEST(KV_Builder, nextWord) {
     EXPECT_EQ(nextWord(0), 4);
@@ -238,6 +239,117 @@ TEST(KV_Parser, incorrectAccess) {
     EXPECT_THROW(found->getAs<uint32_t>(), out_of_range);
 }
 
+TEST(KV_Parser, tryGetNoThrow) {
+    Static_KV_Builder<2048> logger;
+    EXPECT_TRUE(logger.add("value1", (uint32_t) 0xDEADBEEF));
+    EXPECT_TRUE(logger.add<int>("array", {1, 2, 3, 4}));
+    EXPECT_TRUE(logger.add("key", "value"));
+
+    const uint8_t *data = logger.getBuffer();
+    size_t length       = logger.getLength();
+    KV_Parser parsed    = {data, length};
+
+    // Correct
+    auto value1 = parsed.tryGetElement("value1")->tryGetAs<uint32_t>();
+    ASSERT_TRUE(value1);
+    EXPECT_EQ(value1.error(), KV_Errc::OK);
+    EXPECT_EQ(*value1, 0xDEADBEEF);
+    uint32_t u = 0;
+    EXPECT_EQ(parsed["value1"].tryGet(u), KV_Errc::OK);
+    EXPECT_EQ(u, 0xDEADBEEF);
+    EXPECT_STREQ(parsed["key"].tryGetString().value(), "value");
+    // Incorrect type
+    EXPECT_EQ(parsed["value1"].tryGetAs<float>().error(),
+              KV_Errc::TypeMismatch);
+    EXPECT_EQ(parsed["value1"].tryGetString().error(), KV_Errc::TypeMismatch);
+    // Index out of bounds
+    EXPECT_EQ(parsed["value1"].tryGetAs<uint32_t>(1).error(),
+              KV_Errc::IndexOutOfRange);
+    EXPECT_EQ(parsed["value1"].tryGetAs<uint32_t>(1).valueOr(42), 42);
+    // Non-existing key
+    EXPECT_FALSE(parsed.tryGetElement("value4"));
+    EXPECT_EQ(parsed.tryGetElement("value4").error(),
+              KV_Errc::NonExistentEntry);
+    EXPECT_EQ(parsed.tryGetElement("value4")->tryGetAs<float>().error(),
+              KV_Errc::NonExistentEntry);
+    EXPECT_EQ(parsed.find("value4"), parsed.end());
+    // Arrays
+    auto array = parsed["array"];
+    EXPECT_EQ((array.tryGetArray<int, 4>().value()),
+              (std::array<int, 4>{{1, 2, 3, 4}}));
+    EXPECT_EQ((array.tryGetArray<float, 4>().error()), KV_Errc::TypeMismatch);
+    EXPECT_EQ((array.tryGetArray<int, 3>().error()), KV_Errc::IncorrectLength);
+    // End iterator
+    auto found = logger.find("nonexistent");
+    EXPECT_EQ(found->tryGetAs<uint32_t>().error(), KV_Errc::NonExistentEntry);
+    // The error codes are the same as the ones used by the throwing functions
+    try {
+        parsed["value1"].getAs<float>();
+        FAIL();
+    } catch (KV_Exception &e) {
+        EXPECT_EQ(e.getErrorCode(), static_cast<int>(KV_Errc::TypeMismatch));
+    }
+}
+
+TEST(KV_Iterator, validate) {
+    Static_KV_Builder<2048> logger;
+    logger.add("value1", (uint32_t) 0xDEADBEEF);
+    logger.add("key", "value");
+    const uint8_t *data = logger.getBuffer();
+    size_t length       = logger.getLength();
+
+    EXPECT_EQ(KV_Iterator::validate(data, length), KV_Errc::OK);
+    // Trailing zeros are allowed
+    EXPECT_EQ(KV_Iterator::validate(data, logger.getBufferSize()), KV_Errc::OK);
+    // Truncated entries are not
+    for (size_t len = 1; len < length; ++len) {
+        if (len == 16) // 16 = end of first entry
+            continue;
+        EXPECT_EQ(KV_Iterator::validate(data, len), KV_Errc::Malformed)
+            << "len = " << len;
+    }
+
+    std::vector<uint8_t> buffer = {data, data + length};
+    auto corrupt = [&](size_t index, uint8_t value) {
+        std::vector<uint8_t> copy = buffer;
+        copy[index]               = value;
+        return copy;
+    };
+    // Data length too large
+    auto c1 = corrupt(2, 0xFF);
+    EXPECT_EQ(KV_Iterator::validate(c1.data(), c1.size()), KV_Errc::Malformed);
+    // Key length too large
+    auto c2 = corrupt(0, 0xFF);
+    EXPECT_EQ(KV_Iterator::validate(c2.data(), c2.size()), KV_Errc::Malformed);
+    // Key not null-terminated
+    auto c3 = corrupt(10, 'x');
+    EXPECT_EQ(KV_Iterator::validate(c3.data(), c3.size()), KV_Errc::Malformed);
+    // String not null-terminated
+    auto c4 = corrupt(24 + 5, 'x');
+    EXPECT_EQ(KV_Iterator::validate(c4.data(), c4.size()), KV_Errc::Malformed);
+}
+
+TEST(KV_Iterator, checkedIteration) {
+    Static_KV_Builder<2048> logger;
+    logger.add("value1", (uint32_t) 0xDEADBEEF);
+    logger.add("key", "value");
+    std::vector<uint8_t> buffer = {logger.getBuffer(),
+                                   logger.getBuffer() + logger.getLength()};
+    buffer[16 + 2] = 0xFF; // corrupt the data length of the second entry
+
+    KV_Iterator::iterator it = {buffer.data(), buffer.size(),
+                                KV_Iterator::Checked};
+    ASSERT_TRUE(it);
+    EXPECT_STREQ(it->getID(), "value1");
+    ++it;
+    EXPECT_FALSE(it);
+    EXPECT_TRUE(it.isMalformed());
+
+    KV_Parser parsed = {buffer.data(), buffer.size(), KV_Iterator::Checked};
+    EXPECT_TRUE(parsed.contains("value1"));
+    EXPECT_FALSE(parsed.contains("key"));
+}
+
 TEST(KV_Builder, clearAndReuse) {
     Static_KV_Builder<2048> logger;
     logger.add("value1", (uint32_t) 0xDEADBEEF);
@@ -459,4 +571,58 @@ TEST(KV_Builder, logDataOverWriteWrongType) {
     uint16_t u = 0;
     EXPECT_TRUE(logger.add("1", i));
     EXPECT_FALSE(logger.add("1", u));
-}
\ No newline at end of file
+}
+
+TEST(KV_Builder, print) {
+    Static_KV_Builder<32> dict;
+    dict.add("a", (uint8_t) 0x12);
+    std::string expected = "   0   01 02 01 00   . . . . \n"
+                           "   4   61 00 00 00   a . . . \n"
+                           "   8   12 00 00 00   . . . . \n";
+    std::ostringstream os;
+    dict.print(os);
+    EXPECT_EQ(os.str(), expected);
+
+    char buffer[128];
+    EXPECT_EQ(dict.print(buffer, sizeof(buffer)), expected.size());
+    EXPECT_EQ(buffer, expected);
+    // Truncated, but still null-terminated
+    EXPECT_EQ(dict.print(buffer, 10), expected.size());
+    EXPECT_EQ(std::string(buffer), expected.substr(0, 9));
+}
+
+TEST(KV_Builder, printAnnotated) {
+    Static_KV_Builder<64> dict;
+    dict.add("a", (uint8_t) 0x12);
+    dict.add("bc", 1.f);
+    std::string expected = "   0   01 02 01 00   . . . .   # \"a\" type 2, "
+                           "1 bytes\n"
+                           "   4   61 00 00 00   a . . . \n"
+                           "   8   12 00 00 00   . . . . \n"
+                           "  12   02 09 04 00   . . . .   # \"bc\" type 9, "
+                           "4 bytes\n"
+                           "  16   62 63 00 00   b c . . \n"
+                           "  20   00 00 80 3F   . . . ? \n";
+    std::ostringstream os;
+    dict.print(os, true);
+    EXPECT_EQ(os.str(), expected);
+    char buffer[512];
+    EXPECT_EQ(dict.print(buffer, sizeof(buffer), true), expected.size());
+    EXPECT_EQ(buffer, expected);
+}
+
+TEST(KV_Builder, printPython) {
+    Static_KV_Builder<32> dict;
+    dict.add("a", (uint8_t) 0x12);
+    std::string expected = "bytes((\n"
+                           "    0x01, 0x02, 0x01, 0x00,\n"
+                           "    0x61, 0x00, 0x00, 0x00,\n"
+                           "    0x12, 0x00, 0x00, 0x00,\n"
+                           "))\n";
+    std::ostringstream os;
+    dict.printPython(os);
+    EXPECT_EQ(os.str(), expected);
+    char buffer[128];
+    EXPECT_EQ(dict.printPython(buffer, sizeof(buffer)), expected.size());
+    EXPECT_EQ(buffer, expected);
+}
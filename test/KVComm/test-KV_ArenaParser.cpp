@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_ArenaParser.hpp>
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_KeyTable.hpp>
+
+#include <cstdlib> // malloc, free
+#include <new>     // std::bad_alloc
+
+// Count all allocations in the test executable.
+static size_t numAllocations = 0;
+
+void *operator new(size_t size) {
+    ++numAllocations;
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+TEST(KV_ArenaParser, parse) {
+    Static_KV_Builder<256> logger;
+    logger.add("value1", (uint32_t) 0xDEADBEEF);
+    logger.add("value2", (uint8_t) 0x3C);
+    logger.add("key", "value");
+    logger.add("bool", true);
+
+    KV_ArenaParser parsed = {logger.getBuffer(), logger.getLength()};
+    EXPECT_EQ(parsed.size(), 4);
+    EXPECT_EQ(parsed["value1"].getAs<uint32_t>(), 0xDEADBEEF);
+    EXPECT_EQ(parsed["value2"].getAs<uint8_t>(), 0x3C);
+    EXPECT_STREQ(parsed["key"].getString(), "value");
+    EXPECT_EQ(parsed["bool"].getAs<bool>(), true);
+    EXPECT_TRUE(parsed.contains("key"));
+    EXPECT_FALSE(parsed.contains("value3"));
+    EXPECT_THROW(parsed["value3"], std::out_of_range);
+
+    std::vector<std::string> keys;
+    for (auto &entry : parsed)
+        keys.push_back(entry.first);
+    std::vector<std::string> expected = {"bool", "key", "value1", "value2"};
+    EXPECT_EQ(keys, expected);
+}
+
+TEST(KV_ArenaParser, duplicateKeys) {
+    // Two entries with the same key, the first one should win (like KV_Parser)
+    std::vector<uint8_t> buffer = {
+        0x01, 0x02, 0x01, 0x00, //
+        'a',  0x00, 0x00, 0x00, //
+        0x11, 0x00, 0x00, 0x00, //
+        0x01, 0x02, 0x01, 0x00, //
+        'a',  0x00, 0x00, 0x00, //
+        0x22, 0x00, 0x00, 0x00, //
+    };
+    KV_ArenaParser parsed = {buffer.data(), buffer.size()};
+    EXPECT_EQ(parsed.size(), 1);
+    EXPECT_EQ(parsed["a"].getAs<uint8_t>(), 0x11);
+}
+
+TEST(KV_ArenaParser, duplicateKeyIDs) {
+    // Entries with the same key ID resolve to the same key string, the first
+    // one should still win
+    static const char *names[] = {"a", "b", "c"};
+    KV_KeyTable keys = names;
+    std::vector<uint8_t> buffer;
+    for (uint8_t i = 0; i < 40; ++i) {
+        uint8_t id = 1 + i % 2;
+        std::vector<uint8_t> entry = {
+            0x02, 0x02, 0x01, 0x00, // key len 2, type 2, size 1
+            0x00, id,   0x00, 0x00, // key ID
+            i,    0x00, 0x00, 0x00, //
+        };
+        buffer.insert(buffer.end(), entry.begin(), entry.end());
+    }
+    KV_ArenaParser parsed;
+    parsed.reparse(buffer.data(), buffer.size(), KV_Iterator::Checked, &keys);
+    EXPECT_FALSE(parsed.isMalformed());
+    EXPECT_EQ(parsed.size(), 2);
+    EXPECT_EQ(parsed["b"].getAs<uint8_t>(), 0);
+    EXPECT_EQ(parsed["c"].getAs<uint8_t>(), 1);
+}
+
+TEST(KV_ArenaParser, reparseDoesNotAllocate) {
+    Static_KV_Builder<512> logger;
+    logger.add("The meaning of life, the universe and everything", 42);
+    logger.add("π", 3.14159265358979323846);
+    logger.add("message", "The EAGLE has landed");
+    logger.add<float>("motor outputs", {0.56, 0.55, 0.54, 0.57});
+
+    KV_ArenaParser parsed;
+    parsed.reparse(logger.getBuffer(), logger.getLength()); // warm up
+
+    size_t allocationsBefore = numAllocations;
+    for (int i = 0; i < 1000; ++i) {
+        logger.add("The meaning of life, the universe and everything", i);
+        parsed.reparse(logger.getBuffer(), logger.getLength());
+        ASSERT_TRUE(parsed.contains("π"));
+        ASSERT_EQ(parsed["The meaning of life, the universe and everything"]
+                      .getAs<int>(),
+                  i);
+        ASSERT_EQ(parsed["motor outputs"].getAs<float>(3), 0.57f);
+    }
+    EXPECT_EQ(numAllocations, allocationsBefore);
+
+    // Smaller dictionaries reuse the same memory as well
+    Static_KV_Builder<64> small;
+    small.add("x", 1);
+    parsed.reparse(small.getBuffer(), small.getLength());
+    EXPECT_EQ(numAllocations, allocationsBefore);
+    EXPECT_EQ(parsed.size(), 1);
+    EXPECT_FALSE(parsed.contains("π"));
+}
+
+TEST(KV_ArenaParser, reserve) {
+    Static_KV_Builder<256> logger;
+    logger.add("a", 1);
+    logger.add("b", 2);
+    logger.add("c", 3);
+
+    KV_ArenaParser parsed;
+    parsed.reserve(3);
+    size_t allocationsBefore = numAllocations;
+    parsed.reparse(logger.getBuffer(), logger.getLength());
+    EXPECT_EQ(numAllocations, allocationsBefore);
+    EXPECT_EQ(parsed["c"].getAs<int>(), 3);
+}
+
+TEST(KV_ArenaParser, malformed) {
+    Static_KV_Builder<256> logger;
+    logger.add("a", 1);
+    logger.add("b", 2);
+    std::vector<uint8_t> buffer = {logger.getBuffer(),
+                                   logger.getBuffer() + logger.getLength()};
+
+    KV_ArenaParser parsed;
+    parsed.reparse(buffer.data(), buffer.size() - 1, KV_Iterator::Checked);
+    EXPECT_TRUE(parsed.isMalformed());
+    EXPECT_TRUE(parsed.contains("a"));
+    EXPECT_FALSE(parsed.contains("b"));
+    parsed.reparse(buffer.data(), buffer.size(), KV_Iterator::Checked);
+    EXPECT_FALSE(parsed.isMalformed());
+    EXPECT_TRUE(parsed.contains("b"));
+}
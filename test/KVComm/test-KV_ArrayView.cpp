@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_ArrayView.hpp>
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_NarrowTypes.hpp>
+#include <KVComm/KV_Parser.hpp>
+
+#include <numeric>
+#include <vector>
+
+TEST(KV_ArrayView, layout) {
+    Static_KV_Builder<64> dict;
+    const uint8_t matrix[2][3] = {{1, 2, 3}, {4, 5, 6}};
+    ASSERT_TRUE(dict.addArray("m", matrix));
+
+    std::vector<uint8_t> expected = {
+        0x01, 0x82, 0x0E, 0x00, // key len 1, type 0x80 | 2, size 14
+        'm',  0x00, 0x00, 0x00, //
+        0x02, 0x00, 0x02, 0x00, // rank 2, 2 rows
+        0x03, 0x00, 0x00, 0x00, // 3 columns, padding
+        0x01, 0x02, 0x03, 0x04, // data
+        0x05, 0x06, 0x00, 0x00, //
+    };
+    std::vector<uint8_t> result = {dict.getBuffer(),
+                                   dict.getBuffer() + dict.getLength()};
+    EXPECT_EQ(result, expected);
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength(),
+                        KV_Iterator::Checked};
+    EXPECT_TRUE(parsed["m"].hasShape());
+    EXPECT_EQ(parsed["m"].getRank(), 2);
+    EXPECT_EQ(parsed["m"].getElementTypeID(), KV_Type<uint8_t>::getTypeID());
+    EXPECT_FALSE(parsed["m"].hasType<uint8_t>());
+}
+
+TEST(KV_ArrayView, matrixViews) {
+    alignas(8) uint8_t buffer[256] = {};
+    KV_Builder dict = {buffer, sizeof(buffer)};
+    float matrix[3][4];
+    std::iota(&matrix[0][0], &matrix[0][0] + 12, 0.f);
+    ASSERT_TRUE(dict.addArray("matrix", matrix));
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength()};
+    KV_ArrayView<float> view = parsed["matrix"].getArrayView<float>();
+    ASSERT_EQ(view.rank(), 2);
+    EXPECT_EQ(view.size(0), 3);
+    EXPECT_EQ(view.size(1), 4);
+    EXPECT_EQ(view.size(), 12);
+    EXPECT_EQ(view(0, 0), 0.f);
+    EXPECT_EQ(view(1, 2), 6.f);
+    EXPECT_EQ(view(2, 3), 11.f);
+
+    // Column-major access
+    KV_ArrayView<float> transposed = view.transposed();
+    EXPECT_EQ(transposed.size(0), 4);
+    EXPECT_EQ(transposed.size(1), 3);
+    EXPECT_EQ(transposed(2, 1), 6.f);
+    EXPECT_FALSE(transposed.isContiguous());
+    float columnMajor[12];
+    transposed.copyTo(columnMajor);
+    EXPECT_EQ(columnMajor[0], 0.f);
+    EXPECT_EQ(columnMajor[1], 4.f);
+    EXPECT_EQ(columnMajor[2], 8.f);
+    EXPECT_EQ(columnMajor[3], 1.f);
+    EXPECT_EQ(columnMajor[11], 11.f);
+
+    // Rows and columns
+    KV_ArrayView<float> row = view.slice(0, 1);
+    ASSERT_EQ(row.rank(), 1);
+    EXPECT_EQ(row.size(), 4);
+    EXPECT_EQ(row(3), 7.f);
+    EXPECT_TRUE(row.isContiguous());
+    KV_ArrayView<float> column = view.slice(1, 2);
+    ASSERT_EQ(column.rank(), 1);
+    EXPECT_EQ(column.size(), 3);
+    EXPECT_EQ(column.stride(0), 4);
+    EXPECT_EQ(column(2), 10.f);
+    EXPECT_FALSE(column.isContiguous());
+    EXPECT_EQ(column.contiguous(), nullptr);
+
+    // Zero-copy access to the aligned, dense data
+    const float *data = view.contiguous();
+#if !KV_BIG_ENDIAN
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(data[5], 5.f);
+    EXPECT_EQ(row.contiguous(), data + 4);
+#endif
+    std::vector<float> copy(view.size());
+    view.copyTo(copy.data());
+    EXPECT_EQ(copy, std::vector<float>(&matrix[0][0], &matrix[0][0] + 12));
+}
+
+TEST(KV_ArrayView, higherRank) {
+    Static_KV_Builder<512> dict;
+    std::vector<int16_t> data(2 * 3 * 4 * 5);
+    std::iota(data.begin(), data.end(), -60);
+    ASSERT_TRUE(dict.addArray("tensor", data.data(), {2, 3, 4, 5}));
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength(),
+                        KV_Iterator::Checked};
+    auto view = parsed["tensor"].tryGetArrayView<int16_t>();
+    ASSERT_TRUE(view);
+    EXPECT_EQ(view->rank(), 4);
+    EXPECT_EQ((*view)(1, 2, 3, 4), 59);
+    EXPECT_EQ((*view)(1, 0, 2, 1), -60 + 60 + 10 + 1);
+    size_t idx[] = {0, 1, 0, 3};
+    EXPECT_EQ(view->at(idx), -60 + 20 + 3);
+    EXPECT_EQ(view->slice(2, 3).slice(0, 1)(2, 4), -60 + 60 + 40 + 15 + 4);
+
+    // The wrong element type
+    EXPECT_EQ(parsed["tensor"].tryGetArrayView<uint16_t>().error(),
+              KV_Errc::TypeMismatch);
+    EXPECT_THROW(parsed["tensor"].getArrayView<uint16_t>(), KV_Exception);
+    EXPECT_EQ(KV_Iterator::KV().tryGetArrayView<int16_t>().error(),
+              KV_Errc::NonExistentEntry);
+    EXPECT_THROW(KV_Iterator::KV().getArrayView<int16_t>(), KV_Exception);
+}
+
+TEST(KV_ArrayView, narrowTypes) {
+    Static_KV_Builder<128> dict;
+    const float matrix[2][2] = {{0.5f, -0.25f}, {0.125f, 1.5f}};
+    ASSERT_TRUE(dict.addArrayAs<KV_Float16>("half", &matrix[0][0], {2, 2}));
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength()};
+    auto view = parsed["half"].getArrayView<KV_Float16>();
+    EXPECT_EQ(view(1, 1), 1.5f);
+    EXPECT_EQ(view.transposed()(0, 1), 0.125f);
+    // The elements have to be converted, so there's no zero-copy access
+    EXPECT_EQ(view.contiguous(), nullptr);
+    float out[4];
+    view.copyTo(out);
+    EXPECT_EQ(out[1], -0.25f);
+    EXPECT_EQ(out[2], 0.125f);
+}
+
+TEST(KV_ArrayView, flatArrays) {
+    Static_KV_Builder<128> dict;
+    dict.add<uint32_t>("flat", {1, 2, 3});
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength()};
+    EXPECT_FALSE(parsed["flat"].hasShape());
+    EXPECT_EQ(parsed["flat"].getRank(), 1);
+    auto view = parsed["flat"].getArrayView<uint32_t>();
+    ASSERT_EQ(view.rank(), 1);
+    EXPECT_EQ(view.size(), 3);
+    EXPECT_EQ(view(2), 3);
+}
+
+TEST(KV_ArrayView, overwrite) {
+    Static_KV_Builder<256> dict;
+    uint16_t a[2][3] = {{1, 2, 3}, {4, 5, 6}};
+    ASSERT_TRUE(dict.addArray("m", a));
+    size_t length = dict.getLength();
+
+    // Same shape: overwritten in place
+    a[1][2] = 42;
+    ASSERT_TRUE(dict.addArray("m", a));
+    EXPECT_EQ(dict.getLength(), length);
+    EXPECT_EQ(dict.find("m")->getArrayView<uint16_t>()(1, 2), 42);
+
+    // Same number of elements, but a different shape
+    uint16_t b[3][2] = {};
+    EXPECT_FALSE(dict.addArray("m", b));
+    // Same number of elements, but without a shape
+    EXPECT_FALSE(dict.add("m", &a[0][0], 6));
+    EXPECT_EQ(dict.find("m")->getArrayView<uint16_t>()(1, 2), 42);
+
+    // Invalid ranks and shapes
+    const uint16_t shape[9] = {1, 1, 1, 1, 1, 1, 1, 1, 1};
+    EXPECT_FALSE(dict.addArray("r", &a[0][0], shape, 0));
+    EXPECT_FALSE(dict.addArray("r", &a[0][0], shape, 9));
+    EXPECT_TRUE(dict.addArray("r", &a[0][0], shape, 8));
+    EXPECT_FALSE(dict.addArray("big", &a[0][0], {256, 256}));
+}
+
+TEST(KV_ArrayView, malformed) {
+    Static_KV_Builder<64> dict;
+    const uint8_t matrix[2][3] = {{1, 2, 3}, {4, 5, 6}};
+    ASSERT_TRUE(dict.addArray("m", matrix));
+    std::vector<uint8_t> buffer = {dict.getBuffer(),
+                                   dict.getBuffer() + dict.getLength()};
+    EXPECT_EQ(KV_Iterator::validate(buffer.data(), buffer.size()),
+              KV_Errc::OK);
+
+    // The shape doesn't match the length of the data
+    buffer[12] = 0x04;
+    KV_Iterator dict2 = {buffer.data(), buffer.size()};
+    EXPECT_EQ(dict2.find("m")->tryGetArrayView<uint8_t>().error(),
+              KV_Errc::Malformed);
+    EXPECT_THROW(dict2.find("m")->getArrayView<uint8_t>(), KV_Exception);
+
+    // Unsupported rank
+    buffer[8] = 0x00;
+    EXPECT_EQ(KV_Iterator::validate(buffer.data(), buffer.size()),
+              KV_Errc::Malformed);
+    buffer[8] = 0x09;
+    EXPECT_EQ(KV_Iterator::validate(buffer.data(), buffer.size()),
+              KV_Errc::Malformed);
+    // The shape header doesn't fit
+    buffer[8] = 0x06;
+    EXPECT_EQ(KV_Iterator::validate(buffer.data(), buffer.size()),
+              KV_Errc::Malformed);
+}
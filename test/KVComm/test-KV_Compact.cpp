@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_Compact.hpp>
+#include <KVComm/KV_Parser.hpp>
+
+#include <vector>
+
+TEST(KV_Compact, varint) {
+    uint8_t buffer[10];
+    uint64_t value;
+    EXPECT_EQ(KV_Compact::writeVarint(0, buffer, 10), 1);
+    EXPECT_EQ(buffer[0], 0x00);
+    EXPECT_EQ(KV_Compact::writeVarint(300, buffer, 10), 2);
+    EXPECT_EQ(buffer[0], 0xAC);
+    EXPECT_EQ(buffer[1], 0x02);
+    EXPECT_EQ(KV_Compact::readVarint(value, buffer, 2), 2);
+    EXPECT_EQ(value, 300);
+    EXPECT_EQ(KV_Compact::readVarint(value, buffer, 1), 0); // truncated
+    EXPECT_EQ(KV_Compact::writeVarint(300, buffer, 1), 0);  // doesn't fit
+    EXPECT_EQ(KV_Compact::writeVarint(UINT64_MAX, buffer, 10), 10);
+    EXPECT_EQ(KV_Compact::readVarint(value, buffer, 10), 10);
+    EXPECT_EQ(value, UINT64_MAX);
+}
+
+TEST(KV_Compact, zigzag) {
+    EXPECT_EQ(KV_Compact::zigzagEncode(0), 0);
+    EXPECT_EQ(KV_Compact::zigzagEncode(-1), 1);
+    EXPECT_EQ(KV_Compact::zigzagEncode(1), 2);
+    EXPECT_EQ(KV_Compact::zigzagEncode(-2), 3);
+    EXPECT_EQ(KV_Compact::zigzagEncode(INT64_MIN), UINT64_MAX);
+    for (int64_t i : {int64_t(0), int64_t(-1), int64_t(12345), INT64_MIN,
+                      INT64_MAX})
+        EXPECT_EQ(KV_Compact::zigzagDecode(KV_Compact::zigzagEncode(i)), i);
+}
+
+TEST(KV_Compact, encode) {
+    Static_KV_Builder<256> logger;
+    logger.add("u8", (uint8_t) 0xAA);
+    logger.add("i", {-1, 300});
+    logger.add("b", true);
+
+    std::vector<uint8_t> compact(256);
+    auto size = KV_Compact::encode(logger.getBuffer(), logger.getLength(),
+                                   compact.data(), compact.size());
+    ASSERT_TRUE(size);
+    compact.resize(size.value());
+
+    std::vector<uint8_t> expected = {
+        0x01,                         // flags
+        0x02, 0x02, 0x01, 'u', '8',   // key len, type, data len, key
+        0xAA,                         // data
+        0x01, 0x05, 0x08, 'i',        // key len, type, data len, key
+        0x01,                         // -1 (zig-zag)
+        0xD8, 0x04,                   // 300 (zig-zag)
+        0x01, 0x0B, 0x01, 'b',        // key len, type, data len, key
+        0x01,                         // true
+    };
+    EXPECT_EQ(compact, expected);
+    EXPECT_EQ(logger.getLength(), 40);
+}
+
+TEST(KV_Compact, roundTrip) {
+    Static_KV_Builder<1024> logger;
+    logger.add("value1", (uint32_t) 0xDEADBEEF);
+    logger.add("value2", (uint8_t) 0x3C);
+    logger.add("value3", (float) 3.14);
+    logger.add("key", "value");
+    logger.add("🔑", "λ");
+    logger.add("bool", true);
+    logger.add<int16_t>("i16", {-32768, -1, 0, 1, 32767});
+    logger.add<uint64_t>("u64", {0, UINT64_MAX});
+    logger.add<int64_t>("i64", {INT64_MIN, INT64_MAX});
+    logger.add<double>("array", {-1.0, -2.0, -3.0});
+    logger.add("empty", std::vector<uint8_t>{});
+
+    for (uint8_t flags : {KV_Compact::None, KV_Compact::VarintIntegers}) {
+        std::vector<uint8_t> compact(1024);
+        auto compactSize =
+            KV_Compact::encode(logger.getBuffer(), logger.getLength(),
+                               compact.data(), compact.size(), flags);
+        ASSERT_TRUE(compactSize);
+        EXPECT_LT(compactSize.value(), logger.getLength());
+
+        alignas(8) uint8_t aligned[1024];
+        auto alignedSize = KV_Compact::decode(
+            compact.data(), compactSize.value(), aligned, sizeof(aligned));
+        ASSERT_TRUE(alignedSize);
+        std::vector<uint8_t> result = {aligned, aligned + alignedSize.value()};
+        std::vector<uint8_t> expected = {
+            logger.getBuffer(), logger.getBuffer() + logger.getLength()};
+        EXPECT_EQ(result, expected);
+
+        KV_Parser parsed = {aligned, alignedSize.value()};
+        EXPECT_EQ(parsed["value1"].getAs<uint32_t>(), 0xDEADBEEF);
+        EXPECT_STREQ(parsed["🔑"].getString(), "λ");
+        EXPECT_EQ(parsed["i16"].getAs<int16_t>(0), -32768);
+        EXPECT_EQ(parsed["i64"].getAs<int64_t>(0), INT64_MIN);
+        EXPECT_EQ(parsed["u64"].getAs<uint64_t>(1), UINT64_MAX);
+    }
+}
+
+TEST(KV_Compact, smallValuesOverhead) {
+    Static_KV_Builder<1024> logger;
+    const char *keys[] = {"a", "b", "c", "d", "e", "f", "g", "h"};
+    for (const char *key : keys)
+        logger.add(key, (uint8_t) 1);
+    uint8_t compact[1024];
+    auto size = KV_Compact::encode(logger.getBuffer(), logger.getLength(),
+                                   compact, sizeof(compact));
+    ASSERT_TRUE(size);
+    EXPECT_EQ(logger.getLength(), 8 * 12);
+    EXPECT_EQ(size.value(), 1 + 8 * 5);
+}
+
+TEST(KV_Compact, errors) {
+    Static_KV_Builder<256> logger;
+    logger.add("key", "value");
+    logger.add("int", 1234567);
+    uint8_t compact[256];
+    auto size = KV_Compact::encode(logger.getBuffer(), logger.getLength(),
+                                   compact, sizeof(compact));
+    ASSERT_TRUE(size);
+
+    // Output buffers that are too small
+    for (size_t i = 0; i < size.value(); ++i) {
+        uint8_t small[256];
+        EXPECT_EQ(KV_Compact::encode(logger.getBuffer(), logger.getLength(),
+                                     small, i)
+                      .error(),
+                  KV_Errc::BufferTooSmall)
+            << "i = " << i;
+    }
+    uint8_t aligned[256];
+    EXPECT_EQ(KV_Compact::decode(compact, size.value(), aligned,
+                                 logger.getLength() - 1)
+                  .error(),
+              KV_Errc::BufferTooSmall);
+
+    // Truncated input
+    for (size_t i = 0; i < size.value(); ++i) {
+        if (i == 1 || i == 1 + 3 + 3 + 6) // empty frame, end of first entry
+            continue;
+        EXPECT_EQ(KV_Compact::decode(compact, i, aligned, sizeof(aligned))
+                      .error(),
+                  KV_Errc::Malformed)
+            << "i = " << i;
+    }
+
+    // Unknown flags
+    compact[0] = 0x80;
+    EXPECT_EQ(
+        KV_Compact::decode(compact, size.value(), aligned, sizeof(aligned))
+            .error(),
+        KV_Errc::Malformed);
+}
+
+TEST(KV_Compact, varintOutOfRange) {
+    uint8_t compact[64];
+    uint8_t aligned[64];
+    // The largest values that fit are encoded as 0xFF 0xFF 0x03, changing the
+    // last byte to 0x04 gives a value that doesn't fit in 16 bits
+    Static_KV_Builder<64> unsignedDict;
+    unsignedDict.add("u", (uint16_t) 0xFFFF);
+    Static_KV_Builder<64> signedDict;
+    signedDict.add("i", (int16_t) INT16_MIN);
+    for (KV_Builder *dict : {(KV_Builder *) &unsignedDict,
+                             (KV_Builder *) &signedDict}) {
+        auto size = KV_Compact::encode(dict->getBuffer(), dict->getLength(),
+                                       compact, sizeof(compact));
+        ASSERT_TRUE(size);
+        ASSERT_EQ(compact[size.value() - 1], 0x03);
+        EXPECT_TRUE(
+            KV_Compact::decode(compact, size.value(), aligned, sizeof(aligned)));
+        compact[size.value() - 1] = 0x04;
+        EXPECT_EQ(
+            KV_Compact::decode(compact, size.value(), aligned, sizeof(aligned))
+                .error(),
+            KV_Errc::Malformed);
+    }
+}
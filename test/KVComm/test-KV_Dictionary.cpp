@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_ArenaParser.hpp>
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_Compact.hpp>
+#include <KVComm/KV_KeyTable.hpp>
+#include <KVComm/KV_Parser.hpp>
+
+#include <string>
+#include <vector>
+
+static size_t count(const KV_Iterator &dict) {
+    size_t n = 0;
+    for (auto it = dict.begin(); it; ++it)
+        ++n;
+    return n;
+}
+
+/// Builds {"motor": {"left": {"rpm": left}, "right": {"rpm": right}},
+///         "battery": 3.7}
+static void addTelemetry(KV_Builder &dict, int32_t left, int32_t right) {
+    Static_KV_Builder<64> leftDict, rightDict;
+    leftDict.add("rpm", left);
+    rightDict.add("rpm", right);
+    Static_KV_Builder<128> motor;
+    motor.addDictionary("left", leftDict);
+    motor.addDictionary("right", rightDict);
+    motor.add("rpm", -1); // not part of the path of the other entries
+    dict.addDictionary("motor", motor);
+    dict.add("battery", 3.7f);
+}
+
+TEST(KV_Dictionary, layout) {
+    Static_KV_Builder<64> inner;
+    inner.add("a", (uint8_t) 0x12);
+    Static_KV_Builder<64> outer;
+    ASSERT_TRUE(outer.addDictionary("d", inner));
+
+    std::vector<uint8_t> expected = {
+        0x01, 0x10, 0x0C, 0x00, // key len 1, type 16, size 12
+        'd',  0x00, 0x00, 0x00, //
+        0x01, 0x02, 0x01, 0x00, // key len 1, type 2, size 1
+        'a',  0x00, 0x00, 0x00, //
+        0x12, 0x00, 0x00, 0x00, //
+    };
+    std::vector<uint8_t> result = {outer.getBuffer(),
+                                   outer.getBuffer() + outer.getLength()};
+    EXPECT_EQ(result, expected);
+}
+
+TEST(KV_Dictionary, findPath) {
+    Static_KV_Builder<256> dict;
+    addTelemetry(dict, 1200, 1300);
+
+    KV_Iterator it = {dict.getBuffer(), dict.getLength()};
+    EXPECT_EQ(it.find("motor", "left", "rpm")->getAs<int32_t>(), 1200);
+    EXPECT_EQ(it.find("motor", "right", "rpm")->getAs<int32_t>(), 1300);
+    EXPECT_EQ(it.find("motor", "rpm")->getAs<int32_t>(), -1);
+    EXPECT_EQ(it.find("battery")->getAs<float>(), 3.7f);
+    // Non-existent keys, and values that aren't dictionaries
+    EXPECT_FALSE(it.find("motor", "middle", "rpm"));
+    EXPECT_FALSE(it.find("motor", "left", "rpm", "x"));
+    EXPECT_FALSE(it.find("battery", "rpm"));
+    EXPECT_FALSE(it.find("sensor", "left"));
+    // Nested entries are not part of the outer dictionary
+    EXPECT_FALSE(it.find("rpm"));
+    EXPECT_EQ(count(it), 2);
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength()};
+    ASSERT_TRUE(parsed["motor"].isDictionary());
+    EXPECT_FALSE(parsed["battery"].isDictionary());
+    KV_Iterator motor = parsed["motor"].getDictionary();
+    EXPECT_EQ(count(motor), 3);
+    EXPECT_EQ(motor.find("right", "rpm")->getAs<int32_t>(), 1300);
+    EXPECT_EQ(parsed["battery"].tryGetDictionary().error(),
+              KV_Errc::TypeMismatch);
+    EXPECT_EQ(KV_Iterator::KV().tryGetDictionary().error(),
+              KV_Errc::NonExistentEntry);
+    EXPECT_THROW(parsed["battery"].getDictionary(), KV_Exception);
+}
+
+TEST(KV_Dictionary, overwrite) {
+    Static_KV_Builder<256> dict;
+    addTelemetry(dict, 1200, 1300);
+    size_t length = dict.getLength();
+    // Same layout: the nested dictionary is overwritten in place
+    addTelemetry(dict, 1400, 1500);
+    EXPECT_EQ(dict.getLength(), length);
+    KV_Iterator it = {dict.getBuffer(), dict.getLength()};
+    EXPECT_EQ(it.find("motor", "left", "rpm")->getAs<int32_t>(), 1400);
+
+    // Different layout
+    Static_KV_Builder<64> other;
+    other.add("x", 1);
+    EXPECT_FALSE(dict.addDictionary("motor", other));
+    EXPECT_FALSE(dict.addDictionary("battery", other));
+}
+
+TEST(KV_Dictionary, keyIDs) {
+    static const char *names[] = {"motor", "left", "right", "rpm"};
+    KV_KeyTable keys = names;
+    Static_KV_Builder<64> left;
+    left.setKeyTable(&keys);
+    left.add("rpm", 1200);
+    Static_KV_Builder<64> motor;
+    motor.setKeyTable(&keys);
+    motor.addDictionary("left", left);
+    Static_KV_Builder<64> dict;
+    dict.setKeyTable(&keys);
+    dict.addDictionary("motor", motor);
+    // All keys are single words
+    EXPECT_EQ(dict.getLength(), 8 + 8 + 8 + 4);
+
+    KV_Iterator it = {dict.getBuffer(), dict.getLength(), KV_Iterator::Checked,
+                      &keys};
+    EXPECT_EQ(it.find("motor", "left", "rpm")->getAs<int>(), 1200);
+}
+
+TEST(KV_Dictionary, validate) {
+    Static_KV_Builder<256> dict;
+    addTelemetry(dict, 1200, 1300);
+    std::vector<uint8_t> buffer = {dict.getBuffer(),
+                                   dict.getBuffer() + dict.getLength()};
+    EXPECT_EQ(KV_Iterator::validate(buffer.data(), buffer.size()),
+              KV_Errc::OK);
+
+    // Compact encoding keeps the nested dictionaries intact
+    uint8_t compact[256];
+    alignas(4) uint8_t decoded[256];
+    auto size = KV_Compact::encode(buffer.data(), buffer.size(), compact,
+                                   sizeof(compact));
+    ASSERT_TRUE(size);
+    auto decodedSize = KV_Compact::decode(compact, size.value(), decoded,
+                                          sizeof(decoded));
+    ASSERT_TRUE(decodedSize);
+    KV_Iterator it = {decoded, decodedSize.value()};
+    EXPECT_EQ(it.find("motor", "right", "rpm")->getAs<int32_t>(), 1300);
+
+    // Corrupt the key length of the first nested entry (motor/left): the
+    // outer dictionary is still well-formed, but the nested one isn't
+    buffer[12] = 0xFF;
+    EXPECT_EQ(KV_Iterator::validate(buffer.data(), buffer.size()),
+              KV_Errc::Malformed);
+    KV_Iterator checked = {buffer.data(), buffer.size(), KV_Iterator::Checked};
+    EXPECT_EQ(count(checked), 2);
+    EXPECT_FALSE(checked.find("motor", "left", "rpm"));
+}
+
+TEST(KV_Dictionary, nestingDepth) {
+    Static_KV_Builder<256> levels[KV_Iterator::MaxNestingDepth + 2];
+    levels[0].add("value", 42);
+    for (size_t i = 1; i < KV_Iterator::MaxNestingDepth + 2; ++i)
+        ASSERT_TRUE(levels[i].addDictionary("d", levels[i - 1]));
+    auto &ok = levels[KV_Iterator::MaxNestingDepth];
+    EXPECT_EQ(KV_Iterator::validate(ok.getBuffer(), ok.getLength()),
+              KV_Errc::OK);
+    auto &tooDeep = levels[KV_Iterator::MaxNestingDepth + 1];
+    EXPECT_EQ(KV_Iterator::validate(tooDeep.getBuffer(), tooDeep.getLength()),
+              KV_Errc::Malformed);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_Endian.hpp>
+#include <KVComm/KV_Parser.hpp>
+
+#include <numeric>
+#include <vector>
+
+TEST(KV_Types, fixedWidthMapping) {
+    EXPECT_EQ(KV_Type<signed char>::getTypeID(), 1);
+    EXPECT_EQ(KV_Type<unsigned char>::getTypeID(), 2);
+    EXPECT_EQ(KV_Type<short>::getTypeID(), 3);
+    EXPECT_EQ(KV_Type<unsigned short>::getTypeID(), 4);
+    EXPECT_EQ(KV_Type<int>::getTypeID(), sizeof(int) == 4 ? 5 : 3);
+    EXPECT_EQ(KV_Type<unsigned>::getTypeID(), sizeof(int) == 4 ? 6 : 4);
+    EXPECT_EQ(KV_Type<long>::getTypeID(), sizeof(long) == 8 ? 7 : 5);
+    EXPECT_EQ(KV_Type<unsigned long>::getTypeID(), sizeof(long) == 8 ? 8 : 6);
+    EXPECT_EQ(KV_Type<long long>::getTypeID(), 7);
+    EXPECT_EQ(KV_Type<unsigned long long>::getTypeID(), 8);
+    EXPECT_EQ(KV_Type<float>::getTypeID(), 9);
+    EXPECT_EQ(KV_Type<double>::getTypeID(), sizeof(double) == 4 ? 9 : 10);
+    EXPECT_EQ(KV_Type<bool>::getTypeID(), 11);
+    EXPECT_EQ(KV_Type<char>::getTypeID(), 12);
+}
+
+// Frame as created on any architecture, using fixed-width types.
+static const std::vector<uint8_t> goldenFrame = {
+    0x01, 0x03, 0x02, 0x00, // key len 1, type int16, size 2
+    'a',  0x00, 0x00, 0x00, //
+    0xFE, 0xFF, 0x00, 0x00, // -2
+    0x01, 0x06, 0x04, 0x00, // key len 1, type uint32, size 4
+    'b',  0x00, 0x00, 0x00, //
+    0x78, 0x56, 0x34, 0x12, // 0x12345678
+    0x01, 0x07, 0x08, 0x00, // key len 1, type int64, size 8
+    'c',  0x00, 0x00, 0x00, //
+    0x08, 0x07, 0x06, 0x05, // 0x0102030405060708
+    0x04, 0x03, 0x02, 0x01, //
+    0x01, 0x09, 0x04, 0x00, // key len 1, type float, size 4
+    'd',  0x00, 0x00, 0x00, //
+    0x00, 0x00, 0x60, 0x40, // 3.5f
+    0x01, 0x0A, 0x08, 0x00, // key len 1, type double, size 8
+    'e',  0x00, 0x00, 0x00, //
+    0x00, 0x00, 0x00, 0x00, // 3.5
+    0x00, 0x00, 0x0C, 0x40, //
+    0x01, 0x04, 0x06, 0x00, // key len 1, type uint16, size 6
+    'f',  0x00, 0x00, 0x00, //
+    0x01, 0x02, 0x03, 0x04, // {0x0201, 0x0403, 0x0605}
+    0x05, 0x06, 0x00, 0x00, //
+};
+
+TEST(KV_Endian, goldenFrameBuild) {
+    Static_KV_Builder<256> dict;
+    dict.add("a", int16_t(-2));
+    dict.add("b", uint32_t(0x12345678));
+    dict.add("c", int64_t(0x0102030405060708));
+    dict.add("d", 3.5f);
+    dict.add("e", 3.5);
+    dict.add<uint16_t>("f", {0x0201, 0x0403, 0x0605});
+    std::vector<uint8_t> result = {dict.getBuffer(),
+                                   dict.getBuffer() + dict.getLength()};
+    EXPECT_EQ(result, goldenFrame);
+}
+
+TEST(KV_Endian, goldenFrameParse) {
+    KV_Parser parsed = {goldenFrame.data(), goldenFrame.size()};
+    EXPECT_EQ(parsed["a"].getAs<int16_t>(), -2);
+    EXPECT_EQ(parsed["b"].getAs<uint32_t>(), 0x12345678);
+    EXPECT_EQ(parsed["c"].getAs<int64_t>(), 0x0102030405060708);
+    EXPECT_EQ(parsed["d"].getAs<float>(), 3.5f);
+    EXPECT_EQ(parsed["e"].getAs<double>(), 3.5);
+    std::vector<uint16_t> expected = {0x0201, 0x0403, 0x0605};
+    EXPECT_EQ(parsed["f"].getVector<uint16_t>(), expected);
+    EXPECT_EQ((parsed["f"].getArray<uint16_t, 3>()[2]), 0x0605);
+}
+
+// Frame created on AVR: `int i = -2; double d = 3.5;`
+TEST(KV_Endian, goldenFrameAVR) {
+    std::vector<uint8_t> frame = {
+        0x01, 0x03, 0x02, 0x00, // key len 1, type int16, size 2
+        'i',  0x00, 0x00, 0x00, //
+        0xFE, 0xFF, 0x00, 0x00, // -2
+        0x01, 0x09, 0x04, 0x00, // key len 1, type float, size 4
+        'd',  0x00, 0x00, 0x00, //
+        0x00, 0x00, 0x60, 0x40, // 3.5f
+    };
+    KV_Parser parsed = {frame.data(), frame.size()};
+    EXPECT_EQ(parsed["i"].getAs<short>(), -2);
+    EXPECT_EQ(parsed["d"].getAs<float>(), 3.5f);
+}
+
+// Frame created on ARM or ESP32: `int i[] = {-2, 3}; long l = 7;`
+TEST(KV_Endian, goldenFrameARM) {
+    std::vector<uint8_t> frame = {
+        0x01, 0x05, 0x08, 0x00, // key len 1, type int32, size 8
+        'i',  0x00, 0x00, 0x00, //
+        0xFE, 0xFF, 0xFF, 0xFF, // -2
+        0x03, 0x00, 0x00, 0x00, // 3
+        0x01, 0x05, 0x04, 0x00, // key len 1, type int32, size 4
+        'l',  0x00, 0x00, 0x00, //
+        0x07, 0x00, 0x00, 0x00, // 7
+    };
+    KV_Parser parsed = {frame.data(), frame.size()};
+    EXPECT_EQ(parsed["i"].getAs<int32_t>(1), 3);
+    std::vector<int32_t> expected = {-2, 3};
+    EXPECT_EQ(parsed["i"].getVector<int32_t>(), expected);
+    EXPECT_EQ(parsed["l"].getAs<int32_t>(), 7);
+}
+
+TEST(KV_Endian, swapArray) {
+    for (size_t elementSize : {1, 2, 3, 4, 8}) {
+        for (size_t count = 0; count < 40; ++count) {
+            std::vector<uint8_t> data(elementSize * count);
+            std::iota(data.begin(), data.end(), 0);
+            std::vector<uint8_t> expected = data;
+            for (size_t i = 0; i < count; ++i)
+                KV_Endian::reverseBytes(&expected[i * elementSize],
+                                        elementSize);
+            KV_Endian::swapArray(data.data(), elementSize, count);
+            EXPECT_EQ(data, expected) << elementSize << ", " << count;
+        }
+    }
+}
+
+TEST(KV_Endian, toFromWire) {
+    uint8_t buffer[4];
+    KV_Endian::toWire(uint32_t(0x11223344), buffer);
+    EXPECT_EQ(buffer[0], 0x44);
+    EXPECT_EQ(buffer[3], 0x11);
+    uint32_t value;
+    KV_Endian::fromWire(value, buffer);
+    EXPECT_EQ(value, 0x11223344);
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_ArenaParser.hpp>
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_Compact.hpp>
+#include <KVComm/KV_KeyTable.hpp>
+#include <KVComm/KV_Parser.hpp>
+
+#include <string>
+#include <vector>
+
+static const char *telemetryKeys[] = {
+    "The meaning of life, the universe and everything",
+    "motor outputs",
+    "message",
+    "coordinates",
+    "battery voltage",
+};
+
+static void addTelemetry(KV_Builder &dict, int i) {
+    dict.add("The meaning of life, the universe and everything", i);
+    dict.add<float>("motor outputs", {0.56, 0.55, 0.54, 0.57});
+    dict.add<float>("coordinates", {0.1, 5.2, 3.4});
+    dict.add("battery voltage", 3.7f);
+}
+
+TEST(KV_KeyTable, lookupResolve) {
+    KV_KeyTable keys = telemetryKeys;
+    EXPECT_EQ(keys.size(), 5);
+    EXPECT_EQ(keys.lookup("message").value(), 2);
+    EXPECT_EQ(keys.lookup("unknown").error(), KV_Errc::NonExistentEntry);
+    EXPECT_STREQ(keys.resolve(1), "motor outputs");
+    EXPECT_EQ(keys.resolve(5), nullptr);
+}
+
+TEST(KV_KeyTable, builderWritesIDs) {
+    KV_KeyTable keys = telemetryKeys;
+    Static_KV_Builder<256> dict;
+    dict.setKeyTable(&keys);
+    dict.add("message", "hi");
+    dict.add("other", (uint8_t) 0x12);
+
+    std::vector<uint8_t> expected = {
+        0x02, 0x0C, 0x03, 0x00, // key len 2, type 12, size 3
+        0x00, 0x02, 0x00, 0x00, // key ID 2
+        'h',  'i',  0x00, 0x00, //
+        0x05, 0x02, 0x01, 0x00, // key len 5, type 2, size 1
+        'o',  't',  'h',  'e',  //
+        'r',  0x00, 0x00, 0x00, //
+        0x12, 0x00, 0x00, 0x00, //
+    };
+    std::vector<uint8_t> result = {dict.getBuffer(),
+                                   dict.getBuffer() + dict.getLength()};
+    EXPECT_EQ(result, expected);
+
+    // Overwriting an existing element with a key ID
+    EXPECT_TRUE(dict.add("message", "yo"));
+    EXPECT_EQ(dict.getLength(), expected.size());
+    EXPECT_FALSE(dict.add("message", "too long"));
+    EXPECT_EQ(dict.findID(2)->getData()[0], 'y');
+    EXPECT_STREQ(dict.find("message")->getID(), "message");
+}
+
+TEST(KV_KeyTable, twoByteIDs) {
+    std::vector<std::string> strings;
+    for (int i = 0; i < 300; ++i)
+        strings.push_back("key" + std::to_string(i));
+    std::vector<const char *> pointers;
+    for (auto &s : strings)
+        pointers.push_back(s.c_str());
+    KV_KeyTable keys = {pointers.data(), pointers.size()};
+
+    Static_KV_Builder<256> dict;
+    dict.setKeyTable(&keys);
+    dict.add("key299", (uint8_t) 0x12);
+    std::vector<uint8_t> expected = {
+        0x03, 0x02, 0x01, 0x00, // key len 3, type 2, size 1
+        0x00, 0x2B, 0x01, 0x00, // key ID 299
+        0x12, 0x00, 0x00, 0x00, //
+    };
+    std::vector<uint8_t> result = {dict.getBuffer(),
+                                   dict.getBuffer() + dict.getLength()};
+    EXPECT_EQ(result, expected);
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength(),
+                        KV_Iterator::Checked, &keys};
+    EXPECT_EQ(parsed["key299"].getAs<uint8_t>(), 0x12);
+}
+
+TEST(KV_KeyTable, roundTrip) {
+    // Sender
+    KV_KeyTable senderKeys = telemetryKeys;
+    Static_KV_Builder<512> definitions;
+    ASSERT_TRUE(senderKeys.writeDefinitions(definitions));
+    Static_KV_Builder<512> dict;
+    dict.setKeyTable(&senderKeys);
+    addTelemetry(dict, 42);
+    dict.add("message", "The EAGLE has landed");
+    dict.add("success", true); // not in the key table
+
+    // Receiver: frames with unknown key IDs only contain the string keys
+    KV_KeyTable receiverKeys;
+    KV_Parser before = {dict.getBuffer(), dict.getLength(),
+                        KV_Iterator::Checked, &receiverKeys};
+    EXPECT_EQ(before.begin()->first, std::string("success"));
+    EXPECT_EQ(std::distance(before.begin(), before.end()), 1);
+
+    // Learn the definitions, they're not part of the parsed dictionary
+    KV_Parser defs = {definitions.getBuffer(), definitions.getLength(),
+                      KV_Iterator::Checked, &receiverKeys};
+    EXPECT_EQ(defs.begin(), defs.end());
+    EXPECT_EQ(receiverKeys.size(), 5);
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength(),
+                        KV_Iterator::Checked, &receiverKeys};
+    EXPECT_EQ(parsed["The meaning of life, the universe and everything"]
+                  .getAs<int>(),
+              42);
+    EXPECT_EQ(parsed["motor outputs"].getAs<float>(3), 0.57f);
+    EXPECT_STREQ(parsed["message"].getString(), "The EAGLE has landed");
+    EXPECT_EQ(parsed["success"].getAs<bool>(), true);
+    EXPECT_TRUE(parsed["message"].hasKeyID());
+    EXPECT_EQ(parsed["message"].getKeyID(), 2);
+    EXPECT_FALSE(parsed["success"].hasKeyID());
+
+    KV_ArenaParser arena;
+    arena.reparse(dict.getBuffer(), dict.getLength(), KV_Iterator::Checked,
+                  &receiverKeys);
+    EXPECT_EQ(arena.size(), 6);
+    EXPECT_EQ(arena["coordinates"].getAs<float>(2), 3.4f);
+
+    // Learning the same definitions again doesn't change anything
+    EXPECT_EQ(receiverKeys.learn(definitions.getBuffer(),
+                                 definitions.getLength()),
+              5);
+    EXPECT_STREQ(receiverKeys.resolve(0),
+                 "The meaning of life, the universe and everything");
+}
+
+TEST(KV_KeyTable, learnUntrusted) {
+    KV_KeyTable receiverKeys;
+    Static_KV_Builder<64> definitions;
+    definitions.add("first", KV_KeyDefinition{3});
+    definitions.add("far away", KV_KeyDefinition{0x1234});
+    EXPECT_EQ(receiverKeys.learn(definitions.getBuffer(),
+                                 definitions.getLength(), KV_Iterator::Checked),
+              1);
+    EXPECT_EQ(receiverKeys.size(), 4);
+    EXPECT_STREQ(receiverKeys.resolve(3), "first");
+
+    // Redefining an ID replaces the previous key
+    Static_KV_Builder<64> redefinitions;
+    redefinitions.add("second", KV_KeyDefinition{3});
+    EXPECT_EQ(receiverKeys.learn(redefinitions.getBuffer(),
+                                 redefinitions.getLength(),
+                                 KV_Iterator::Checked),
+              1);
+    EXPECT_EQ(receiverKeys.size(), 4);
+    EXPECT_STREQ(receiverKeys.resolve(3), "second");
+    EXPECT_EQ(receiverKeys.lookup("first").error(), KV_Errc::NonExistentEntry);
+
+    // Larger IDs can be allowed explicitly
+    receiverKeys.setMaxID(0x1234);
+    EXPECT_EQ(receiverKeys.learn(definitions.getBuffer(),
+                                 definitions.getLength(), KV_Iterator::Checked),
+              2);
+    EXPECT_STREQ(receiverKeys.resolve(0x1234), "far away");
+    EXPECT_STREQ(receiverKeys.resolve(3), "first");
+}
+
+TEST(KV_KeyTable, frameSize) {
+    Static_KV_Builder<512> full;
+    addTelemetry(full, 42);
+
+    KV_KeyTable keys = telemetryKeys;
+    Static_KV_Builder<512> withIDs;
+    withIDs.setKeyTable(&keys);
+    addTelemetry(withIDs, 42);
+
+    // Each key takes up a single word
+    EXPECT_EQ(full.getLength(), 148);
+    EXPECT_EQ(withIDs.getLength(), 68);
+
+    // The same holds for the compact format
+    uint8_t compactFull[512], compactIDs[512];
+    auto sizeFull = KV_Compact::encode(full.getBuffer(), full.getLength(),
+                                       compactFull, sizeof(compactFull));
+    auto sizeIDs  = KV_Compact::encode(withIDs.getBuffer(), withIDs.getLength(),
+                                       compactIDs, sizeof(compactIDs));
+    ASSERT_TRUE(sizeFull);
+    ASSERT_TRUE(sizeIDs);
+    EXPECT_LT(2 * sizeIDs.value(), sizeFull.value());
+
+    alignas(4) uint8_t aligned[512];
+    auto decoded = KV_Compact::decode(compactIDs, sizeIDs.value(), aligned,
+                                      sizeof(aligned));
+    ASSERT_TRUE(decoded);
+    KV_Parser parsed = {aligned, decoded.value(), KV_Iterator::Checked, &keys};
+    EXPECT_EQ(parsed["coordinates"].getAs<float>(1), 5.2f);
+}
+
+TEST(KV_KeyTable, malformedKeyIDs) {
+    // An empty key that is not a key ID (key length 1)
+    std::vector<uint8_t> buffer = {
+        0x01, 0x02, 0x01, 0x00, //
+        0x00, 0x00, 0x00, 0x00, //
+        0x11, 0x00, 0x00, 0x00, //
+    };
+    EXPECT_EQ(KV_Iterator::validate(buffer.data(), buffer.size()),
+              KV_Errc::Malformed);
+    buffer[0] = 0x02; // key ID 0
+    EXPECT_EQ(KV_Iterator::validate(buffer.data(), buffer.size()),
+              KV_Errc::OK);
+
+    // Without key table, entries with key IDs have an empty key
+    KV_Iterator dict = {buffer.data(), buffer.size()};
+    EXPECT_STREQ(dict.begin()->getID(), "");
+    EXPECT_EQ(dict.findID(0)->getAs<uint8_t>(), 0x11);
+}
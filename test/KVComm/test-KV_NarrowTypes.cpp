@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_NarrowTypes.hpp>
+#include <KVComm/KV_Parser.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+TEST(KV_Float16, fromFloat) {
+    EXPECT_EQ(KV_Float16::fromFloat(0.f), 0x0000);
+    EXPECT_EQ(KV_Float16::fromFloat(-0.f), 0x8000);
+    EXPECT_EQ(KV_Float16::fromFloat(1.f), 0x3C00);
+    EXPECT_EQ(KV_Float16::fromFloat(-2.f), 0xC000);
+    EXPECT_EQ(KV_Float16::fromFloat(0.1f), 0x2E66);
+    EXPECT_EQ(KV_Float16::fromFloat(65504.f), 0x7BFF);
+    EXPECT_EQ(KV_Float16::fromFloat(65520.f), 0x7C00); // rounds to infinity
+    EXPECT_EQ(KV_Float16::fromFloat(1e6f), 0x7C00);
+    EXPECT_EQ(KV_Float16::fromFloat(std::ldexp(1.f, -24)), 0x0001);
+    EXPECT_EQ(KV_Float16::fromFloat(1e-8f), 0x0000);
+    EXPECT_EQ(KV_Float16::fromFloat(-std::numeric_limits<float>::infinity()),
+              0xFC00);
+    EXPECT_EQ(KV_Float16::fromFloat(std::numeric_limits<float>::quiet_NaN()),
+              0x7E00);
+    // Ties are rounded to even
+    EXPECT_EQ(KV_Float16::fromFloat(1.f + std::ldexp(1.f, -11)), 0x3C00);
+    EXPECT_EQ(KV_Float16::fromFloat(1.f + 3 * std::ldexp(1.f, -11)), 0x3C02);
+}
+
+TEST(KV_Float16, roundTripAll) {
+    for (uint32_t h = 0; h <= 0xFFFF; ++h) {
+        float f = KV_Float16::toFloat(h);
+        if (std::isnan(f))
+            continue;
+        EXPECT_EQ(KV_Float16::fromFloat(f), h) << std::hex << h;
+    }
+    EXPECT_EQ(KV_Float16::toFloat(0x3C00), 1.f);
+    EXPECT_EQ(KV_Float16::toFloat(0xC000), -2.f);
+    EXPECT_EQ(KV_Float16::toFloat(0x0001), std::ldexp(1.f, -24));
+    EXPECT_EQ(KV_Float16::toFloat(0x7BFF), 65504.f);
+    EXPECT_TRUE(std::isnan(KV_Float16::toFloat(0x7E00)));
+}
+
+TEST(KV_Fixed16, conversions) {
+    EXPECT_EQ(KV_Q15::fromFloat(0.5f), 16384);
+    EXPECT_EQ(KV_Q15::fromFloat(-1.f), -32768);
+    EXPECT_EQ(KV_Q15::fromFloat(1.f), 32767); // saturates
+    EXPECT_EQ(KV_Q15::fromFloat(-3.f), -32768);
+    EXPECT_EQ(KV_Q15::fromFloat(std::ldexp(1.f, -16)), 1); // rounds
+    EXPECT_EQ(KV_Q15::fromFloat(std::numeric_limits<float>::quiet_NaN()),
+              -32768);
+    EXPECT_EQ(KV_Q15::toFloat(-16384), -0.5f);
+    EXPECT_EQ(KV_Q7_8::fromFloat(1.5f), 384);
+    EXPECT_EQ(KV_Q7_8::fromFloat(-1.5f), -384);
+    EXPECT_EQ(KV_Q7_8::fromFloat(200.f), 32767);
+    EXPECT_EQ(KV_Q7_8::toFloat(-384), -1.5f);
+}
+
+TEST(KV_NarrowTypes, typeIDs) {
+    EXPECT_EQ(KV_Type<KV_Float16>::getTypeID(), 13);
+    EXPECT_EQ(KV_Type<KV_Q15>::getTypeID(), 14);
+    EXPECT_EQ(KV_Type<KV_Q7_8>::getTypeID(), 15);
+}
+
+TEST(KV_NarrowTypes, builder) {
+    Static_KV_Builder<128> dict;
+    float motors[] = {0.5f, -0.25f, 1.f, 0.75f};
+    EXPECT_TRUE(dict.addAs<KV_Q15>("m", motors));
+    EXPECT_TRUE(dict.addAs<KV_Float16>("v", 3.7f));
+    EXPECT_TRUE(dict.addAs<KV_Q7_8>("t", {25.5, -3.0}));
+
+    std::vector<uint8_t> expected = {
+        0x01, 0x0E, 0x08, 0x00, // key len 1, type Q15, size 8
+        'm',  0x00, 0x00, 0x00, //
+        0x00, 0x40, 0x00, 0xE0, // 0.5, -0.25
+        0xFF, 0x7F, 0x00, 0x60, // 1 (saturated), 0.75
+        0x01, 0x0D, 0x02, 0x00, // key len 1, type float16, size 2
+        'v',  0x00, 0x00, 0x00, //
+        0x66, 0x43, 0x00, 0x00, // 3.7
+        0x01, 0x0F, 0x04, 0x00, // key len 1, type Q7.8, size 4
+        't',  0x00, 0x00, 0x00, //
+        0x80, 0x19, 0x00, 0xFD, // 25.5, -3
+    };
+    std::vector<uint8_t> result = {dict.getBuffer(),
+                                   dict.getBuffer() + dict.getLength()};
+    EXPECT_EQ(result, expected);
+
+    // Overwriting uses the same conversion
+    motors[3] = -0.75f;
+    EXPECT_TRUE(dict.addAs<KV_Q15>("m", motors));
+    EXPECT_EQ(dict.getLength(), expected.size());
+    // Different type
+    EXPECT_FALSE(dict.add<float>("m", {1, 2, 3, 4}));
+    EXPECT_FALSE(dict.addAs<KV_Float16>("m", motors));
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength()};
+    std::vector<float> m = parsed["m"].getVector<KV_Q15>();
+    std::vector<float> expectedM = {0.5f, -0.25f, 1.f - std::ldexp(1.f, -15),
+                                    -0.75f};
+    EXPECT_EQ(m, expectedM);
+    EXPECT_EQ(parsed["m"].getAs<KV_Q15>(1), -0.25f);
+    EXPECT_NEAR(parsed["v"].getAs<KV_Float16>(), 3.7f, 2e-3f);
+    auto t = parsed["t"].getArray<KV_Q7_8, 2>();
+    EXPECT_EQ(t[0], 25.5f);
+    EXPECT_EQ(t[1], -3.f);
+    EXPECT_EQ(parsed["v"].tryGetAs<KV_Float16>().value(),
+              KV_Float16::toFloat(0x4366));
+    EXPECT_EQ((parsed["t"].tryGetArray<KV_Q7_8, 2>().value()[0]), 25.5f);
+    EXPECT_EQ(parsed["m"].tryGetAs<float>().error(), KV_Errc::TypeMismatch);
+    EXPECT_EQ(parsed["m"].tryGetAs<KV_Q7_8>().error(), KV_Errc::TypeMismatch);
+}
+
+TEST(KV_NarrowTypes, bulkConversion) {
+    // Arrays long enough for the vectorized code paths, with a tail
+    std::vector<float> values(67);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = std::sin(0.1f * i) * 1.5f;
+    Static_KV_Builder<1024> dict;
+    EXPECT_TRUE(dict.addAs<KV_Float16>("f16", values));
+    EXPECT_TRUE(dict.addAs<KV_Q7_8>("q78", values));
+    EXPECT_TRUE(dict.add("f32", values));
+
+    KV_Parser parsed = {dict.getBuffer(), dict.getLength()};
+    // Half the size of a float
+    EXPECT_EQ(2 * parsed["f16"].getDataLength(),
+              parsed["f32"].getDataLength());
+    auto f16 = parsed["f16"].getVector<KV_Float16>();
+    auto q78 = parsed["q78"].getVector<KV_Q7_8>();
+    ASSERT_EQ(f16.size(), values.size());
+    ASSERT_EQ(q78.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(f16[i], KV_Float16(values[i])) << i;
+        EXPECT_EQ(f16[i], parsed["f16"].getAs<KV_Float16>(i)) << i;
+        EXPECT_NEAR(q78[i], values[i], KV_Q7_8::resolution() / 2) << i;
+    }
+
+    // Conversion from double
+    std::vector<double> doubles = {0.125, -0.5};
+    EXPECT_TRUE(dict.addAs<KV_Float16>("d", doubles));
+    KV_Parser parsed2 = {dict.getBuffer(), dict.getLength()};
+    EXPECT_EQ(parsed2["d"].getAs<KV_Float16>(1), -0.5f);
+}
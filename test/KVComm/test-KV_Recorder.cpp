@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_Iterator.hpp>
+#include <KVComm/KV_Recorder.hpp>
+#include <SLIPStream/SLIPParser.hpp>
+#include <SLIPStream/SLIPSender.hpp>
+
+#include <boost/crc.hpp>
+
+#include <vector>
+
+namespace {
+
+/// Packet sender that stores all packets in a vector.
+struct PacketCapture {
+    size_t beginPacket() {
+        packets.emplace_back();
+        return 0;
+    }
+    size_t write(const uint8_t *data, size_t len) {
+        packets.back().insert(packets.back().end(), data, data + len);
+        return len;
+    }
+    size_t endPacket() { return 0; }
+    std::vector<std::vector<uint8_t>> packets;
+};
+
+void addSample(KV_Builder &dict, int i) {
+    dict.add("time", uint32_t(i));
+    dict.add<float>("accel", {0.1f * i, 0.2f * i, 0.3f * i});
+    dict.add("fault", i % 5 == 0);
+}
+
+std::vector<uint8_t> frame(const KV_Builder &dict) {
+    return {dict.getBuffer(), dict.getBuffer() + dict.getLength()};
+}
+
+} // namespace
+
+TEST(KV_Recorder, layout) {
+    Static_KV_Builder<128> dict;
+    addSample(dict, 1);
+    // Headers and keys: 4 + 8, 4 + 8, 4 + 8 bytes; data: 4, 12, 4 bytes
+    Static_KV_Recorder<36 + 3 * 20 + 10> recorder;
+    EXPECT_EQ(recorder.capacity(), 0);
+    ASSERT_TRUE(recorder.record(dict));
+    EXPECT_EQ(recorder.getRecordLength(), 20);
+    EXPECT_EQ(recorder.getFrameLength(), dict.getLength());
+    EXPECT_EQ(recorder.capacity(), 3);
+    EXPECT_EQ(recorder.size(), 1);
+
+    std::vector<uint8_t> out(recorder.getFrameLength());
+    ASSERT_TRUE(recorder.copySnapshot(0, out.data()));
+    EXPECT_EQ(out, frame(dict));
+    EXPECT_FALSE(recorder.copySnapshot(1, out.data()));
+}
+
+TEST(KV_Recorder, ring) {
+    Static_KV_Builder<128> dict;
+    Static_KV_Recorder<36 + 4 * 20> recorder;
+    std::vector<std::vector<uint8_t>> frames;
+    for (int i = 0; i < 10; ++i) {
+        addSample(dict, i);
+        frames.push_back(frame(dict));
+        ASSERT_TRUE(recorder.record(dict));
+    }
+    EXPECT_EQ(recorder.size(), 4);
+    // The oldest snapshots were overwritten
+    for (size_t i = 0; i < 4; ++i) {
+        std::vector<uint8_t> out(recorder.getFrameLength());
+        ASSERT_TRUE(recorder.copySnapshot(i, out.data()));
+        EXPECT_EQ(out, frames[6 + i]) << i;
+    }
+    recorder.clear();
+    EXPECT_EQ(recorder.size(), 0);
+    EXPECT_EQ(recorder.capacity(), 4);
+}
+
+TEST(KV_Recorder, layoutMismatch) {
+    Static_KV_Builder<128> dict;
+    addSample(dict, 1);
+    Static_KV_Recorder<256> recorder;
+    ASSERT_TRUE(recorder.record(dict));
+
+    // Additional key
+    dict.add("extra", 1);
+    EXPECT_FALSE(recorder.record(dict));
+    // Same length, different key
+    Static_KV_Builder<128> other;
+    other.add("tim3", uint32_t(1));
+    other.add<float>("accel", {1, 2, 3});
+    other.add("fault", true);
+    EXPECT_EQ(other.getLength(), recorder.getFrameLength());
+    EXPECT_FALSE(recorder.record(other));
+    // Same length, different type
+    Static_KV_Builder<128> otherType;
+    otherType.add("time", int32_t(1));
+    otherType.add<float>("accel", {1, 2, 3});
+    otherType.add("fault", true);
+    EXPECT_FALSE(recorder.record(otherType));
+    EXPECT_EQ(recorder.size(), 1);
+
+    // After a reset, the new layout is accepted
+    recorder.reset();
+    EXPECT_TRUE(recorder.record(dict));
+    EXPECT_EQ(recorder.getFrameLength(), dict.getLength());
+
+    // Storage too small for a single snapshot
+    Static_KV_Recorder<32> tiny;
+    EXPECT_FALSE(tiny.record(dict));
+    EXPECT_EQ(tiny.capacity(), 0);
+    // Empty dictionaries
+    Static_KV_Builder<16> empty;
+    EXPECT_FALSE(recorder.record(empty));
+}
+
+TEST(KV_Recorder, exportTo) {
+    Static_KV_Builder<128> dict;
+    Static_KV_Recorder<256> recorder;
+    std::vector<std::vector<uint8_t>> frames;
+    for (int i = 0; i < 20; ++i) {
+        addSample(dict, i);
+        frames.push_back(frame(dict));
+        recorder.record(dict);
+    }
+    size_t n = recorder.size();
+    ASSERT_LT(n, 20);
+
+    PacketCapture capture;
+    EXPECT_EQ(recorder.exportTo(capture), n * recorder.getFrameLength());
+    ASSERT_EQ(capture.packets.size(), n);
+    for (size_t i = 0; i < n; ++i)
+        EXPECT_EQ(capture.packets[i], frames[20 - n + i]) << i;
+    EXPECT_EQ(recorder.exportSnapshot(capture, n), 0);
+}
+
+TEST(KV_Recorder, exportSLIP) {
+    using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+    std::vector<uint8_t> wire;
+    auto sendByte = [&wire](uint8_t c) {
+        wire.push_back(c);
+        return size_t(1);
+    };
+    SLIPSenderCRC<decltype(sendByte), CRC> sender = {std::move(sendByte),
+                                                     CRC()};
+
+    Static_KV_Builder<128> dict;
+    Static_KV_Recorder<36 + 5 * 20> recorder;
+    for (int i = 0; i < 8; ++i) {
+        addSample(dict, i);
+        recorder.record(dict);
+    }
+    recorder.exportTo(sender);
+
+    alignas(4) uint8_t buffer[128];
+    SLIPParserCRC<CRC> parser = {SLIPParser{buffer}};
+    std::vector<uint32_t> times;
+    for (uint8_t c : wire) {
+        if (size_t size = parser.parse(c)) {
+            ASSERT_EQ(parser.checksum(), 0);
+            ASSERT_EQ(KV_Iterator::validate(buffer, size), KV_Errc::OK);
+            KV_Iterator parsed = {buffer, size};
+            times.push_back(parsed.find("time")->getAs<uint32_t>());
+            EXPECT_EQ(parsed.find("fault")->getAs<bool>(),
+                      times.back() % 5 == 0);
+        }
+    }
+    ASSERT_EQ(times.size(), 5);
+    EXPECT_EQ(times.front(), 3);
+    EXPECT_EQ(times.back(), 7);
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <KVComm/KV_Builder.hpp>
+#include <KVComm/KV_Iterator.hpp>
+#include <SLIPStream/BatchSender.hpp>
+#include <SLIPStream/SLIPParser.hpp>
+#include <SLIPStream/SLIPSender.hpp>
+
+#include <boost/crc.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Packet sender that stores all packets in a vector.
+struct PacketCapture {
+    size_t beginPacket() {
+        packets.emplace_back();
+        return 0;
+    }
+    size_t write(const uint8_t *data, size_t len) {
+        packets.back().insert(packets.back().end(), data, data + len);
+        return len;
+    }
+    size_t endPacket() { return 0; }
+    std::vector<std::vector<uint8_t>> packets;
+};
+
+using Records = std::vector<std::vector<uint8_t>>;
+
+std::vector<uint8_t> toVector(const std::string &s) {
+    return {s.begin(), s.end()};
+}
+
+Records getRecords(const std::vector<uint8_t> &packet) {
+    BatchReader reader = {packet.data(), packet.size()};
+    EXPECT_TRUE(reader.isValid());
+    Records result;
+    for (BatchReader::Record record : reader)
+        result.emplace_back(record.data, record.data + record.length);
+    return result;
+}
+
+} // namespace
+
+TEST(BatchSender, layout) {
+    PacketCapture capture;
+    BatchSender<PacketCapture &> batch = {capture};
+    auto a = toVector("abc"), b = toVector("defgh");
+    EXPECT_EQ(batch.add(a.data(), a.size()), 0);
+    EXPECT_EQ(batch.add(b.data(), b.size()), 0);
+    EXPECT_EQ(batch.getRecordCount(), 2);
+    EXPECT_EQ(batch.getBufferedLength(), 12);
+    EXPECT_TRUE(capture.packets.empty());
+    EXPECT_EQ(batch.flush(), 20);
+    EXPECT_EQ(batch.getRecordCount(), 0);
+    EXPECT_EQ(batch.flush(), 0);
+
+    std::vector<uint8_t> expected = {
+        0x02, 0x00, 0x03, 0x00, // 2 records, 3 bytes
+        0x05, 0x00, 0x00, 0x00, // 5 bytes, padding
+        'a',  'b',  'c',  0x00, //
+        'd',  'e',  'f',  'g',  //
+        'h',  0x00, 0x00, 0x00, //
+    };
+    ASSERT_EQ(capture.packets.size(), 1);
+    EXPECT_EQ(capture.packets[0], expected);
+
+    BatchReader reader = {expected.data(), expected.size()};
+    ASSERT_TRUE(reader.isValid());
+    ASSERT_EQ(reader.size(), 2);
+    EXPECT_EQ(reader[1].length, 5);
+    EXPECT_EQ(reader[1].data, expected.data() + 12);
+    EXPECT_EQ(getRecords(expected), (Records{a, b}));
+}
+
+TEST(BatchSender, policy) {
+    PacketCapture capture;
+    BatchPolicy policy;
+    policy.maxRecords = 3;
+    BatchSender<PacketCapture &> batch = {capture, policy};
+    auto record = toVector("0123456789");
+    for (int i = 0; i < 7; ++i)
+        batch.add(record.data(), record.size());
+    EXPECT_EQ(capture.packets.size(), 2);
+    EXPECT_EQ(batch.getRecordCount(), 1);
+
+    // Size
+    policy.maxRecords = 0;
+    policy.maxBytes   = 30;
+    batch.setPolicy(policy);
+    batch.add(record.data(), record.size());
+    EXPECT_EQ(capture.packets.size(), 2);
+    batch.add(record.data(), record.size());
+    EXPECT_EQ(capture.packets.size(), 3);
+    EXPECT_EQ(getRecords(capture.packets[2]).size(), 3);
+
+    // Age
+    policy.maxBytes = 0;
+    policy.maxAge   = 10;
+    batch.setPolicy(policy);
+    EXPECT_EQ(batch.update(1000), 0); // empty batch
+    batch.add(record.data(), record.size(), 1000);
+    batch.add(record.data(), record.size(), 1005);
+    EXPECT_EQ(batch.update(1009), 0);
+    EXPECT_GT(batch.update(1010), 0);
+    EXPECT_EQ(capture.packets.size(), 4);
+    EXPECT_EQ(getRecords(capture.packets[3]).size(), 2);
+    // The age is measured from the first record of the new batch
+    batch.add(record.data(), record.size(), 1020);
+    EXPECT_EQ(batch.update(1025), 0);
+    EXPECT_GT(batch.update(1030), 0);
+}
+
+TEST(BatchSender, bufferSize) {
+    PacketCapture capture;
+    BatchSender<PacketCapture &, 32, 4> batch = {capture};
+    auto small = toVector("0123456789"), large = toVector(std::string(40, 'x'));
+    batch.add(small.data(), small.size());
+    batch.add(small.data(), small.size());
+    // Doesn't fit anymore: the first two records are sent
+    batch.add(small.data(), small.size());
+    ASSERT_EQ(capture.packets.size(), 1);
+    EXPECT_EQ(getRecords(capture.packets[0]), (Records{small, small}));
+    // Larger than the buffer: sent on its own, after the buffered record
+    batch.add(large.data(), large.size());
+    ASSERT_EQ(capture.packets.size(), 3);
+    EXPECT_EQ(getRecords(capture.packets[1]), (Records{small}));
+    EXPECT_EQ(getRecords(capture.packets[2]), (Records{large}));
+    EXPECT_EQ(batch.getRecordCount(), 0);
+    // Maximum number of records
+    auto tiny = toVector("a");
+    for (int i = 0; i < 4; ++i)
+        batch.add(tiny.data(), tiny.size());
+    ASSERT_EQ(capture.packets.size(), 4);
+    EXPECT_EQ(getRecords(capture.packets[3]).size(), 4);
+}
+
+TEST(BatchReader, invalid) {
+    std::vector<uint8_t> packet = {
+        0x02, 0x00, 0x03, 0x00, //
+        0x05, 0x00, 0x00, 0x00, //
+        'a',  'b',  'c',  0x00, //
+        'd',  'e',  'f',  'g',  //
+        'h',  0x00, 0x00, 0x00, //
+    };
+    EXPECT_TRUE(BatchReader(packet.data(), packet.size()).isValid());
+    // Truncated
+    EXPECT_FALSE(BatchReader(packet.data(), packet.size() - 4).isValid());
+    EXPECT_FALSE(BatchReader(packet.data(), 1).isValid());
+    // Record lengths don't match the packet size
+    packet[4] = 0x09;
+    EXPECT_FALSE(BatchReader(packet.data(), packet.size()).isValid());
+    packet[4] = 0x05;
+    // Directory doesn't fit
+    packet[0] = 0x20;
+    BatchReader reader = {packet.data(), packet.size()};
+    EXPECT_FALSE(reader.isValid());
+    EXPECT_EQ(reader.size(), 0);
+    EXPECT_FALSE(reader.begin() != reader.end());
+    // Unknown flags
+    packet[0] = 0x02;
+    packet[1] = 0x01;
+    EXPECT_FALSE(BatchReader(packet.data(), packet.size()).isValid());
+}
+
+TEST(BatchSender, KV_SLIPSenderCRC) {
+    using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+    std::vector<uint8_t> wire;
+    auto sendByte = [&wire](uint8_t c) {
+        wire.push_back(c);
+        return size_t(1);
+    };
+    using Sender = SLIPSenderCRC<decltype(sendByte), CRC>;
+    BatchPolicy policy;
+    policy.maxRecords = 10;
+    BatchSender<Sender> batch = {Sender{std::move(sendByte), CRC()}, policy};
+
+    // 1 kHz samples of 3 floats
+    for (int i = 0; i < 20; ++i) {
+        Static_KV_Builder<32> sample;
+        float xyz[] = {float(i), 2.f * i, 3.f * i};
+        sample.add("xyz", xyz);
+        batch.add(sample.getBuffer(), sample.getLength(), i);
+    }
+
+    alignas(4) uint8_t buffer[512];
+    SLIPParserCRC<CRC> parser = {SLIPParser{buffer}};
+    std::vector<float> received;
+    size_t packets = 0;
+    for (uint8_t c : wire) {
+        if (size_t size = parser.parse(c)) {
+            ASSERT_EQ(parser.checksum(), 0);
+            ++packets;
+            BatchReader reader = {buffer, size};
+            ASSERT_TRUE(reader.isValid());
+            for (BatchReader::Record record : reader) {
+                KV_Iterator dict = {record.data, record.length,
+                                    KV_Iterator::Checked};
+                received.push_back(dict.find("xyz")->getAs<float>(2));
+            }
+        }
+    }
+    EXPECT_EQ(packets, 2);
+    ASSERT_EQ(received.size(), 20);
+    EXPECT_EQ(received[0], 0.f);
+    EXPECT_EQ(received[19], 57.f);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <SLIPStream/LZSender.hpp>
+#include <SLIPStream/SLIPParser.hpp>
+#include <SLIPStream/SLIPSender.hpp>
+
+#include <boost/crc.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Packet sender that stores the packet in a vector.
+struct PacketCapture {
+    size_t beginPacket() {
+        packet.clear();
+        return 0;
+    }
+    size_t write(const uint8_t *data, size_t len) {
+        packet.insert(packet.end(), data, data + len);
+        return len;
+    }
+    size_t endPacket() { return 0; }
+    std::vector<uint8_t> packet;
+};
+
+template <class Sender>
+std::vector<uint8_t> roundTrip(Sender &lz, const std::vector<uint8_t> &data,
+                               bool compress = true) {
+    lz.writePacket(data.data(), data.size(), compress);
+    std::vector<uint8_t> result(data.size() + 1);
+    size_t size = LZ_unpack(lz.sender().packet.data(),
+                            lz.sender().packet.size(), result.data(),
+                            result.size());
+    result.resize(size);
+    return result;
+}
+
+/// Gives the tests access to the captured packet.
+template <uint8_t WindowBits = 8, uint8_t LookaheadBits = 4>
+struct CapturingLZ : LZSender<PacketCapture &, WindowBits, LookaheadBits> {
+    CapturingLZ() : LZSender<PacketCapture &, WindowBits, LookaheadBits>(c) {}
+    PacketCapture &sender() { return c; }
+    PacketCapture c;
+};
+
+std::vector<uint8_t> toVector(const std::string &s) {
+    return {s.begin(), s.end()};
+}
+
+} // namespace
+
+TEST(LZSender, golden) {
+    CapturingLZ<> lz;
+    auto data = toVector("abcabcabc");
+    EXPECT_EQ(roundTrip(lz, data), data);
+    std::vector<uint8_t> expected = {
+        0xC8,                   // flag: compressed, lookahead 4, window 8
+        0xB0, 0xD8, 0xAC, 0x60, // 'a', 'b', 'c' literals, match offset 3,
+        0x24,                   // length 6
+    };
+    EXPECT_EQ(lz.sender().packet, expected);
+}
+
+TEST(LZSender, raw) {
+    CapturingLZ<> lz;
+    auto data = toVector("abcabcabc");
+    EXPECT_EQ(roundTrip(lz, data, false), data);
+    EXPECT_EQ(lz.sender().packet.size(), data.size() + 1);
+    EXPECT_EQ(lz.sender().packet[0], LZ_Constants::RAW);
+    EXPECT_EQ(lz.getStatistics().bytesSaved(), -1);
+}
+
+TEST(LZSender, empty) {
+    CapturingLZ<> lz;
+    EXPECT_EQ(roundTrip(lz, {}), std::vector<uint8_t>{});
+    EXPECT_EQ(lz.sender().packet.size(), 1);
+}
+
+TEST(LZSender, roundTripRandom) {
+    std::mt19937 rng(42);
+    CapturingLZ<> lz;
+    CapturingLZ<6, 3> small;
+    CapturingLZ<10, 5> large;
+    for (size_t size : {1, 2, 16, 17, 18, 255, 256, 257, 1000, 3000}) {
+        // Random data with a small alphabet, so there are many matches
+        for (unsigned alphabet : {2, 16, 256}) {
+            std::vector<uint8_t> data(size);
+            for (auto &d : data)
+                d = rng() % alphabet;
+            EXPECT_EQ(roundTrip(lz, data), data) << size << ", " << alphabet;
+            EXPECT_EQ(roundTrip(small, data), data) << size << ", " << alphabet;
+            EXPECT_EQ(roundTrip(large, data), data) << size << ", " << alphabet;
+        }
+    }
+}
+
+TEST(LZSender, chunkedWrites) {
+    CapturingLZ<> lz;
+    std::string text;
+    for (int i = 0; i < 20; ++i)
+        text += "motor" + std::to_string(i % 4) + "=0.5" + std::to_string(i);
+    auto data = toVector(text);
+    lz.beginPacket();
+    for (size_t i = 0; i < data.size(); i += 7)
+        lz.write(data.data() + i, std::min<size_t>(7, data.size() - i));
+    lz.endPacket();
+    auto packet = lz.sender().packet;
+    EXPECT_EQ(roundTrip(lz, data), data);
+    EXPECT_EQ(lz.sender().packet, packet);
+    EXPECT_LT(packet.size(), data.size() / 2);
+    EXPECT_GT(lz.getStatistics().bytesSaved(), int32_t(data.size()));
+    lz.resetStatistics();
+    EXPECT_EQ(lz.getStatistics().uncompressed, 0);
+}
+
+TEST(LZSender, SLIPSenderCRC) {
+    using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+    std::vector<uint8_t> wire;
+    auto sendByte = [&wire](uint8_t c) {
+        wire.push_back(c);
+        return size_t(1);
+    };
+    using Sender = SLIPSenderCRC<decltype(sendByte), CRC>;
+    LZSender<Sender> lz = Sender{std::move(sendByte), CRC()};
+
+    std::string text = "battery voltage=3.70, battery current=0.25, "
+                       "battery temperature=25.0";
+    auto data = toVector(text);
+    lz.writePacket(data.data(), data.size());
+    lz.writePacket(data.data(), data.size(), false);
+
+    uint8_t buffer[128];
+    SLIPParserCRC<CRC> parser = {SLIPParser{buffer}};
+    std::vector<std::vector<uint8_t>> received;
+    std::vector<size_t> packetSizes;
+    for (uint8_t c : wire) {
+        if (size_t size = parser.parse(c)) {
+            ASSERT_EQ(parser.checksum(), 0);
+            packetSizes.push_back(size);
+            std::vector<uint8_t> out(128);
+            out.resize(LZ_unpack(buffer, size, out.data(), out.size()));
+            received.push_back(out);
+        }
+    }
+    ASSERT_EQ(received.size(), 2);
+    EXPECT_EQ(received[0], data);
+    EXPECT_EQ(received[1], data);
+    EXPECT_LT(packetSizes[0], packetSizes[1]);
+}
+
+TEST(LZ_unpack, malformed) {
+    std::vector<uint8_t> out(4);
+    // Invalid flag
+    std::vector<uint8_t> packet = {0x01, 0x00};
+    EXPECT_EQ(LZ_unpack(packet.data(), packet.size(), out.data(), out.size()),
+              0);
+    // Window smaller than lookahead
+    packet = {0xC3, 0x00};
+    EXPECT_EQ(LZ_unpack(packet.data(), packet.size(), out.data(), out.size()),
+              0);
+    // Match before the start of the data
+    packet = {0xC8, 0x00, 0x00};
+    EXPECT_EQ(LZ_unpack(packet.data(), packet.size(), out.data(), out.size()),
+              0);
+    // Output buffer too small
+    packet = {0xC8, 0xB0, 0xD8, 0xAC, 0x60, 0x24};
+    EXPECT_EQ(LZ_unpack(packet.data(), packet.size(), out.data(), out.size()),
+              0);
+    packet = {LZ_Constants::RAW, 1, 2, 3, 4, 5};
+    EXPECT_EQ(LZ_unpack(packet.data(), packet.size(), out.data(), out.size()),
+              0);
+    EXPECT_EQ(LZ_unpack(packet.data(), 0, out.data(), out.size()), 0);
+}
@@ -564,4 +564,188 @@ TEST(SLIPStreamCRC, readChunks) {
     EXPECT_EQ(packetBuffer, expected);
     EXPECT_EQ(slipstream.checksum(), 0);
     EXPECT_FALSE(slipstream.wasTruncated());
-}
\ No newline at end of file
+}
+
+TEST(SLIPStreamCRC, sequenceNumbers) {
+    using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+
+    // Send five packets with sequence numbers
+    MockStream tx;
+    std::vector<uint8_t> writeBuffer(300);
+    tx.writeBuffer = writeBuffer.data();
+    tx.writeLength = writeBuffer.size();
+    SLIPStreamCRC<CRC> sender = {tx, CRC(), {nullptr, 0}, CRC()};
+    sender.useSequenceNumbers();
+    std::vector<std::vector<uint8_t>> frames;
+    for (uint8_t i = 0; i < 5; ++i) {
+        size_t start = tx.writeIndex;
+        uint8_t data[] = {0x10, uint8_t(0x20 + i)};
+        sender.writePacket(data, sizeof(data));
+        frames.push_back({writeBuffer.begin() + start,
+                          writeBuffer.begin() + tx.writeIndex});
+    }
+    std::vector<uint8_t> expected0 = {
+        0xC0,       // END
+        0x10, 0x20, // data
+        0x00, 0x00, // sequence number
+        0x19, 0xA1, // checksum
+        0xC0,       // END
+    };
+    EXPECT_EQ(frames[0], expected0);
+    EXPECT_EQ(sender.getStatistics().bytesOut, 5 * 8);
+
+    // Lose packet 2, duplicate packet 3, corrupt packet 4, and add a packet
+    // with an invalid escape sequence (too short to have a checksum)
+    std::vector<uint8_t> input;
+    for (size_t i : {0, 1, 3, 3, 4})
+        input.insert(input.end(), frames[i].begin(), frames[i].end());
+    input[input.size() - 3] ^= 0x01;
+    input.insert(input.end(), {ESC, 0x12, END});
+    input.insert(input.end(), frames[4].begin(), frames[4].end());
+
+    MockStream rx;
+    rx.readBuffer = input.data();
+    rx.readLength = input.size();
+    std::vector<uint8_t> packetBuffer(64);
+    SLIPStreamCRC<CRC> receiver = {
+        rx, CRC(), {packetBuffer.data(), packetBuffer.size()}, CRC()};
+    receiver.useSequenceNumbers();
+
+    std::vector<uint8_t> received, duplicates;
+    while (size_t size = receiver.readPacket()) {
+        if (receiver.checksum() == 0) {
+            EXPECT_EQ(size, 2);
+            (receiver.isDuplicate() ? duplicates : received)
+                .push_back(packetBuffer[1]);
+        }
+    }
+    EXPECT_EQ(receiver.sequenceNumber(), 4);
+    std::vector<uint8_t> expectedReceived = {0x20, 0x21, 0x23, 0x24};
+    EXPECT_EQ(received, expectedReceived);
+    std::vector<uint8_t> expectedDuplicates = {0x23};
+    EXPECT_EQ(duplicates, expectedDuplicates);
+
+    SLIPLinkStatistics stats = receiver.getStatistics();
+    EXPECT_EQ(stats.packetsOK, 4);
+    EXPECT_EQ(stats.crcFailures, 1);
+    EXPECT_EQ(stats.truncated, 0);
+    EXPECT_EQ(stats.gaps, 1);
+    EXPECT_EQ(stats.duplicates, 1);
+    EXPECT_EQ(stats.bytesIn, input.size());
+    EXPECT_EQ(stats.bytesOut, 0);
+    EXPECT_EQ(stats.protocolViolations, 1);
+
+    receiver.resetStatistics();
+    stats = receiver.getStatistics();
+    EXPECT_EQ(stats.packetsOK, 0);
+    EXPECT_EQ(stats.protocolViolations, 0);
+}
+
+TEST(SLIPStreamCRC, sequenceNumbersSenderRestart) {
+    using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+
+    // The sender sends four packets, restarts, and sends four more packets,
+    // starting from sequence number zero again
+    MockStream tx;
+    std::vector<uint8_t> writeBuffer(300);
+    tx.writeBuffer = writeBuffer.data();
+    tx.writeLength = writeBuffer.size();
+    size_t beforeRestart = 0;
+    for (uint8_t restart = 0; restart < 2; ++restart) {
+        beforeRestart = tx.writeIndex;
+        SLIPStreamCRC<CRC> sender = {tx, CRC(), {nullptr, 0}, CRC()};
+        sender.useSequenceNumbers();
+        for (uint8_t i = 0; i < 4; ++i) {
+            uint8_t data[] = {uint8_t(0x10 * restart + i)};
+            sender.writePacket(data, sizeof(data));
+        }
+    }
+    std::vector<uint8_t> input = {writeBuffer.begin(),
+                                  writeBuffer.begin() + tx.writeIndex};
+
+    std::vector<uint8_t> packetBuffer(64);
+    auto receive = [&](SLIPStreamCRC<CRC> &receiver,
+                       std::vector<uint8_t> &received,
+                       std::vector<uint8_t> &duplicates) {
+        while (size_t size = receiver.readPacket()) {
+            EXPECT_EQ(receiver.checksum(), 0);
+            EXPECT_EQ(size, 1);
+            (receiver.isDuplicate() ? duplicates : received)
+                .push_back(packetBuffer[0]);
+        }
+    };
+
+    // Without intervention, the receiver resynchronizes on the
+    // MaxConsecutiveDuplicates-th duplicate in a row
+    {
+        MockStream rx;
+        rx.readBuffer = input.data();
+        rx.readLength = input.size();
+        SLIPStreamCRC<CRC> receiver = {
+            rx, CRC(), {packetBuffer.data(), packetBuffer.size()}, CRC()};
+        receiver.useSequenceNumbers();
+        std::vector<uint8_t> received, duplicates;
+        receive(receiver, received, duplicates);
+        ASSERT_EQ(SLIPStreamCRC<CRC>::MaxConsecutiveDuplicates, 3);
+        std::vector<uint8_t> expectedReceived = {0x00, 0x01, 0x02,
+                                                 0x03, 0x12, 0x13};
+        EXPECT_EQ(received, expectedReceived);
+        std::vector<uint8_t> expectedDuplicates = {0x10, 0x11};
+        EXPECT_EQ(duplicates, expectedDuplicates);
+        EXPECT_EQ(receiver.sequenceNumber(), 3);
+        SLIPLinkStatistics stats = receiver.getStatistics();
+        EXPECT_EQ(stats.packetsOK, 6);
+        EXPECT_EQ(stats.duplicates, 2);
+        EXPECT_EQ(stats.resyncs, 1);
+        EXPECT_EQ(stats.gaps, 0);
+    }
+
+    // When the restart is known, resetSequence accepts all new packets
+    {
+        MockStream rx;
+        rx.readBuffer = input.data();
+        rx.readLength = beforeRestart;
+        SLIPStreamCRC<CRC> receiver = {
+            rx, CRC(), {packetBuffer.data(), packetBuffer.size()}, CRC()};
+        receiver.useSequenceNumbers();
+        std::vector<uint8_t> received, duplicates;
+        receive(receiver, received, duplicates);
+        receiver.resetSequence();
+        rx.readLength = input.size();
+        receive(receiver, received, duplicates);
+        std::vector<uint8_t> expectedReceived = {0x00, 0x01, 0x02, 0x03,
+                                                 0x10, 0x11, 0x12, 0x13};
+        EXPECT_EQ(received, expectedReceived);
+        EXPECT_TRUE(duplicates.empty());
+        SLIPLinkStatistics stats = receiver.getStatistics();
+        EXPECT_EQ(stats.packetsOK, 8);
+        EXPECT_EQ(stats.duplicates, 0);
+        EXPECT_EQ(stats.resyncs, 0);
+    }
+}
+
+TEST(SLIPStreamCRC, sequenceNumbersTruncated) {
+    using CRC = boost::crc_optimal<16, 0x1021, 0xFFFF, 0, false, false>;
+    std::vector<uint8_t> input = {
+        0xC0,                   // END
+        0x31, 0x32, 0x33, 0x34, // data
+        0x00, 0x07,             // sequence number
+        0xF2, 0xE6,             // checksum
+        0xC0,                   // END
+    };
+    MockStream stream;
+    stream.readBuffer = input.data();
+    stream.readLength = input.size();
+
+    std::vector<uint8_t> packetBuffer(5);
+    SLIPStreamCRC<CRC> slipstream = {
+        stream, CRC(), {packetBuffer.data(), packetBuffer.size()}, CRC()};
+    slipstream.useSequenceNumbers();
+
+    // Only one byte of the sequence number fits the buffer
+    EXPECT_EQ(slipstream.readPacket(), 4);
+    EXPECT_EQ(slipstream.checksum(), 0);
+    EXPECT_FALSE(slipstream.wasTruncated());
+    EXPECT_EQ(slipstream.getStatistics().truncated, 1);
+    EXPECT_EQ(slipstream.getStatistics().packetsOK, 0);
+}